@@ -0,0 +1,129 @@
+#include "benchmark_utils.h"
+
+/*************************************************************** 
+ * General benchmarking utilities
+ **************************************************************/
+
+namespace {
+	// Summary statistics of a series
+	struct Summary {
+		double min = 0.0, median = 0.0, p90 = 0.0, p99 = 0.0, max = 0.0, mean = 0.0;
+	};
+
+	Summary summarize(std::vector<double> samples)
+	{
+		Summary sum;
+		if (samples.empty())
+			return sum;
+		std::sort(samples.begin(), samples.end());
+		sum.min = samples.front();
+		sum.median = percentile(samples, 50.0);
+		sum.p90 = percentile(samples, 90.0);
+		sum.p99 = percentile(samples, 99.0);
+		sum.max = samples.back();
+		for (const double time : samples)
+			sum.mean += time;
+		sum.mean /= samples.size();
+		return sum;
+	}
+
+	// String with JSON special characters escaped
+	std::string json_string(const std::string& text)
+	{
+		std::string escaped = "\"";
+		for (const char c : text){
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+		return escaped + "\"";
+	}
+}
+
+// Percentile of sorted samples, nearest rank
+double percentile(const std::vector<double>& sorted, const double pct)
+{
+	if (sorted.empty())
+		throw std::invalid_argument("Percentile of no samples");
+	const std::size_t rank = static_cast<std::size_t>(std::ceil(pct/100.0*sorted.size()));
+	return sorted.at(std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1);
+}
+
+// Entries of a comma separated list
+std::vector<std::string> split_list(const std::string& list)
+{
+	std::vector<std::string> entries;
+	std::istringstream in(list);
+	std::string entry;
+	while (std::getline(in, entry, ','))
+		if (!entry.empty())
+			entries.push_back(entry);
+	return entries;
+}
+
+// Add a sample to its configuration and phase
+void BenchmarkResults::add(const std::vector<std::string>& params, const std::string& phase,
+							const double time_us)
+{
+	if (params.size() != parameter_names.size())
+		throw std::invalid_argument("Wrong number of benchmark parameters");
+	for (auto& one : series){
+		if (one.parameters == params && one.phase == phase){
+			one.samples.push_back(time_us);
+			return;
+		}
+	}
+	series.push_back({params, phase, {time_us}});
+}
+
+// One line per configuration and phase
+void BenchmarkResults::save_csv(const std::string& fname) const
+{
+	std::ofstream out(fname);
+	if (!out)
+		throw std::runtime_error("Can't open benchmark output file " + fname);
+	out << "benchmark";
+	for (const auto& param : parameter_names)
+		out << "," << param;
+	out << ",phase,samples,min_us,median_us,p90_us,p99_us,max_us,mean_us\n";
+	out.precision(10);
+	for (const auto& one : series){
+		const Summary sum = summarize(one.samples);
+		out << name;
+		for (const auto& param : one.parameters)
+			out << "," << param;
+		out << "," << one.phase << "," << one.samples.size() << "," << sum.min << "," << sum.median
+			<< "," << sum.p90 << "," << sum.p99 << "," << sum.max << "," << sum.mean << "\n";
+	}
+}
+
+// JSON object with a list of results
+void BenchmarkResults::save_json(const std::string& fname) const
+{
+	std::ofstream out(fname);
+	if (!out)
+		throw std::runtime_error("Can't open benchmark output file " + fname);
+	out.precision(10);
+	out << "{\n  \"benchmark\": " << json_string(name) << ",\n  \"unit\": \"us\",\n  \"results\": [";
+	for (std::size_t i = 0; i < series.size(); ++i){
+		const Series& one = series.at(i);
+		const Summary sum = summarize(one.samples);
+		out << (i ? ",\n" : "\n") << "    {";
+		for (std::size_t j = 0; j < parameter_names.size(); ++j)
+			out << json_string(parameter_names.at(j)) << ": " << json_string(one.parameters.at(j)) << ", ";
+		out << "\"phase\": " << json_string(one.phase) << ", \"samples\": " << one.samples.size()
+			<< ", \"min\": " << sum.min << ", \"median\": " << sum.median << ", \"p90\": " << sum.p90
+			<< ", \"p99\": " << sum.p99 << ", \"max\": " << sum.max << ", \"mean\": " << sum.mean << "}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+// Short table of medians
+void BenchmarkResults::print_medians(std::ostream& out) const
+{
+	for (const auto& one : series){
+		for (std::size_t j = 0; j < parameter_names.size(); ++j)
+			out << parameter_names.at(j) << "=" << one.parameters.at(j) << " ";
+		out << one.phase << ": " << summarize(one.samples).median << " us\n";
+	}
+}
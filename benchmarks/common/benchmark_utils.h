@@ -0,0 +1,92 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include "../../include/common.h"
+#include <chrono>
+
+/***************************************************************
+ * General benchmarking utilities
+ **************************************************************/
+
+/// Time point of the benchmark clock
+typedef std::chrono::steady_clock::time_point BenchTime;
+
+/// Current time of the benchmark clock
+inline BenchTime bench_now() { return std::chrono::steady_clock::now(); }
+
+/// Time between two time points in microseconds
+inline double elapsed_us(const BenchTime& start, const BenchTime& end)
+	{ return std::chrono::duration<double, std::micro>(end - start).count(); }
+
+/**
+ * \brief Percentile of samples, nearest rank
+ * @param sorted - samples sorted in ascending order, not empty
+ * @param pct - percentile, 0 to 100
+ */
+double percentile(const std::vector<double>& sorted, const double pct);
+
+/**
+ * \brief Split a comma separated list
+ * @param list - text such as "1,10,100"
+ * @returns entries without the commas
+ */
+std::vector<std::string> split_list(const std::string& list);
+
+/*************************************************************** 
+ * class: BenchmarkResults
+ *
+ * Timing samples of named phases for several configurations
+ *
+ * Each configuration is a set of named parameters, e.g.
+ * population size and prevalence. Samples are collected per
+ * configuration and phase, and saved as summary statistics -
+ * number of samples, minimum, median, 90th and 99th
+ * percentile, maximum, and mean - in CSV or JSON files.
+ * Times are in microseconds.
+ **************************************************************/
+
+class BenchmarkResults
+{
+public:
+
+	/**
+	 * \brief Creates an empty set of results
+	 * @param bench_name - name of the benchmark, for the output
+	 * @param param_names - names of the configuration parameters
+	 */
+	BenchmarkResults(const std::string& bench_name, const std::vector<std::string>& param_names) :
+		name(bench_name), parameter_names(param_names) { }
+
+	/**
+	 * \brief Add a sample
+	 * @param params - values of the configuration parameters, in the
+	 * 		order of parameter names
+	 * @param phase - name of the timed phase
+	 * @param time_us - time in microseconds
+	 */
+	void add(const std::vector<std::string>& params, const std::string& phase, const double time_us);
+
+	/// Save summaries as CSV, one line per configuration and phase
+	void save_csv(const std::string& fname) const;
+
+	/// Save summaries as a JSON object with a list of results
+	void save_json(const std::string& fname) const;
+
+	/// Print a short table of medians to the stream
+	void print_medians(std::ostream& out) const;
+
+private:
+	// Samples of one configuration and phase
+	struct Series {
+		std::vector<std::string> parameters;
+		std::string phase;
+		std::vector<double> samples;
+	};
+
+	std::string name;
+	std::vector<std::string> parameter_names;
+	// In the order they were first added
+	std::vector<Series> series;
+};
+
+#endif
@@ -0,0 +1,66 @@
+import subprocess, glob, os
+
+#
+# Input 
+#
+
+# Path to the main directory
+path = '../../src/'
+# Compiler options
+cx = 'g++'
+std = '-std=c++11'
+opt = '-O3'
+thr = '-pthread'
+lib = '-lz'
+# Common source files
+src_files = path + 'abm.cpp' 
+src_files += ' ' + path + 'agent.cpp' 
+src_files += ' ' + path + 'infection.cpp'
+src_files += ' ' + path + 'contributions.cpp'
+src_files += ' ' + path + 'intervention_schedule.cpp'
+src_files += ' ' + path + 'interactions.cpp'
+src_files += ' ' + path + 'perf_stats.cpp'
+src_files += ' ' + path + 'tracer.cpp'
+src_files += ' ' + path + 'perf_counters.cpp'
+src_files += ' ' + path + 'ensemble.cpp'
+src_files += ' ' + path + 'parameter_sweep.cpp'
+src_files += ' ' + path + 'fork_runner.cpp'
+src_files += ' ' + path + 'equivalence.cpp'
+src_files += ' ' + path + 'transitions/transitions.cpp'
+src_files += ' ' + path + 'transitions/regular_transitions.cpp'
+src_files += ' ' + path + 'transitions/hospital_transitions.cpp'
+src_files += ' ' + path + 'transitions/testing_transitions.cpp'
+src_files += ' ' + path + 'states_manager/states_manager.cpp'
+src_files += ' ' + path + 'states_manager/regular_states_manager.cpp'
+src_files += ' ' + path + 'utils.cpp'
+src_files += ' ' + path + 'places/place.cpp'
+src_files += ' ' + path + 'places/household.cpp'
+src_files += ' ' + path + 'places/workplace.cpp'
+src_files += ' ' + path + 'places/hospital.cpp'
+src_files += ' ' + path + 'places/school.cpp'
+src_files += ' ' + path + 'places/place_activation.cpp'
+src_files += ' ' + path + 'io_operations/FileHandler.cpp'
+src_files += ' ' + path + 'io_operations/compressed_stream.cpp'
+src_files += ' ' + path + 'io_operations/input_validation.cpp'
+src_files += ' ' + path + 'io_operations/contact_network.cpp'
+src_files += ' ' + path + 'io_operations/block_writer.cpp'
+src_files += ' ' + path + 'io_operations/population_generator.cpp'
+src_files += ' ' + path + 'io_operations/population_tiling.cpp'
+src_files += ' ' + path + 'io_operations/load_parameters.cpp'
+src_files += ' ' + path + 'io_operations/agent_snapshots.cpp'
+src_files += ' ' + path + 'io_operations/event_log.cpp'
+
+bench_files = '../common/benchmark_utils.cpp'
+
+#
+# Compilation
+#
+
+#Benchmark 1
+#Phases of transmit_infection
+#Name of the executable
+exe_name = "transmission_bench"
+#Files needed only for this build
+spec_files = "transmission_benchmark.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, bench_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
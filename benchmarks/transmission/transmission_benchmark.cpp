@@ -0,0 +1,120 @@
+#include "../../include/abm.h"
+#include "../../include/io_operations/population_generator.h"
+#include "../common/benchmark_utils.h"
+
+/*****************************************************
+ *
+ * Benchmark of the phases of ABM::transmit_infection
+ *
+ * Usage: ./transmission_bench [populations] [prevalences]
+ * 			[steps] [output prefix]
+ *
+ * Populations are a comma separated list of numbers of
+ * agents of synthetic populations, or NR for New Rochelle;
+ * prevalences are fractions of agents infected before the
+ * first step. Every configuration starts from the same seed.
+ * Each phase is timed in every step; summaries are saved
+ * in prefix.csv and prefix.json
+ *
+ ******************************************************/
+
+ABM load_population(const std::string&, const std::string&, const double);
+
+int main(int argc, char* argv[])
+{
+	const std::vector<std::string> populations = split_list((argc > 1) ? argv[1] : "10000,100000,NR");
+	const std::vector<std::string> prevalences = split_list((argc > 2) ? argv[2] : "0.001,0.01,0.1");
+	const int n_steps = (argc > 3) ? std::stoi(argv[3]) : 50;
+	const std::string prefix = (argc > 4) ? argv[4] : "transmission_benchmark";
+
+	// Time in days, steps before timing starts
+	const double dt = 0.25;
+	const int n_warmup = 5;
+	const unsigned int seed = 2020;
+	const std::string data_dir("../../simulations/NewRochelle_population/input_data/");
+
+	BenchmarkResults results("transmit_infection", {"population", "agents", "prevalence"});
+
+	for (const auto& population : populations){
+		const ABM base = load_population(population, data_dir, dt);
+		const std::string n_agents = std::to_string(base.get_vector_of_agents().size());
+
+		for (const auto& prevalence : prevalences){
+			ABM abm(base);
+			abm.set_seed(seed);
+			abm.infect_random_agents(static_cast<int>(std::round(std::stod(prevalence)
+								*base.get_vector_of_agents().size())));
+			for (int ti = 0; ti < n_warmup; ++ti)
+				abm.transmit_infection();
+
+			const std::vector<std::string> config = {population, n_agents, prevalence};
+			// Same order as in transmit_infection, with the counts first
+			for (int ti = 0; ti < n_steps; ++ti){
+				BenchTime t0 = bench_now();
+				volatile int count = abm.get_num_susceptible();
+				BenchTime t1 = bench_now();
+				count = abm.get_num_infected();
+				BenchTime t2 = bench_now();
+				count = abm.get_num_exposed();
+				BenchTime t3 = bench_now();
+				count = abm.get_num_removed();
+				BenchTime t4 = bench_now();
+				abm.compute_agent_contributions();
+				BenchTime t5 = bench_now();
+				abm.total_place_contributions();
+				BenchTime t6 = bench_now();
+				abm.compute_state_transitions();
+				BenchTime t7 = bench_now();
+				abm.reset_place_sums();
+				BenchTime t8 = bench_now();
+				abm.advance_in_time();
+				(void)count;
+
+				results.add(config, "get_num_susceptible", elapsed_us(t0, t1));
+				results.add(config, "get_num_infected", elapsed_us(t1, t2));
+				results.add(config, "get_num_exposed", elapsed_us(t2, t3));
+				results.add(config, "get_num_removed", elapsed_us(t3, t4));
+				results.add(config, "compute_agent_contributions", elapsed_us(t4, t5));
+				results.add(config, "total_place_contributions", elapsed_us(t5, t6));
+				results.add(config, "compute_state_transitions", elapsed_us(t6, t7));
+				results.add(config, "reset_sums", elapsed_us(t7, t8));
+				results.add(config, "step", elapsed_us(t4, t8));
+			}
+		}
+	}
+
+	results.save_csv(prefix + ".csv");
+	results.save_json(prefix + ".json");
+	results.print_medians(std::cout);
+}
+
+/// New Rochelle or a synthetic population with n agents
+ABM load_population(const std::string& population, const std::string& data_dir, const double dt)
+{
+	std::map<std::string, std::string> dfiles =
+		{ {"mortality", data_dir + "age_dist_mortality.txt"} };
+	ABM abm(dt, data_dir + "infection_parameters.txt", dfiles);
+
+	if (population == "NR"){
+		abm.create_households(data_dir + "NR_households.txt");
+		abm.create_schools(data_dir + "NR_schools.txt");
+		abm.create_workplaces(data_dir + "NR_workplaces.txt");
+		abm.create_agents(data_dir + "NR_agents.txt");
+		return abm;
+	}
+
+	// Synthetic, same seed for every run of the benchmark
+	const std::string prefix("transmission_benchmark_population");
+	PopulationGenerator generator(PopulationSettings::scaled(std::stoi(population)), 1);
+	generator.write_households(prefix + "_households.txt");
+	generator.write_schools(prefix + "_schools.txt");
+	generator.write_workplaces(prefix + "_workplaces.txt");
+	generator.write_agents(prefix + "_agents.txt");
+	abm.create_households(prefix + "_households.txt");
+	abm.create_schools(prefix + "_schools.txt");
+	abm.create_workplaces(prefix + "_workplaces.txt");
+	abm.create_agents(prefix + "_agents.txt");
+	for (const std::string kind : {"households", "schools", "workplaces", "agents"})
+		std::remove((prefix + "_" + kind + ".txt").c_str());
+	return abm;
+}
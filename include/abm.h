@@ -3,6 +3,19 @@
 
 #include "abm_include.h"
 
+/**
+ * \brief Input parameters that don't change during a simulation
+ * \details Held through std::shared_ptr<const ModelParameters>, so
+ * 		copies of a model share them; changing parameters of one
+ * 		model replaces its instance only
+ */
+struct ModelParameters {
+	// Infection parameters
+	std::map<std::string, double> infection_parameters;
+	// Age-dependent distributions
+	std::map<std::string, std::map<std::string, double>> age_dependent_distributions;
+};
+
 /***************************************************** 
  * class: ABM
  * 
@@ -37,7 +50,8 @@ public:
 	 * \details Reads the infection parameters from the provided 
 	 * 				file and initializes Infection object;
 	 * 				The map key represents a tag to recognize which dataset
-	 * 				in question is it. The only tag is mortality
+	 * 				in question is it. Tags are mortality, and hospitalization
+	 * 				and ICU that are needed only with hospitals
 	 *
 	 * @param del_t - time step, days
 	 * @param infile - name of the file with the input parameters
@@ -91,6 +105,24 @@ public:
 	 */	
 	void create_workplaces(const std::string filename);
 
+	/**
+	 * \brief Create hospitals based on information in a file
+	 * \details Constructs hospitals based on the ID and locations
+	 * 				as defined in the file; One line in the file 
+	 * 				defines one hospital; An optional fourth column
+	 * 				is the ID of the workplace of its employees, 0 if 
+	 * 				none - needs to be called AFTER creating workplaces;
+	 * 				From then on, some symptomatic agents are treated 
+	 * 				in hospitals, which requires the "hospitalization" 
+	 * 				and "ICU" age-dependent distributions, see 
+	 * 				HospitalTransitions; A file without hospitals
+	 * 				is an error
+	 *	
+	 * @param filename - path of the file with input information
+	 * 
+	 */	
+	void create_hospitals(const std::string filename);
+
 	/**
      * \brief Create agents based on information in a file
      * \details Constructs agents from demographic information
@@ -107,6 +139,79 @@ public:
      */
     void create_agents(const std::string filename, const int ninf0 = 0);
 
+	/**
+	 * \brief Randomly chosen agents become exposed at this time
+	 * \details As in create_agents, IDs are drawn with repetition;
+	 * 		agents that are not susceptible are skipped
+	 * @param ninf - number of draws
+	 */
+	void infect_random_agents(const int ninf);
+
+	/**
+	 * \brief Restart all random number generators
+	 * \details Runs with the same seed, input, and calls are the same
+	 * @param seed - seed of the generators
+	 */
+	void set_seed(const unsigned int seed);
+
+	/**
+	 * \brief Replace values of some infection parameters
+	 * \details Parameters of the Infection object and coefficients of
+	 * 		places that depend on the changed parameters are updated;
+	 * 		Agents already infected keep their properties, so this is
+	 * 		meant for populations without infected agents
+	 * @param overrides - parameter names, as in the input file, and new values;
+	 * 		throws std::invalid_argument if a name is not a loaded parameter
+	 */
+	void set_infection_parameters(const std::map<std::string, double>& overrides);
+
+	//
+	// Interventions
+	//
+
+	/**
+	 * \brief Isolate symptomatic agents at home
+	 * \details From the onset of symptoms, agents contribute only to
+	 * 		their household, with the "transmission rate of home isolated";
+	 * 		their school and workplace memberships don't change
+	 * @param isolate - true if agents that become symptomatic from now on isolate
+	 */
+	void set_symptomatic_home_isolation(const bool isolate) 
+		{ transitions.set_symptomatic_home_isolation(isolate); }
+
+	/**
+	 * \brief Test infected agents, isolate the positive ones at home
+	 * \details From "start testing" on, with probabilities and delays
+	 * 		from the infection parameters, see TestingTransitions; 
+	 * 		Throws std::invalid_argument for non-positive number of tests
+	 * 		or negative number of waiting agents
+	 * @param tests_per_day - maximum number of tests in a day
+	 * @param max_waiting - maximum number of agents waiting for a test
+	 * 		when the tests of the day are used up, the ones with the
+	 * 		lowest priority are not tested
+	 */
+	void set_testing(const int tests_per_day, const int max_waiting);
+
+	/**
+	 * \brief Apply a schedule of interventions from now on
+	 * \details The schedule is copied and compiled for the time step and
+	 * 		places of this model, so it needs to be set after creating
+	 * 		the places; phases that started before the current time
+	 * 		apply right away, see InterventionSchedule
+	 * @param schedule - phases of interventions, with start times
+	 * 		in days from the start of the simulation
+	 */
+	void set_intervention_schedule(const InterventionSchedule& schedule);
+
+	/// \brief Remove the schedule, transmission rates are not modified
+	void clear_intervention_schedule() { set_intervention_schedule(InterventionSchedule()); }
+
+	/// Const reference to the schedule in use
+	const InterventionSchedule& get_intervention_schedule() const { return interventions; }
+
+	/// Index of the phase in effect in the last step, -1 if none
+	int get_intervention_phase() const { return intervention_phase; }
+
 	//
 	// Transmission of infection
 	//
@@ -116,12 +221,36 @@ public:
 	 */
 	void transmit_infection();
 
-	/// \brief Count contributions of all infectious agents in each place 
+	/**
+	 * \brief Count contributions of all infectious agents in each place 
+	 * \details Same as compute_agent_contributions followed by
+	 * 		total_place_contributions
+	 */
 	void compute_place_contributions();
 
+	/// \brief Add contributions of infectious agents to sums of their places
+	void compute_agent_contributions();
+
+	/**
+	 * \brief Compute total contributions of each place from the sums
+	 * \details Includes factors of the intervention phase of this step
+	 */
+	void total_place_contributions();
+
 	/// \brief Propagate infection and determine state transitions
 	void compute_state_transitions();
 
+	/// \brief Set place sums of contributions to 0 for the next step
+	void reset_place_sums()
+	{ 
+		ABM_PERF_SCOPE(perf_stats, PerfPhase::reset_sums);
+		contributions.reset_sums(households, schools, workplaces); 
+		contributions.reset_sums(hospitals);
+	}
+
+	/// \brief Increase time by one time step
+	void advance_in_time() { time += dt; }
+
 	//
 	// Getters
 	//
@@ -135,6 +264,24 @@ public:
 
 	int get_num_removed() const;
 
+	/// Retrieve number of agents isolated at home
+	int get_num_home_isolated() const;
+
+	/// Retrieve number of agents in hospitals, including ICU
+	int get_num_hospitalized() const;
+
+	/// Retrieve number of agents in ICU
+	int get_num_ICU() const;
+
+	/// Retrieve number of tests so far
+	int get_num_tested() const { return transitions.get_testing().get_number_tested(); }
+	/// Retrieve number of positive results so far
+	int get_num_tested_positive() const { return transitions.get_testing().get_number_positive(); }
+	/// Retrieve number of agents waiting for a test
+	int get_num_waiting_for_test() const { return transitions.get_testing().get_number_waiting(); }
+	/// Retrieve number of agents not tested because too many were waiting
+	int get_num_not_tested() const { return transitions.get_testing().get_number_not_tested(); }
+
 	/// Retrieve number of total infected
 	int get_total_infected() const { return n_infected_tot; }
 	/// Retrieve number of total dead 
@@ -142,6 +289,23 @@ public:
 	/// Retrieve number of total recovered
 	int get_total_recovered() const { return n_recovered_tot; }
 
+	//
+	// Event logging
+	//
+
+	/**
+	 * \brief Start logging agent transitions to a binary file
+	 * \details See EventLog for the format; Infections are attributed
+	 * 		to a household, school, or workplace sampled proportionally
+	 * 		to its contribution to the infection probability of the agent;
+	 * 		Only transitions after this call are logged
+	 * @param filename - path of the log file
+	 */
+	void enable_event_log(const std::string filename);
+
+	/// \brief Write all the logged events and stop logging
+	void disable_event_log();
+
 	//
 	// Saving simulation state
 	//
@@ -190,6 +354,17 @@ public:
 	*/
 	void print_workplaces(const std::string filename) const;	
 
+	/**
+	 * \brief Save current hospital information 
+	 * \details Outputs hospital information as 
+	 * 		hospital ID, x and y location, total number
+	 * 		of agents, number of infected agents, ck, and
+	 * 		transmission rates, see Hospital::print_basic
+	 * 		One line per hospital		
+	 * @param filename - path of the file to print to
+	*/
+	void print_hospitals(const std::string filename) const;	
+
 
 	/**
 	 * \brief Save IDs of all agents in all households
@@ -222,16 +397,42 @@ public:
 	*/
 	void print_agents(const std::string filename) const;
 
+	/**
+	 * \brief Save states of all agents as a snapshot step
+	 * \details Appends one step to the snapshot file, see
+	 * 		AgentSnapshotWriter for the format; Much more compact
+	 * 		than print_agents, suitable for saving every step;
+	 * 		Hospitalization, ICU, home isolation, and positive
+	 * 		tests are saved as AgentStateFlag
+	 * @param writer - snapshot writer created for this population 
+	*/
+	void save_agent_states(AgentSnapshotWriter& writer) const;
+
     /**
      *  \brief Collect all interactions for each agent
+     *  \details Appends the number of living contacts at this time to each 
+     *  	agent's interactions, -1 for dead agents; contacts are agents 
+     *  	sharing a household, school, or workplace, see Interactions
      */
     void collect_all_interactions();
 
     /**
      *  \brief Collect all dead interactions for each agent
+     *  \details Same as collect_all_interactions but for contacts that died;
+     *  	derived from the dead members recorded by places on each death,
+     *  	so it does not require counting over the whole population
      */
      void collect_dead_interactions();
 
+	/**
+	 * \brief Total number of contacts of all living agents at this time
+	 * \details Counted over all agents on the first call, then updated
+	 * 		on each death from the dead members recorded by places,
+	 * 		so per-step curves cost only the deaths of the step
+	 * @returns sums of living and of dead contacts, in that order
+	 */
+	std::pair<long long, long long> count_total_interactions();
+
     /**
      * \brief Output number of agent interactions for each agent into a txt file
      * @param fil
@@ -244,6 +445,20 @@ public:
     */
 
     void output_dead_interactions(std::string filename);
+
+	/**
+	 * \brief Save the contact network in binary CSR form
+	 * \details Graphs of agents and places they are registered in,
+	 * 		and of agents sharing a place, format described in
+	 * 		contact_network.h; memberships are indexed on each call
+	 * @param bipartite_name - output file for the agent-place graph
+	 * @param projection_name - output file for the agent-agent graph,
+	 * 		not saved if empty
+	 * @param weights - weights of contacts in each place type
+	 */
+	void output_contact_network(const std::string& bipartite_name,
+					const std::string& projection_name = "",
+					const ContactWeights& weights = ContactWeights()) const;
 	
 	//
 	// Functions mainly for testing
@@ -255,10 +470,18 @@ public:
 	const std::vector<School>& get_vector_of_schools() const { return schools; }
 	/// Return a const reference to a Workplace object vector
 	const std::vector<Workplace>& get_vector_of_workplaces() const { return workplaces; }
+	/// Return a const reference to a Hospital object vector
+	const std::vector<Hospital>& get_vector_of_hospitals() const { return hospitals; }
 	/// Return a const reference to an Agent object vector
 	const std::vector<Agent>& get_vector_of_agents() const { return agents; }
 	/// Return a reference to an Agent object vector
 	std::vector<Agent>& get_vector_of_agents_non_const()  { return agents; }
+	/// Return a reference to a House object vector
+	std::vector<Household>& get_vector_of_households_non_const() { return households; }
+	/// Return a reference to a School object vector
+	std::vector<School>& get_vector_of_schools_non_const() { return schools; }
+	/// Return a reference to a Workplace object vector
+	std::vector<Workplace>& get_vector_of_workplaces_non_const() { return workplaces; }
 	/// Return a copy of a House object vector
 	std::vector<Household> get_copied_vector_of_households() const { return households; }
 	/// Return a copy of a School object vector
@@ -269,7 +492,23 @@ public:
 	Infection get_copied_infection_object() const { return infection; }
 	/// Return a const reference to parameter map
 	const std::map<std::string, double> get_infection_parameters() const
-		{ return infection_parameters; }
+		{ return infection_parameters(); }
+
+	//
+	// Performance
+	//
+
+	/**
+	 * \brief Time spent in loading, transmission phases, and output
+	 * \details Collected only when compiled with ABM_WITH_PERF_STATS,
+	 * 		see PerfStats; copies of the model continue with the
+	 * 		times collected so far
+	 */
+	const PerfStats& get_perf_stats() const { return perf_stats; }
+	/// Set all collected times to 0
+	void reset_perf_stats() { perf_stats.reset(); }
+	/// Keep each measurement with its time step, see PerfStats::get_history()
+	void record_perf_history(const bool keep) { perf_stats.record_history(keep); }
 private:
 
 	// General model attributes
@@ -283,33 +522,78 @@ private:
 	int n_dead_tot = 0.0;
 	int n_recovered_tot = 0.0;
 
-	// Infection parameters
-	std::map<std::string, double> infection_parameters = {};
-
-	// Age-dependent distributions
-	std::map<std::string, std::map<std::string, double>> age_dependent_distributions = {};
+	// Infection parameters and age-dependent distributions,
+	// shared with copies of the model
+	std::shared_ptr<const ModelParameters> parameters = std::make_shared<const ModelParameters>();
 
 	// Infection properties and transmission model
 	Infection infection;
 	// Class for computing infection contributions
 	Contributions contributions;
+	// Interventions, compiled for this model, and the phase in effect
+	InterventionSchedule interventions;
+	int intervention_phase = -1;
 	// Class for computing agent transitions
 	Transitions transitions;
+	// Time of simulation phases, also collected in const output functions
+	mutable PerfStats perf_stats;
 	// Class for setting agent state transitions
 	StatesManager states_manager;
+	// Transition event log, empty if not logging
+	std::shared_ptr<EventLog> event_log;
+	// Place-based contact counting, indexed on first use
+	Interactions contact_counter;
+	// Contacts of living agents, all and dead ones; kept up
+	// to date on each death after the first count
+	bool has_contact_totals = false;
+	long long n_living_contacts = 0, n_dead_contacts = 0;
 
 	// Vectors of individual model objects
 	std::vector<Agent> agents;
 	std::vector<Household> households;
 	std::vector<School> schools;
 	std::vector<Workplace> workplaces;
+	std::vector<Hospital> hospitals;
 
 
 	// Private methods
 
+	/// Infection parameters shared with copies of the model
+	const std::map<std::string, double>& infection_parameters() const
+		{ return parameters->infection_parameters; }
+
+	/// Age-dependent distributions shared with copies of the model
+	const std::map<std::string, std::map<std::string, double>>& age_dependent_distributions() const
+		{ return parameters->age_dependent_distributions; }
+
 	/// Load infection parameters, store in a map
 	void load_infection_parameters(const std::string);
 
+	/// Set Infection distributions and probabilities from the parameter map
+	void set_infection_distributions();
+
+	/// Move to the intervention phase of the current step
+	void update_intervention_phase();
+
+	/// Send parameters of hospital treatment to hospitals, Infection, and Transitions
+	void set_hospital_parameters();
+
+	/// Send parameters of testing to Infection and Transitions
+	void set_testing_parameters();
+
+	/// Name of the absenteeism correction parameter of a school type, empty if wrong type
+	std::string school_absenteeism_parameter(const std::string& school_type) const;
+
+	/// Index place memberships of agents if not indexed yet
+	void index_contacts();
+
+	/// Number of dead contacts of an agent from dead members of its places,
+	/// including itself if dead
+	int count_dead_contacts(const Agent& agent) const;
+
+	/// Update contact totals after the death of an agent
+	void add_death_to_contact_totals(const Agent& agent);
+
 	/// Load age-dependent distributions as vectors stored in a map
 	void load_age_dependent_distributions(const std::map<std::string, std::string>);
 
@@ -325,18 +609,15 @@ private:
 //Might use, might not
     void initial_exposed_with_never_sy(Agent&);
 
-	// Increasing time
-	void advance_in_time() { time += dt; }
-
 	/**
 	 * \brief Print basic places information to a file
 	 */
 	template <typename T>
-	void print_places(std::vector<T> places, const std::string fname) const;
+	void print_places(const std::vector<T>& places, const std::string fname) const;
 
 	/// \brief Print all agent IDs in a particular type of place to a file
 	template <typename T>
-	void print_agents_in_places(std::vector<T> places, const std::string fname) const;
+	void print_agents_in_places(const std::vector<T>& places, const std::string fname) const;
 
     /**
      * \brief Retrieve information about agents from a file and store all in a vector
@@ -351,42 +632,35 @@ private:
 };
 
 // Write Place objects
+// Same format as AbmIO::write_vector, one place per line
 template <typename T>
-void ABM::print_places(std::vector<T> places, const std::string fname) const
+void ABM::print_places(const std::vector<T>& places, const std::string fname) const
 {
-	// AbmIO settings
-	std::string delim(" ");
-	bool sflag = true;
-	std::vector<size_t> dims = {0,0,0};	
-
-	// Write data to file
-	AbmIO abm_io(fname, delim, sflag, dims);
-	abm_io.write_vector<T>(places);
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
+	BlockWriter out(fname);
+	for (const auto& place : places){
+		place.print_basic(out);
+		out << '\n';
+	}
 }
 
 // Write agent IDs in Place objects
+// Same format as AbmIO::write_vector for nested vectors, 
+// one line per place, each ID followed by a space
 template <typename T>
-void ABM::print_agents_in_places(std::vector<T> places, const std::string fname) const
+void ABM::print_agents_in_places(const std::vector<T>& places, const std::string fname) const
 {
-	// AbmIO settings
-	std::string delim(" ");
-	bool sflag = true;
-	std::vector<size_t> dims = {0,0,0};	
-
-	// First collect the data into a nested vector
-	std::vector<std::vector<int>> agents_all_places;
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
+	BlockWriter out(fname);
 	for (const auto& place : places){
-		std::vector<int> agent_IDs = place.get_agent_IDs();
+		const std::vector<int>& agent_IDs = place.get_agent_IDs();
 		// If no agents, store a 0
 		if (agent_IDs.empty())
-			agents_all_places.push_back({0});
-		else
-			agents_all_places.push_back(agent_IDs);
+			out << 0 << ' ';
+		for (const auto& ID : agent_IDs)
+			out << ID << ' ';
+		out << '\n';
 	}
-
-	// Then write data to file, one line per place
-	AbmIO abm_io(fname, delim, sflag, dims);
-	abm_io.write_vector<int>(agents_all_places);
 }
 
 
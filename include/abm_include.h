@@ -9,6 +9,7 @@
 #include "places/household.h"
 #include "places/school.h"
 #include "places/workplace.h"
+#include "places/hospital.h"
 
 //
 // Transitions
@@ -29,8 +30,16 @@
 #include "common.h"
 #include "./io_operations/abm_io.h"
 #include "./io_operations/load_parameters.h"
+#include "./io_operations/agent_snapshots.h"
+#include "./io_operations/event_log.h"
+#include "./io_operations/block_writer.h"
+#include "./io_operations/input_validation.h"
+#include "./io_operations/contact_network.h"
 #include "agent.h"
 #include "infection.h"
 #include "contributions.h"
+#include "intervention_schedule.h"
+#include "interactions.h"
+#include "perf_stats.h"
 
 #endif
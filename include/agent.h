@@ -68,6 +68,8 @@ public:
 	int get_school_ID() const { return school_ID; }
 	/// Work ID
 	int get_work_ID() const { return work_ID; }
+	/// Hospital ID, 0 if not hospitalized
+	int get_hospital_ID() const { return hospital_ID; }
 	/// Location - x coordinates
 	double get_x_location() const { return x; }	
 	/// Location - y coordinates
@@ -87,6 +89,19 @@ public:
 	bool recovering_exposed() const { return is_recovering_exposed; }
 	bool symptomatic() const { return is_symptomatic; }
 
+	/// True if staying home, contributing only to the household
+	bool home_isolated() const { return is_home_isolated; }
+
+	/// True if treated in a hospital, contributing only there
+	bool hospitalized() const { return is_hospitalized; }
+	/// True if treated in ICU of the hospital
+	bool in_ICU() const { return is_in_ICU; }
+
+	/// True from the decision to get tested until the results
+	bool tested() const { return is_tested; }
+	/// True if had a positive test result
+	bool tested_positive() const { return is_tested_positive; }
+
 	// Removal
 	bool dying() const { return will_die; }
 	bool recovering() const { return will_recover; }
@@ -123,6 +138,9 @@ public:
 	/// Assign household ID
 	void set_household_ID(const int ID) { house_ID = ID; }
 
+	/// Assign hospital ID, 0 if not hospitalized
+	void set_hospital_ID(const int ID) { hospital_ID = ID; }
+
 	/// Change infection status
 	void set_infected(const bool infected) { is_infected = infected; }
 
@@ -154,6 +172,11 @@ public:
 	void set_exposed(const bool val) { is_exposed = val; }
 	void set_recovering_exposed(const bool re) { is_recovering_exposed = re; }
 	void set_symptomatic(const bool val) { is_symptomatic = val; }
+	void set_home_isolated(const bool val) { is_home_isolated = val; }
+	void set_hospitalized(const bool val) { is_hospitalized = val; }
+	void set_in_ICU(const bool val) { is_in_ICU = val; }
+	void set_tested(const bool val) { is_tested = val; }
+	void set_tested_positive(const bool val) { is_tested_positive = val; }
 
 	void set_dying(const bool val) { will_die = val; }
 	void set_recovering(const bool val) { will_recover = val; }
@@ -178,11 +201,6 @@ public:
 	 */	
 	void print_basic(std::ostream& where) const;
 
-    /**
-     * \brief Retrieve number of agent interactions at timestep
-     */
-    std::vector<int> collect_interactions(const std::vector<Agent>& agents);
-
 private:
 
 	// General demographic information
@@ -220,6 +238,9 @@ private:
 	int agent_school_type = -1;
 	bool worksSch = false;
 
+	// Hospital of a hospitalized agent
+	int hospital_ID = 0;
+
 	// Infection status
 	bool is_infected = false;
 
@@ -231,6 +252,14 @@ private:
 	// Recovering without ever developing symptoms
 	bool is_recovering_exposed = false;
 	bool is_symptomatic = false;
+	// Only in the household, school and work memberships are kept
+	bool is_home_isolated = false;
+	// In a hospital, memberships in other places are kept
+	bool is_hospitalized = false;
+	bool is_in_ICU = false;
+	// Waiting for a test or results, and positive results
+	bool is_tested = false;
+	bool is_tested_positive = false;
 
 	// Testing phases and types
 	bool will_die = false;
@@ -14,5 +14,6 @@
 #include <vector>
 #include <cctype>
 #include <map>
+#include <memory>
 
 #endif
@@ -9,6 +9,8 @@
 #include "places/household.h"
 #include "places/school.h"
 #include "places/workplace.h"
+#include "places/hospital.h"
+#include "places/place_activation.h"
 
 //
 // Other
@@ -61,14 +63,52 @@ public:
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces);
 
+	/** 
+	 * \brief Count contributions of a hospitalized agent
+	 * \details Only to the hospital, memberships in other places don't change
+	 * @param agent - reference to Agent object
+	 * @param hospitals - reference to vector of hospitals
+	 */
+	void compute_hospitalized_contributions(const Agent& agent, std::vector<Hospital>& hospitals);
+
 	/// \brief Compute the total contribution to infection probability at every place
 	void total_place_contributions(std::vector<Household>& households, 
 					std::vector<School>& schools, std::vector<Workplace>& workplaces);
 
+	/**
+	 * \brief Compute the total contributions of open places with factors of transmission rates
+	 * \details As total_place_contributions, then multiplies the total
+	 * 		of each open school and workplace by its factor and sets
+	 * 		the total of closed ones to 0
+	 * @param school_factors - factor of each school, in the order of schools 
+	 * @param workplace_factors - factor of each workplace 
+	 * @param open_schools - schools that are open
+	 * @param open_workplaces - workplaces that are open
+	 */
+	void total_place_contributions(std::vector<Household>& households, 
+					std::vector<School>& schools, std::vector<Workplace>& workplaces,
+					const std::vector<double>& school_factors,
+					const std::vector<double>& workplace_factors,
+					const PlaceActivation& open_schools, const PlaceActivation& open_workplaces);
+
+	/**
+	 * \brief Compute the total contributions of hospitals 
+	 * \details Includes employees in the staff workplaces, and adds the
+	 * 		contribution of each hospital to its staff workplace, after 
+	 * 		any interventions, so employees are exposed to patients
+	 * @param hospitals - all hospitals 
+	 * @param workplaces - all workplaces, with their totals already computed
+	 */
+	void total_hospital_contributions(std::vector<Hospital>& hospitals, 
+					std::vector<Workplace>& workplaces);
+
 	/// \brief Set contributions/sums from all agents in places to 0.0 
 	void reset_sums(std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces);
 
+	/// \brief Set contributions/sums from all patients in hospitals to 0.0 
+	void reset_sums(std::vector<Hospital>& hospitals);
+
 
 
 private:
@@ -0,0 +1,117 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "abm.h"
+#include "utils.h"
+#include <functional>
+#include <type_traits>
+
+/*****************************************************
+ * class: Ensemble
+ *
+ * Runs replicates of a model concurrently in one
+ * process
+ *
+ * The population - agents, places, and parameters - is
+ * loaded once into an ABM object that is kept unchanged.
+ * Each replicate starts from a copy of it, so input files
+ * are not parsed again. Replicates are distributed over a
+ * fixed number of threads, so at most that many copies
+ * exist at any time regardless of the number of replicates.
+ *
+ * Data that doesn't change during a simulation is shared
+ * by the copies through std::shared_ptr<const ...>: infection
+ * parameters, age-dependent distributions, and lists of agents
+ * in places. A replicate copies a place list only when it
+ * changes it, e.g. when a member dies or isolates. Agent
+ * demographics are stored in Agent objects next to their
+ * state, so they are copied with the replicate.
+ *
+ * Each replicate has its own random number generators
+ * seeded from the base seed and the replicate number, so
+ * results don't depend on the number of threads.
+ *
+ ******************************************************/
+
+class Ensemble{
+public:
+
+	//
+	// Constructors
+	//
+
+	Ensemble() = delete;
+
+	/**
+	 * \brief Creates an Ensemble from a fully created model
+	 * \details The model is copied; event logging of the copy
+	 * 		is disabled, replicates can enable their own logs
+	 * @param population - model with places and agents created
+	 * @param n_thr - number of threads, 0 for the number of
+	 * 		hardware threads
+	 */
+	Ensemble(const ABM& population, const unsigned int n_thr = 0);
+
+	//
+	// Running
+	//
+
+	/**
+	 * \brief Run replicates, return their results in order
+	 * \details Each replicate gets a fresh copy of the population
+	 * 		with random number generators already seeded; the first
+	 * 		exception thrown by any replicate stops starting new
+	 * 		replicates and is rethrown after the running ones finish
+	 * @param n_replicates - number of replicates
+	 * @param replicate - function that simulates one replicate,
+	 * 		called with the model copy and replicate number
+	 * 		(starting with 0); called concurrently, so it can only
+	 * 		share data with other replicates in a thread-safe way
+	 * @param base_seed - seed from which the replicate seeds are derived
+	 * @returns vector of results returned by replicate
+	 */
+	template <typename T>
+	std::vector<T> run(const int n_replicates,
+						const std::function<T(ABM&, const int)>& replicate,
+						const unsigned int base_seed = 0) const;
+
+	//
+	// Getters
+	//
+
+	/// Number of threads used for running
+	unsigned int get_number_of_threads() const { return n_threads; }
+
+	/// Seed of a replicate derived from the base seed
+	static unsigned int replicate_seed(const unsigned int base_seed, const int replicate);
+
+	/// Const reference to the model replicates start from
+	const ABM& get_population() const { return *population; }
+
+private:
+	// Model that replicates start from, never modified
+	std::shared_ptr<const ABM> population;
+	unsigned int n_threads = 1;
+};
+
+// Run replicates, return their results in order
+template <typename T>
+std::vector<T> Ensemble::run(const int n_replicates,
+						const std::function<T(ABM&, const int)>& replicate,
+						const unsigned int base_seed) const
+{
+	// Elements of std::vector<bool> can't be written concurrently
+	static_assert(!std::is_same<T, bool>::value, "Ensemble results can't be of type bool");
+	if (n_replicates < 0)
+		throw std::invalid_argument("Number of replicates can't be negative");
+
+	std::vector<T> results(n_replicates);
+	parallel_for(0, n_replicates, n_threads, [&](const int i){
+			ABM abm(*population);
+			abm.set_seed(replicate_seed(base_seed, i));
+			results[i] = replicate(abm, i);
+		});
+	return results;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef EQUIVALENCE_H
+#define EQUIVALENCE_H
+
+#include "ensemble.h"
+#include <functional>
+
+/*****************************************************
+ * Two-sample tests of equal distributions
+ ******************************************************/
+
+/// Statistic and p-value of a two-sample test
+struct TwoSampleResult {
+	double statistic = 0.0;
+	double p_value = 1.0;
+};
+
+/**
+ * \brief Two-sample Kolmogorov-Smirnov test
+ * \details The p-value is the asymptotic one with the
+ * 		Stephens correction for small samples; with ties,
+ * 		as in counts of agents, it is conservative
+ * @param x, y - samples, not empty
+ * @returns largest difference of the empirical distributions
+ * 		and the p-value
+ */
+TwoSampleResult ks_test(std::vector<double> x, std::vector<double> y);
+
+/**
+ * \brief Two-sample Anderson-Darling test
+ * \details Midrank version for ties of Scholz and Stephens,
+ * 		J. Am. Stat. Assoc. 82, 918 (1987). P-values are
+ * 		interpolated from their table of critical values,
+ * 		p = 0.25 to 0.001, capped at 0.25 above and
+ * 		extrapolated log-linearly below 0.001
+ * @param x, y - samples, together with at least 4 values
+ * @returns the statistic A2akN and the p-value
+ */
+TwoSampleResult anderson_darling_test(std::vector<double> x, std::vector<double> y);
+
+/*****************************************************
+ * class: EquivalenceTest
+ *
+ * Statistical comparison of two simulation engines
+ *
+ * An engine is a function that advances a model by one
+ * time step; the reference engine is transmit_infection.
+ * Faster engines - parallel, with different random number
+ * streams or sampling - don't reproduce its results
+ * exactly, but should reproduce their distribution.
+ *
+ * Both engines simulate an ensemble of replicates from the
+ * same population with independent seeds. Final epidemic
+ * size, time step of the peak of infected agents, and the
+ * number of susceptible, exposed, infected, and removed
+ * agents at regularly spaced steps are then compared with
+ * Kolmogorov-Smirnov and Anderson-Darling tests. The
+ * significance applies to all the tests together, i.e.
+ * each test uses the Bonferroni corrected level. Quantities
+ * that are the same constant in both ensembles are skipped.
+ *
+ ******************************************************/
+
+/// Advances a model by one time step
+typedef std::function<void(ABM&)> StepFunction;
+
+/// Compartment sizes of one replicate, before every step and after the last
+struct EpidemicCurve {
+	std::vector<int> susceptible;
+	std::vector<int> exposed;
+	std::vector<int> infected;
+	std::vector<int> removed;
+	// Agents that are not susceptible at the end
+	int final_size = 0;
+	// First step with most infected agents, and their number
+	int peak_step = 0;
+	int peak_infected = 0;
+};
+
+/// Comparison of one quantity
+struct EquivalenceResult {
+	std::string quantity;
+	// Time step, -1 for quantities of a whole run
+	int step = -1;
+	// "KS" or "AD"
+	std::string test;
+	double statistic = 0.0;
+	double p_value = 1.0;
+	// Smallest p-value that passes
+	double threshold = 0.0;
+	bool passed = true;
+};
+
+class EquivalenceTest{
+public:
+
+	//
+	// Constructors
+	//
+
+	EquivalenceTest() = delete;
+
+	/**
+	 * \brief Creates a test for a population
+	 * @param population - model with places and agents created
+	 * @param n_initial - agents infected at random before the
+	 * 		first step, 0 to keep the infected agents of the population
+	 * @param n_steps - time steps of each replicate
+	 * @param n_replicates - replicates of each engine
+	 * @param alpha - significance level of all the tests together
+	 * @param n_thr - number of threads, 0 for the number of
+	 * 		hardware threads
+	 */
+	EquivalenceTest(const ABM& population, const int n_initial, const int n_steps,
+					const int n_replicates, const double alpha = 0.01, const unsigned int n_thr = 0);
+
+	//
+	// Settings
+	//
+
+	/// Compare compartments every this many steps, by default about 10 steps in total
+	void set_step_stride(const int stride);
+
+	/// Base seeds of replicates of the reference and the candidate engine
+	void set_seeds(const unsigned int reference, const unsigned int candidate)
+		{ reference_seed = reference; candidate_seed = candidate; }
+
+	//
+	// Running
+	//
+
+	/// Curves of all replicates simulated with an engine
+	std::vector<EpidemicCurve> simulate(const StepFunction& engine, const unsigned int base_seed) const;
+
+	/**
+	 * \brief Simulate with both engines and compare the results
+	 * @returns result of every test that was done
+	 */
+	std::vector<EquivalenceResult> compare(const StepFunction& reference,
+											const StepFunction& candidate) const;
+
+	/// Compare curves of two ensembles
+	std::vector<EquivalenceResult> compare(const std::vector<EpidemicCurve>& reference,
+											const std::vector<EpidemicCurve>& candidate) const;
+
+	//
+	// Results
+	//
+
+	/// The reference engine, ABM::transmit_infection
+	static StepFunction reference_engine()
+		{ return [](ABM& abm){ abm.transmit_infection(); }; }
+
+	/// True if every test passed
+	static bool all_passed(const std::vector<EquivalenceResult>& results);
+
+	/// Print a table of results, only of failed tests unless all is true
+	static void print(std::ostream& out, const std::vector<EquivalenceResult>& results,
+						const bool all = false);
+
+private:
+	Ensemble ensemble;
+	int initial_infected = 0;
+	int steps = 0;
+	int replicates = 0;
+	double significance = 0.01;
+	int step_stride = 1;
+	unsigned int reference_seed = 1;
+	unsigned int candidate_seed = 2;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef FORK_RUNNER_H
+#define FORK_RUNNER_H
+
+#include "abm.h"
+#include <functional>
+
+/*****************************************************
+ * class: ForkRunner
+ *
+ * Runs replicates of a model in child processes
+ *
+ * The population is created once in the parent process.
+ * Each replicate is a forked child that inherits it
+ * through copy-on-write pages, reseeds the random number
+ * generators, simulates, and sends its results back over
+ * a pipe. Only the pages a replicate changes are copied,
+ * and a crash or a memory limit affects only that replicate.
+ *
+ * Replicates are seeded as in Ensemble, so the same
+ * replicate gives the same results with both.
+ *
+ * POSIX only. The parent should not have other threads
+ * running when replicates are started.
+ *
+ ******************************************************/
+
+class ForkRunner{
+public:
+
+	//
+	// Constructors
+	//
+
+	ForkRunner() = delete;
+
+	/**
+	 * \brief Creates a ForkRunner for a fully created model
+	 * \details The model is not copied and needs to exist while
+	 * 		running; it is never changed in the parent process
+	 * 		except that its event log is disabled, since it would
+	 * 		be shared by all the children
+	 * @param population - model with places and agents created
+	 * @param n_proc - maximum number of children running at once,
+	 * 		0 for the number of hardware threads
+	 * @param mem_limit - limit of the address space of each child
+	 * 		in bytes, 0 for no limit
+	 */
+	ForkRunner(ABM& population, const unsigned int n_proc = 0, const std::size_t mem_limit = 0);
+
+	//
+	// Running
+	//
+
+	/**
+	 * \brief Run replicates, return their results in order
+	 * \details All replicates are run even if some fail, i.e. throw,
+	 * 		crash, or exit without results; then std::runtime_error
+	 * 		lists the failed ones, unless errors is given
+	 * @param n_replicates - number of replicates
+	 * @param replicate - function that simulates one replicate in
+	 * 		the child, called with the inherited model and replicate
+	 * 		number (starting with 0)
+	 * @param base_seed - seed from which the replicate seeds are derived
+	 * @param errors - if not nullptr, set to the reason of failure of
+	 * 		each replicate, empty if it succeeded, and nothing is thrown
+	 * @returns vector of results returned by replicate, empty for
+	 * 		replicates that failed
+	 */
+	std::vector<std::vector<double>> run(const int n_replicates,
+						const std::function<std::vector<double>(ABM&, const int)>& replicate,
+						const unsigned int base_seed = 0,
+						std::vector<std::string>* errors = nullptr) const;
+
+	//
+	// Getters
+	//
+
+	/// Maximum number of children running at once
+	unsigned int get_number_of_processes() const { return n_processes; }
+
+private:
+	// Model inherited by the children
+	ABM& population;
+	unsigned int n_processes = 1;
+	std::size_t memory_limit = 0;
+
+	/// \brief Simulate one replicate in the child and write results to fd, never returns
+	void run_child(const int fd, const int rep,
+					const std::function<std::vector<double>(ABM&, const int)>& replicate,
+					const unsigned int base_seed) const;
+};
+
+#endif
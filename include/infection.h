@@ -57,6 +57,29 @@ public:
 	/// \brief Returns randomly chosen time left for agent to live
 	double time_to_death();
 
+	/// \brief Determine if a symptomatic agent will be hospitalized based on age
+	bool will_be_hospitalized(const int age);
+
+	/// \brief Determine if a hospitalized agent will need ICU based on age
+	bool will_need_ICU(const int age);
+
+	/// \brief Returns randomly chosen time from onset of symptoms to hospitalization
+	double time_to_hospitalization();
+
+	/// \brief Determine if the agent decides to get tested
+	/// @param symptomatic - true if at the onset of symptoms, false if exposed
+	bool will_get_tested(const bool symptomatic);
+
+	/// \brief Determine if a test of an infected agent is negative
+	bool false_negative_test();
+
+	/// \brief Determine if a test of an agent that is not infected is positive
+	bool false_positive_test();
+
+	/// \brief Returns random hospital ID
+	/// @param n_hsp - total number of hospitals
+	int get_random_hospital_ID(const int n_hsp);
+
 	/// \brief Returns random house ID  
 	/// @param n_hs - total number of households 
 	int get_random_household_ID(const int n_hs);
@@ -67,6 +90,9 @@ public:
 	// Setters
 	//
 
+	/// \brief Restart the random number generator with a given seed
+	void set_seed(const unsigned int seed) { rng.seed(seed); }
+
 	void set_latency_distribution(const double mean, const double std)
 		{ ln_mean_lat = mean; ln_std_lat = std; }
 
@@ -76,6 +102,9 @@ public:
 	void set_onset_to_death_distribution(const double mean, const double std)
 		{ otd_mean = mean; otd_std = std; }
 
+	void set_onset_to_hospitalization_distribution(const double k, const double theta)
+		{ oth_k = k; oth_theta = theta; }
+
 	/**
 	 * \brief Assing various single number probabilities
 	 * @param pr_e_rec - probability that exposed will recover without symptoms
@@ -84,12 +113,36 @@ public:
 	void set_other_probabilities(const double pr_e_rec)
 		{prob_recovering_exposed = pr_e_rec; prob_sym = 1 - prob_recovering_exposed; }
 
+	/**
+	 * \brief Assign probabilities related to testing
+	 * @param pr_sy_test - probability that a symptomatic agent gets tested
+	 * @param pr_exp_test - probability that an exposed agent gets tested
+	 * @param pr_false_neg - probability of a negative result of an infected agent
+	 * @param pr_false_pos - probability of a positive result of an agent not infected
+	 */
+	void set_testing_probabilities(const double pr_sy_test, const double pr_exp_test,
+					const double pr_false_neg, const double pr_false_pos)
+		{ prob_sy_tested = pr_sy_test; prob_exp_tested = pr_exp_test;
+		  prob_false_neg = pr_false_neg; prob_false_pos = pr_false_pos; }
+
 	/**
 	 * \brief Process and store the age-dependent mortality rate distribution
 	 * @param raw_rates - map with string of age range (inclusive) to probability 
 	 */
 	void set_mortality_rates(const std::map<std::string, double> raw_rates);
 
+	/**
+	 * \brief Process and store the age-dependent hospitalization rate distribution
+	 * @param raw_rates - map with string of age range (inclusive) to probability 
+	 */
+	void set_hospitalization_rates(const std::map<std::string, double> raw_rates);
+
+	/**
+	 * \brief Process and store the age-dependent distribution of ICU among hospitalized
+	 * @param raw_rates - map with string of age range (inclusive) to probability 
+	 */
+	void set_ICU_rates(const std::map<std::string, double> raw_rates);
+
 
 	//
 	// Getters
@@ -97,7 +150,7 @@ public:
 
 	/// Return map with mortality rates
 	const std::map<std::string, std::tuple<int, int, double>>& get_mortality_rates() const 
-		{ return mortality_rates; }
+		{ return *mortality_rates; }
 
 	//
 	// I/O
@@ -158,6 +211,15 @@ protected:
 	// Probability the agent will develop symptoms
 	double prob_sym = 0.0;
 
+	// Probabilities of getting tested when symptomatic 
+	// and when exposed
+	double prob_sy_tested = 0.0;
+	double prob_exp_tested = 0.0;
+
+	// Probabilities of wrong test results
+	double prob_false_neg = 0.0;
+	double prob_false_pos = 0.0;
+
 	// Random distribution generator
 	RNG rng;
 	
@@ -165,8 +227,17 @@ protected:
 	// Age-dependent distributions
 	//
 	
+	// Don't change after loading, so copies of the
+	// object share them
+
 	// Mortality rates (age group: min age, max age, probability)
-	std::map<std::string, std::tuple<int, int, double>> mortality_rates;
+	std::shared_ptr<const std::map<std::string, std::tuple<int, int, double>>> mortality_rates
+		= std::make_shared<const std::map<std::string, std::tuple<int, int, double>>>();
+	// Hospitalization rates of symptomatic and ICU rates of hospitalized
+	std::shared_ptr<const std::map<std::string, std::tuple<int, int, double>>> hospitalization_rates
+		= std::make_shared<const std::map<std::string, std::tuple<int, int, double>>>();
+	std::shared_ptr<const std::map<std::string, std::tuple<int, int, double>>> ICU_rates
+		= std::make_shared<const std::map<std::string, std::tuple<int, int, double>>>();
 
 	//
 	// Private functions
@@ -174,6 +245,14 @@ protected:
 
 	// Extract min and max age in a group from age-dependent distributions
 	std::vector<int> parse_age_group(const std::string group_range);
+
+	// Age groups with their probabilities from age-dependent distributions
+	std::map<std::string, std::tuple<int, int, double>> process_age_groups(
+					const std::map<std::string, double>& raw_rates);
+
+	// True with the probability of the age group of the agent
+	bool sample_by_age(const std::map<std::string, std::tuple<int, int, double>>& rates, 
+					const int age);
 };
 
 /// Overloaded ostream operator for I/O
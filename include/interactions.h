@@ -0,0 +1,68 @@
+#ifndef INTERACTIONS_H
+#define INTERACTIONS_H
+
+#include "common.h"
+#include "agent.h"
+
+/*****************************************************
+ * class: Interactions
+ *
+ * Counts contacts of agents through the places they
+ * belong to
+ *
+ * Contacts of an agent are all other agents that share
+ * its household, its school (students and school
+ * employees), or its workplace. Each contact is counted
+ * once even if two agents share more than one place.
+ *
+ * Memberships don't change, so the number of contacts
+ * of each agent, dead or alive, is counted once when
+ * indexing; contacts that died are known from the dead
+ * members recorded by places.
+ *
+ ******************************************************/
+
+class Interactions{
+public:
+
+	//
+	// Constructors
+	//
+
+	/// \brief Default constructor only
+	Interactions() = default;
+
+	//
+	// Indexing
+	//
+
+	/**
+	 * \brief Index place memberships and count contacts of all agents
+	 * \details Memberships are taken from agent properties, so
+	 * 		agents temporarily removed from places still count.
+	 * 		Needs to be repeated if agents are added.
+	 * @param agents - vector of all agents, ordered by ID
+	 * @param n_households - number of households
+	 * @param n_schools - number of schools
+	 * @param n_workplaces - number of workplaces
+	 */
+	void build_index(const std::vector<Agent>& agents, const int n_households,
+						const int n_schools, const int n_workplaces);
+
+	/// True if the index was built for this number of agents
+	bool is_indexed(const std::size_t n_agents) const
+		{ return n_agents > 0 && contacts.size() == n_agents; }
+
+	//
+	// Getters
+	//
+
+	/// Number of contacts of agent with index i, dead or alive
+	int get_number_of_contacts(const std::size_t i) const { return contacts[i]; }
+
+private:
+	// Contacts of each agent, ordered as agents
+	std::vector<int> contacts;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef INTERVENTION_SCHEDULE_H
+#define INTERVENTION_SCHEDULE_H
+
+#include "common.h"
+#include "places/place_activation.h"
+
+/*****************************************************
+ * class: InterventionSchedule
+ *
+ * Timeline of interventions that change transmission
+ * in schools and workplaces
+ *
+ * Each phase starts at some time and sets, until the
+ * next phase, the fractions of schools and workplaces
+ * that are open and factors that multiply the total
+ * contributions, i.e. the transmission rates, of the
+ * open ones. Closed places contribute nothing. Before
+ * use, phases are compiled for a population into the
+ * time step where they start, a bitset of open places
+ * of each type, and a factor for every place, so the
+ * model only switches between precomputed phases when
+ * one starts and otherwise does one lookup per place.
+ *
+ * Open places are chosen in the order of a random
+ * ranking of each place type, the same in all phases,
+ * so a phase with a larger fraction opens a superset of
+ * places of a phase with a smaller one. The ranking
+ * depends only on the seed of the schedule, not on the
+ * seed of the model, so all replicates close the same
+ * places.
+ *
+ ******************************************************/
+
+/// Interventions in effect from some time on
+struct InterventionPhase {
+	std::string name;
+	// Start, days
+	double time = 0.0;
+	// Factors of transmission rates of all schools and all workplaces
+	double school_factor = 1.0;
+	double workplace_factor = 1.0;
+	// Fractions of schools and workplaces that are open
+	double school_open = 1.0;
+	double workplace_open = 1.0;
+};
+
+class InterventionSchedule{
+public:
+
+	//
+	// Constructors
+	//
+
+	/// Empty schedule, no interventions
+	InterventionSchedule() = default;
+
+	/**
+	 * \brief Schedule of closures and reopening from infection parameters
+	 * \details Schools close at "school closure"; at "lockdown" and
+	 * 		"reopening phase 1" to "3" only the "fraction of ld businesses"
+	 * 		and "fraction of phase 1 businesses" to "3" of workplaces
+	 * 		respectively stay open; schools stay closed through the reopening
+	 * @param parameters - infection parameters as loaded by ABM; throws
+	 * 		std::invalid_argument if any of the above is missing or invalid
+	 */
+	static InterventionSchedule from_parameters(const std::map<std::string, double>& parameters);
+
+	//
+	// Phases
+	//
+
+	/**
+	 * \brief Add a phase, phases are kept in order of their start
+	 * @param name - name of the phase, for output
+	 * @param time - start of the phase, days, not negative
+	 * @param school_factor - factor of school transmission rates, not negative
+	 * @param workplace_factor - factor of workplace transmission rates, not negative
+	 * @param school_open - fraction of schools that are open
+	 * @param workplace_open - fraction of workplaces that are open
+	 */
+	void add_phase(const std::string& name, const double time,
+					const double school_factor, const double workplace_factor,
+					const double school_open = 1.0, const double workplace_open = 1.0);
+
+	/// All phases in order of their start
+	const std::vector<InterventionPhase>& get_phases() const { return phases; }
+
+	/// Number of phases
+	int get_number_of_phases() const { return static_cast<int>(phases.size()); }
+
+	/// Seed of the random ranking of places that are opened
+	void set_seed(const unsigned int seed_in) { seed = seed_in; }
+
+	//
+	// Compiled form
+	//
+
+	/**
+	 * \brief Prepare the phases for a population
+	 * \details A phase starts with the first step at or after its start time
+	 * @param dt - time step, days
+	 * @param n_schools - number of schools
+	 * @param n_workplaces - number of workplaces
+	 */
+	void compile(const double dt, const int n_schools, const int n_workplaces);
+
+	/// First time step of a phase, after compile
+	int get_start_step(const int phase) const { return start_steps[phase]; }
+
+	/// Factors of each school in a phase, after compile
+	const std::vector<double>& get_school_factors(const int phase) const
+		{ return school_factors[phase]; }
+
+	/// Factors of each workplace in a phase, after compile
+	const std::vector<double>& get_workplace_factors(const int phase) const
+		{ return workplace_factors[phase]; }
+
+	/// Schools open in a phase, after compile
+	const PlaceActivation& get_open_schools(const int phase) const
+		{ return open_schools[phase]; }
+
+	/// Workplaces open in a phase, after compile
+	const PlaceActivation& get_open_workplaces(const int phase) const
+		{ return open_workplaces[phase]; }
+
+	/// Print the phases, one per line
+	void print(std::ostream& out) const;
+
+private:
+	std::vector<InterventionPhase> phases;
+	unsigned int seed = 2020;
+	// Compiled phases
+	std::vector<int> start_steps;
+	std::vector<std::vector<double>> school_factors;
+	std::vector<std::vector<double>> workplace_factors;
+	std::vector<PlaceActivation> open_schools;
+	std::vector<PlaceActivation> open_workplaces;
+
+	/// Remove the compiled phases
+	void clear_compiled();
+};
+
+#endif
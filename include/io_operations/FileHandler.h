@@ -1,6 +1,7 @@
 #ifndef FILEHANDLER_H
 #define FILEHANDLER_H
 
+#include "compressed_stream.h"
 #include "../common.h"
 #include <ios>
 
@@ -10,7 +11,10 @@
  * Creates and manages input and output file streams
  *
  * Opens and maintains a file stream, then closes it when
- * calling the destructor. 
+ * calling the destructor. Files ending with .gz (or .zst, if
+ * compiled with zstd support) are compressed and decompressed
+ * on the fly; compressed files can be either read or written
+ * but not both, see CompressedBuffer. 
  **************************************************************/
 
 class FileHandler
@@ -46,19 +50,22 @@ public:
 	/** 
 	 * \brief Returns a file stream  
 	 */
-	std::fstream& get_stream() { return file; }
+	std::iostream& get_stream() { return *stream; }
 
 	/** 
 	 * \brief Resets the input strem and returns a reset file stream 
 	 * \details https://stackoverflow.com/a/26227809/2763915 
 	 */
-	std::fstream& reset_input_stream() { file.seekg(std::ios_base::beg); return file; }
+	std::iostream& reset_input_stream() { stream->seekg(std::ios_base::beg); return *stream; }
 
 	/** 
 	 * \brief Clears stream for reuse 
 	 * \details https://stackoverflow.com/questions/5343173/returning-to-beginning-of-file-after-getline 
 	 */
-	std::fstream& clear_stream() { file.clear(); return file; }
+	std::iostream& clear_stream() { stream->clear(); return *stream; }
+
+	/// True if the file is compressed
+	bool is_compressed() const { return codec != Codec::none; }
 
 	//
 	// Destructor
@@ -70,6 +77,12 @@ private:
 	std::string fname;
 	std::ios_base::openmode mode;		
 	std::fstream file;
+	// Compressed files
+	Codec codec = Codec::none;
+	std::unique_ptr<CompressedBuffer> zbuf;
+	std::unique_ptr<std::iostream> zstream;
+	// Stream in use, file or zstream
+	std::iostream* stream = &file;
 	void open_file();
 };
 
@@ -100,7 +100,7 @@ template<typename T>
 std::vector<std::vector<T>> AbmIO::read_vector() const
 {
 	FileHandler file(fname);
-	std::fstream &in = file.get_stream();
+	std::iostream &in = file.get_stream();
 	std::string line;
    	T elem;
 	std::vector<std::vector<T>> output;
@@ -112,6 +112,9 @@ std::vector<std::vector<T>> AbmIO::read_vector() const
 			temp.push_back(elem);
 		output.push_back(temp);
 	}
+	// Broken stream, e.g. a truncated compressed file
+	if (in.bad())
+		throw std::runtime_error("Error reading file " + fname);
 	return output;
 }
 
@@ -123,7 +126,7 @@ template<typename T>
 void AbmIO::write_object(const T& object) const
 {
 	FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
-	std::fstream &fout = file.get_stream();
+	std::iostream &fout = file.get_stream();
 	
 	fout << object << '\n';
 }
@@ -132,7 +135,7 @@ template<typename T>
 void AbmIO::write_vector(const std::vector<T>& data) const
 {
 	FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
-	std::fstream &fout = file.get_stream();
+	std::iostream &fout = file.get_stream();
 
 	for (const auto& entry : data)
 		fout << entry << '\n';		
@@ -142,7 +145,7 @@ template<typename T>
 void AbmIO::write_vector(const std::vector<std::vector<T>>& data) const
 {
 	FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
-	std::fstream &out = file.get_stream();
+	std::iostream &out = file.get_stream();
 
 	size_t nrows = data.size();
 	for (int i = 0; i<nrows; i++){
@@ -0,0 +1,232 @@
+#ifndef AGENT_SNAPSHOTS_H
+#define AGENT_SNAPSHOTS_H
+
+#include "FileHandler.h"
+#include "../common.h"
+#include <cstdint>
+
+/***************************************************************
+ * Agent state snapshots
+ *
+ * Compact binary format for per-step agent states. Each step
+ * is stored either as a keyframe - one state byte per agent,
+ * ordered by agent ID - or as a delta - list of agents
+ * whose state changed since the previous step. Agent indices
+ * in a delta are stored as gaps from the previous changed
+ * agent, as variable-length integers, followed by the new
+ * state byte. The lower four bits of a state byte are the
+ * state code, the upper four are the treatment and testing
+ * flags.
+ *
+ * File layout:
+ * 	header | step records | index | footer
+ *
+ * 	header - magic "ABMSNAP1", uint32 number of agents,
+ * 				uint32 keyframe interval
+ * 	step record - uint8 type (0 keyframe, 1 delta),
+ * 				uint32 step, double time, payload
+ * 	index - uint32 number of steps, then per step uint32 step,
+ * 				double time, uint64 offset of the record, uint8 type
+ * 	footer - uint64 offset of the index, magic "ABMSIDX1"
+ *
+ * Data is written in the native byte order. Snapshots can be
+ * written to a compressed file, but need to be decompressed
+ * before reading since the reader seeks.
+ **************************************************************/
+
+/// Agent state codes stored in the snapshots
+enum class AgentStateCode : std::uint8_t {
+	susceptible = 0,
+	exposed = 1,
+	exposed_never_symptomatic = 2,
+	symptomatic_recovering = 3,
+	symptomatic_dying = 4,
+	recovered = 5,
+	dead = 6
+};
+
+/// Flags stored with the state code, any combination
+enum class AgentStateFlag : std::uint8_t {
+	hospitalized = 0x10,
+	ICU = 0x20,
+	home_isolated = 0x40,
+	tested_positive = 0x80
+};
+
+/// Bits of the state code in a state byte
+const std::uint8_t agent_state_code_mask = 0x0F;
+
+/***************************************************************
+ * class: AgentSnapshotWriter
+ *
+ * Writes per-step agent state snapshots
+ **************************************************************/
+
+class AgentSnapshotWriter
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	AgentSnapshotWriter() = delete;
+
+	/**
+	 * \brief Creates an AgentSnapshotWriter, truncates the file if it exists
+	 *
+	 * @param name - name of the output file
+	 * @param n_agents - total number of agents
+	 * @param key_interval - every key_interval-th saved step is a keyframe
+	 */
+	AgentSnapshotWriter(const std::string name, const int n_agents, const int key_interval = 50);
+
+	//
+	// Writing
+	//
+
+	/**
+	 * \brief Return the buffer for the states of the next step
+	 * \details Buffer has one entry per agent, index being agent ID - 1;
+	 * 		It is filled by the caller, then committed with write_step
+	 */
+	std::vector<std::uint8_t>& get_state_buffer() { return current; }
+
+	/**
+	 * \brief Save the states currently in the state buffer
+	 * @param time - simulation time of the snapshot
+	 */
+	void write_step(const double time);
+
+	/**
+	 * \brief Write the index and the footer
+	 * \details Called by the destructor if not called explicitly;
+	 * 		no more steps can be written after closing
+	 */
+	void close();
+
+	//
+	// Getters
+	//
+
+	/// Number of saved steps
+	int get_number_of_steps() const { return static_cast<int>(index.size()); }
+
+	//
+	// Destructor
+	//
+
+	~AgentSnapshotWriter();
+
+private:
+
+	// Index entry for a single step
+	struct IndexEntry {
+		std::uint32_t step = 0;
+		double time = 0.0;
+		std::uint64_t offset = 0;
+		std::uint8_t type = 0;
+	};
+
+	FileHandler file;
+	std::uint32_t n_agents = 0;
+	std::uint32_t key_interval = 50;
+	bool closed = false;
+
+	// Offset of the next record
+	std::uint64_t position = 0;
+	// States at this and previous step
+	std::vector<std::uint8_t> current;
+	std::vector<std::uint8_t> previous;
+	// Reusable record buffer
+	std::vector<char> record;
+	std::vector<IndexEntry> index;
+
+	void write_header();
+	// Append raw bytes to the record
+	template <typename T>
+	void append(const T& value);
+	// Append variable-length unsigned integer to the record
+	void append_varint(std::uint32_t value);
+};
+
+/***************************************************************
+ * class: AgentSnapshotReader
+ *
+ * Reads agent state snapshots, allows seeking to any step
+ **************************************************************/
+
+class AgentSnapshotReader
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	AgentSnapshotReader() = delete;
+
+	/**
+	 * \brief Opens the snapshot file and loads its index
+	 * \details Compressed files are not supported
+	 * @param name - name of the snapshot file
+	 */
+	AgentSnapshotReader(const std::string name);
+
+	//
+	// Reading
+	//
+
+	/**
+	 * \brief Reconstruct states of all agents at a saved step
+	 * \details Reads the closest preceeding keyframe and applies
+	 * 		the deltas up to and including the requested step
+	 * @param step - index of the saved step, starting with 0
+	 * @returns vector of state codes, index is agent ID - 1
+	 */
+	std::vector<std::uint8_t> read_step(const int step);
+
+	/**
+	 * \brief Agents that changed state at a saved step
+	 * \details For a keyframe all agents that differ from the
+	 * 		previous step are returned
+	 * @param step - index of the saved step, starting with 0
+	 * @returns vector of agent ID - new state code pairs
+	 */
+	std::vector<std::pair<int, std::uint8_t>> read_changes(const int step);
+
+	//
+	// Getters
+	//
+
+	/// Number of saved steps
+	int get_number_of_steps() const { return static_cast<int>(index.size()); }
+	/// Number of agents
+	int get_number_of_agents() const { return static_cast<int>(n_agents); }
+	/// Time of a saved step
+	double get_time(const int step) const { return index.at(step).time; }
+
+private:
+
+	// Index entry for a single step
+	struct IndexEntry {
+		std::uint32_t step = 0;
+		double time = 0.0;
+		std::uint64_t offset = 0;
+		std::uint8_t type = 0;
+	};
+
+	FileHandler file;
+	std::uint32_t n_agents = 0;
+	std::uint32_t key_interval = 0;
+	std::vector<IndexEntry> index;
+
+	void read_header_and_index();
+	// Apply a single record to states
+	void apply_record(const int step, std::vector<std::uint8_t>& states);
+	template <typename T>
+	T read_value();
+	std::uint32_t read_varint();
+};
+
+#endif
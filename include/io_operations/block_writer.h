@@ -0,0 +1,80 @@
+#ifndef BLOCK_WRITER_H
+#define BLOCK_WRITER_H
+
+#include "FileHandler.h"
+#include "../common.h"
+#include <cstdio>
+
+/***************************************************************
+ * class: BlockWriter
+ *
+ * Buffered text output for large, frequent saves
+ *
+ * Numbers are formatted directly into a reusable buffer which
+ * is written to the file in large blocks. Formatting matches
+ * the default std::ostream formatting, i.e. doubles are written
+ * with 6 significant digits, so files are identical to the ones
+ * written through AbmIO. Truncates the file if it exists.
+ **************************************************************/
+
+class BlockWriter
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	BlockWriter() = delete;
+
+	/**
+	 * \brief Creates a BlockWriter object
+	 * @param name - name of the file
+	 * @param block - size of the buffer, bytes
+	 */
+	BlockWriter(const std::string name, const std::size_t block = 1 << 20);
+
+	//
+	// Writing
+	//
+
+	/// Format and add an integer
+	BlockWriter& operator<< (const int value);
+	/// Format and add a double
+	BlockWriter& operator<< (const double value);
+	/// Format and add a double with a fixed number of decimals, as "%.*f"
+	BlockWriter& write_fixed(const double value, const int decimals = 6);
+	/// Add a single character
+	BlockWriter& operator<< (const char value)
+		{ reserve(1); buffer[used++] = value; return *this; }
+	/// Add a C-string
+	BlockWriter& operator<< (const char* value)
+		{ append(value, std::strlen(value)); return *this; }
+	/// Add a string
+	BlockWriter& operator<< (const std::string& value)
+		{ append(value.data(), value.size()); return *this; }
+
+	/// Write the buffer content to the file
+	void flush();
+
+	//
+	// Destructor
+	//
+
+	/// Writes what is left in the buffer
+	~BlockWriter();
+
+private:
+	FileHandler file;
+	std::vector<char> buffer;
+	// Number of used bytes in the buffer
+	std::size_t used = 0;
+
+	// Flush if less than n bytes left in the buffer
+	void reserve(const std::size_t n)
+		{ if (used + n > buffer.size()) flush(); }
+	// Copy len characters, flushing as the buffer fills
+	void append(const char* value, std::size_t len);
+};
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef COMPRESSED_STREAM_H
+#define COMPRESSED_STREAM_H
+
+#include "../common.h"
+#include <streambuf>
+#include <fstream>
+#include <future>
+#include <deque>
+
+/***************************************************************
+ * Compressed file streams
+ *
+ * Stream buffer that compresses data on writing and decompresses
+ * it on reading, so that any std::iostream can work directly
+ * with compressed files.
+ *
+ * Output is split into blocks that are compressed independently
+ * on worker threads and written in order as separate gzip members
+ * or zstd frames. The result is a regular compressed file that
+ * the standard command line tools can decompress. Input accepts
+ * any number of concatenated members or frames.
+ *
+ * The codec is selected from the file extension:
+ * 	.gz - gzip, through zlib
+ * 	.zst - zstd, only when compiled with ABM_WITH_ZSTD
+ **************************************************************/
+
+/// Supported compression formats
+enum class Codec { none, gzip, zstd };
+
+/***************************************************************
+ * class: CompressedBuffer
+ *
+ * Stream buffer for reading or writing a compressed file
+ **************************************************************/
+
+class CompressedBuffer : public std::streambuf
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	CompressedBuffer() = delete;
+	CompressedBuffer(const CompressedBuffer&) = delete;
+	CompressedBuffer& operator=(const CompressedBuffer&) = delete;
+
+	/**
+	 * \brief Creates a CompressedBuffer object and opens the file
+	 * \details A compressed file can only be read or written, not both.
+	 * 		It is written if the open mode has out but not in, or has
+	 * 		trunc or app; otherwise it is read. Appending adds new
+	 * 		members or frames at the end of the file.
+	 * @param name - name of the file
+	 * @param cd - compression format
+	 * @param mode - open mode, https://en.cppreference.com/w/cpp/io/ios_base/openmode
+	 * @param block - size of the uncompressed blocks, bytes
+	 * @param n_threads - maximum number of blocks compressed at the
+	 * 		same time, 0 to use the number of hardware threads
+	 */
+	CompressedBuffer(const std::string& name, const Codec cd, const std::ios_base::openmode mode,
+						const std::size_t block = 1 << 20, const int n_threads = 0);
+
+	/**
+	 * \brief Codec corresponding to the extension of a file name
+	 * \details Throws if the format is recognized but not supported
+	 * 		by this build
+	 * @param name - name of the file
+	 */
+	static Codec codec_from_name(const std::string& name);
+
+	//
+	// Getters
+	//
+
+	/// True if the file was successfully opened
+	bool is_open() const { return raw.is_open(); }
+	/// True if the file is being written
+	bool is_output() const { return writing; }
+
+	//
+	// Closing
+	//
+
+	/**
+	 * \brief Compresses and writes remaining data, then closes the file
+	 * @returns false if there were errors while compressing or writing
+	 */
+	bool close();
+
+	//
+	// Destructor
+	//
+
+	/// Closes the file if still open
+	~CompressedBuffer();
+
+protected:
+
+	// Output - compress a full block and start a new one
+	int_type overflow(int_type ch) override;
+	// Output - write the blocks that are already compressed, data
+	// in the current block stays in memory until it is full
+	int sync() override;
+	// Input - decompress the next portion of the file
+	int_type underflow() override;
+	// Supports telling the position and rewinding an input file
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+						std::ios_base::openmode which) override;
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+private:
+	// Codec state for reading, defined with the codec library
+	struct Decoder;
+
+	Codec codec = Codec::none;
+	bool writing = false;
+	std::size_t block_size = 1 << 20;
+	std::size_t max_in_flight = 1;
+	// Compressed file
+	std::filebuf raw;
+
+	// Output - block being filled and blocks being compressed
+	std::vector<char> block;
+	std::deque<std::future<std::vector<char>>> in_flight;
+	// Uncompressed bytes already handed over for compression
+	std::streamoff bytes_out = 0;
+	bool any_output = false;
+	bool write_error = false;
+
+	// Input - compressed and decompressed data
+	std::unique_ptr<Decoder> decoder;
+	std::vector<char> compressed;
+	std::size_t cmp_pos = 0;
+	std::size_t cmp_end = 0;
+	std::vector<char> decompressed;
+	// Uncompressed bytes read from the file so far
+	std::streamoff bytes_in = 0;
+
+	// Hand over the current block for compression
+	void submit_block();
+	// Write the oldest compressed block to the file
+	void write_front();
+};
+
+#endif
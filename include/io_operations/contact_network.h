@@ -0,0 +1,146 @@
+#ifndef CONTACT_NETWORK_H
+#define CONTACT_NETWORK_H
+
+#include "FileHandler.h"
+#include "../common.h"
+#include "../places/household.h"
+#include "../places/school.h"
+#include "../places/workplace.h"
+#include <cstdint>
+
+/***************************************************************
+ * Contact network export
+ *
+ * Binary CSR (compressed sparse row) form of the graph of
+ * agents and the places they are registered in. Two graphs
+ * can be saved:
+ *
+ * 	bipartite - one row per agent, columns are the places
+ * 		of that agent, edge weight is the weight of the
+ * 		place type
+ * 	projection - one row per agent, columns are all other
+ * 		agents sharing at least one place, edge weight is
+ * 		the sum of the weights of the shared places
+ *
+ * Places are numbered from 0 as households, then schools,
+ * then workplaces, each in the order of their IDs. Agent
+ * with ID i is row and column i-1.
+ *
+ * File layout:
+ * 	header | row_start | columns | weights
+ *
+ * 	header - magic "ABMCSR01", uint8 graph type (0 bipartite,
+ * 				1 projection), uint32 number of rows,
+ * 				uint32 number of households, schools, and
+ * 				workplaces, uint64 number of edges
+ * 	row_start - uint64 per row plus one, edges of row r are
+ * 				row_start[r] to row_start[r+1]-1
+ * 	columns - uint32 per edge, increasing within a row
+ * 	weights - float per edge
+ *
+ * Data is written in the native byte order.
+ **************************************************************/
+
+/// Weights of contacts in each type of place
+struct ContactWeights {
+	float household = 1.0f;
+	float school = 1.0f;
+	float workplace = 1.0f;
+
+	/// Return weight of a place type
+	float get(const PlaceType type) const;
+};
+
+/***************************************************************
+ * class: ContactNetwork
+ *
+ * Memberships of places indexed for export of the contact
+ * network
+ *
+ * Memberships are the agents registered in each place,
+ * normally right after the population was created. Agents
+ * removed from places at that time are not included.
+ **************************************************************/
+
+class ContactNetwork
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	ContactNetwork() = delete;
+
+	/**
+	 * \brief Index memberships of all places
+	 *
+	 * @param n_agents - total number of agents
+	 * @param households - vector of all households
+	 * @param schools - vector of all schools
+	 * @param workplaces - vector of all workplaces
+	 */
+	ContactNetwork(const int n_agents, const std::vector<Household>& households,
+					const std::vector<School>& schools, const std::vector<Workplace>& workplaces);
+
+	//
+	// Output
+	//
+
+	/**
+	 * \brief Save the agent-place graph
+	 * @param fname - name of the output file
+	 * @param weights - weights of each place type
+	 */
+	void write_bipartite(const std::string& fname,
+							const ContactWeights& weights = ContactWeights()) const;
+
+	/**
+	 * \brief Save the agent-agent graph
+	 * \details The graph is not stored, rows are computed one
+	 * 		at a time and written in blocks, so memory does not
+	 * 		grow with the number of edges; rows are computed in
+	 * 		two passes, for row sizes and for the edges, and
+	 * 		the weights are kept in a temporary file next to
+	 * 		the output until all the columns are written
+	 * @param fname - name of the output file
+	 * @param weights - weights of each place type
+	 * @param block_size - number of edges buffered before writing
+	 */
+	void write_projection(const std::string& fname,
+							const ContactWeights& weights = ContactWeights(),
+							const std::size_t block_size = 1 << 20) const;
+
+	//
+	// Getters
+	//
+
+	/// Number of agents
+	int get_number_of_agents() const { return n_agents; }
+	/// Number of places of all types
+	int get_number_of_places() const { return static_cast<int>(place_types.size()); }
+	/// Number of agent-place memberships
+	std::size_t get_number_of_memberships() const { return agent_places.size(); }
+
+private:
+	int n_agents = 0;
+	// Number of places of each type
+	std::uint32_t n_households = 0, n_schools = 0, n_workplaces = 0;
+	// Type of each place
+	std::vector<PlaceType> place_types;
+	// Agent indices of each place, members of place p are
+	// place_agents[place_start[p]] to place_agents[place_start[p+1]-1]
+	std::vector<std::uint64_t> place_start;
+	std::vector<std::uint32_t> place_agents;
+	// Places of each agent, same structure
+	std::vector<std::uint64_t> agent_start;
+	std::vector<std::uint32_t> agent_places;
+
+	// Add members of a place, each agent once
+	void add_place(const Place& place, const PlaceType type);
+	// Save the header and row starts
+	void write_header(std::ostream& out, const std::uint8_t graph_type,
+						const std::vector<std::uint64_t>& row_start) const;
+};
+
+#endif
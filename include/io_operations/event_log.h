@@ -0,0 +1,169 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "FileHandler.h"
+#include "../common.h"
+#include "../places/place.h"
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+/***************************************************************
+ * Transition event log
+ *
+ * Binary log of agent state transitions. Records have a fixed
+ * size and are appended to per-thread buffers; full buffers are
+ * handed to a background thread that writes them to the file.
+ *
+ * File layout:
+ * 	header - magic "ABMEVNT1", double time step, uint32 record size
+ * 	records - TransitionEvent structs in native byte order
+ *
+ * Records from different threads are not ordered with respect
+ * to each other; sort by step if order matters.
+ **************************************************************/
+
+/// Types of logged transitions
+enum class TransitionType : std::uint8_t {
+	// Susceptible to exposed, with place of infection
+	infected = 0,
+	// Exposed to symptomatic
+	symptomatic = 1,
+	// Exposed recovering without ever developing symptoms
+	recovered_exposed = 2,
+	// Symptomatic to recovered
+	recovered = 3,
+	// Symptomatic to dead
+	died = 4
+};
+
+/// Single fixed-size event record
+struct TransitionEvent {
+	// Time step of the transition
+	std::uint32_t step = 0;
+	// Agent ID (starts with 1)
+	std::int32_t agent_ID = 0;
+	// TransitionType
+	std::uint8_t type = 0;
+	// PlaceType where the agent got infected, none for other transitions
+	std::uint8_t place_type = 0;
+	std::uint16_t reserved = 0;
+	// ID of the place of infection, 0 for other transitions
+	std::int32_t place_ID = 0;
+};
+
+/***************************************************************
+ * class: EventLog
+ *
+ * Collects transition events in per-thread buffers and writes
+ * them to a file asynchronously
+ **************************************************************/
+
+class EventLog
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	EventLog() = delete;
+	EventLog(const EventLog&) = delete;
+	EventLog& operator=(const EventLog&) = delete;
+
+	/**
+	 * \brief Creates an EventLog object, truncates the file if it exists
+	 *
+	 * @param name - name of the output file
+	 * @param del_t - simulation time step, for conversion of time to steps
+	 * @param n_slots - number of per-thread buffers; each thread
+	 * 		records to its own slot
+	 * @param buffer_events - number of events in one buffer
+	 */
+	EventLog(const std::string name, const double del_t, const int n_slots = 1,
+				const int buffer_events = 1 << 15);
+
+	//
+	// Recording
+	//
+
+	/**
+	 * \brief Add an event to the buffer of a given slot
+	 * \details Only one thread can record to a slot at a time
+	 * @param event - event to store
+	 * @param slot - index of the per-thread buffer
+	 */
+	void record(const TransitionEvent& event, const int slot = 0)
+	{
+		std::vector<TransitionEvent>& buffer = buffers[slot];
+		buffer.push_back(event);
+		if (buffer.size() == buffer_size)
+			submit(slot);
+	}
+
+	/**
+	 * \brief Create and store an event
+	 * @param time - simulation time of the transition
+	 * @param agent_ID - ID of the transitioning agent
+	 * @param type - type of the transition
+	 * @param place_type - type of place of infection, if any
+	 * @param place_ID - ID of the place of infection, if any
+	 * @param slot - index of the per-thread buffer
+	 */
+	void record(const double time, const int agent_ID, const TransitionType type,
+					const PlaceType place_type = PlaceType::none, const int place_ID = 0,
+					const int slot = 0);
+
+	/**
+	 * \brief Write all the buffered events and wait until done
+	 * \details No other thread can be recording during the flush
+	 */
+	void flush();
+
+	//
+	// Reading
+	//
+
+	/**
+	 * \brief Load all the events from a log file
+	 * @param name - name of the file written by an EventLog
+	 */
+	static std::vector<TransitionEvent> read_events(const std::string name);
+
+	//
+	// Destructor
+	//
+
+	/// Flushes and stops the writing thread
+	~EventLog();
+
+private:
+
+	FileHandler file;
+	double dt = 1.0;
+	std::size_t buffer_size = 1 << 15;
+
+	// Per-slot buffers that are being filled
+	std::vector<std::vector<TransitionEvent>> buffers;
+	// Full buffers waiting to be written and
+	// written buffers available for reuse
+	std::deque<std::vector<TransitionEvent>> pending;
+	std::vector<std::vector<TransitionEvent>> spare;
+	// Number of buffers handed over and not yet written
+	int in_flight = 0;
+	bool stop = false;
+
+	std::mutex mtx;
+	std::condition_variable work_ready;
+	std::condition_variable work_done;
+	std::thread writer;
+
+	// Hand over buffer from a slot, replace with a spare one
+	void submit(const int slot);
+	// Writing thread loop
+	void write_loop();
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef INPUT_VALIDATION_H
+#define INPUT_VALIDATION_H
+
+#include "../common.h"
+
+/***************************************************************
+ * class: InputValidator
+ *
+ * Checks of population input done while parsing it
+ *
+ * Loaders convert entries of each line through this class,
+ * which records every malformed or inconsistent entry with
+ * the file name and line number instead of stopping at the
+ * first one. When the file is done, throw_if_invalid() reports
+ * all the errors at once in a std::invalid_argument.
+ **************************************************************/
+
+class InputValidator
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	InputValidator() = delete;
+
+	/**
+	 * \brief Creates an InputValidator object
+	 * @param name - name of the file being checked, for messages
+	 * @param max_rep - maximum number of errors listed in the
+	 * 		exception message, the rest is only counted
+	 */
+	InputValidator(const std::string name, const std::size_t max_rep = 50) :
+		fname(name), max_reported(max_rep) { }
+
+	//
+	// Checks
+	//
+
+	/**
+	 * \brief Start checking a line
+	 * \details Lines are numbered from 1
+	 * @param line_number - line number in the file
+	 * @param entries - parsed entries of that line
+	 * @param n_cols - minimum number of entries
+	 * @returns false if the line has too few entries,
+	 * 		the remaining checks of the line should be skipped
+	 */
+	bool next_line(const int line_number, const std::vector<std::string>& entries,
+						const std::size_t n_cols);
+
+	/**
+	 * \brief Convert an entry to an integer
+	 * @param entries - parsed entries of the current line
+	 * @param col - column of the entry
+	 * @param what - name of the property, for messages
+	 * @returns the value, 0 if the entry is not an integer
+	 */
+	int get_int(const std::vector<std::string>& entries, const std::size_t col,
+					const std::string& what);
+
+	/// Convert an entry to a double, 0.0 if the entry is not a number
+	double get_double(const std::vector<std::string>& entries, const std::size_t col,
+					const std::string& what);
+
+	/// Convert an entry that has to be 0 or 1
+	bool get_flag(const std::vector<std::string>& entries, const std::size_t col,
+					const std::string& what);
+
+	/**
+	 * \brief Check if an ID is in the range [1, n_max]
+	 * @param ID - value to check
+	 * @param n_max - number of available objects
+	 * @param what - name of the ID, for messages
+	 */
+	void check_ID(const int ID, const int n_max, const std::string& what);
+
+	/// Record an error on the current line
+	void add_error(const std::string& msg);
+
+	//
+	// Results
+	//
+
+	/// Number of errors found so far
+	std::size_t get_number_of_errors() const { return n_errors; }
+
+	/// Throws std::invalid_argument listing all the errors, if any
+	void throw_if_invalid() const;
+
+private:
+	std::string fname;
+	std::size_t max_reported = 50;
+	// Line currently checked
+	int line = 0;
+	std::size_t n_errors = 0;
+	std::vector<std::string> messages;
+};
+
+#endif
@@ -27,6 +27,16 @@ public:
 	 * @param infile - input file with parameters
 	 */
 	std::map<std::string, double> load_parameter_map(const std::string infile);
+
+	/**
+	 * \brief Read lists of values of parameters from file, store as a map
+	 * \details Same format as for load_parameter_map but the line after
+	 * 		the name can have any number of values separated by spaces;
+	 * 		Empty lines are skipped
+	 *
+	 * @param infile - input file with parameters
+	 */
+	std::map<std::string, std::vector<double>> load_parameter_lists(const std::string infile);
 	
 	/** 
 	 * \brief Read age-dependent distributions as map, store the as a map
@@ -0,0 +1,159 @@
+#ifndef POPULATION_GENERATOR_H
+#define POPULATION_GENERATOR_H
+
+#include "../common.h"
+
+/***************************************************************
+ * struct: PopulationSettings
+ *
+ * Size and composition of a synthetic population
+ *
+ **************************************************************/
+
+struct PopulationSettings
+{
+	int n_agents = 0;
+	int n_households = 0;
+	int n_schools = 0;
+	int n_workplaces = 0;
+
+	// Spatial limits of all places
+	double x_min = 0.0, x_max = 1.0;
+	double y_min = 0.0, y_max = 1.0;
+
+	// Age distribution, normal and truncated to [0, max_age]
+	double age_mean = 40.0;
+	double age_std = 18.0;
+	int max_age = 100;
+
+	// Probability that an agent of age 2 to 22 goes to school
+	double student_probability = 0.9;
+	// Probability that an agent of age 18 to 65 works
+	double employment_probability = 0.7;
+	// Probability that an employed agent works at a school
+	double school_employee_probability = 0.05;
+	// Probability that an agent is initially infected
+	double infected_probability = 0.0;
+
+	/**
+	 * \brief Settings with place numbers scaled to the number of agents
+	 * \details About 2.6 agents per household, 1000 per school,
+	 * 		and 20 per workplace
+	 * @param n - number of agents
+	 */
+	static PopulationSettings scaled(const int n);
+};
+
+/***************************************************************
+ * class: PopulationGenerator
+ *
+ * Random synthetic population in the model input format
+ *
+ * Creates households, schools, workplaces, and agents with
+ * random locations and random membership, for testing and
+ * scaling studies where a real population is not needed.
+ * Agents live at their household location, students attend
+ * a school of the type that corresponds to their age, if
+ * there is one.
+ *
+ * Places and agents are generated in fixed size chunks, each
+ * with its own generator seeded from the base seed and the
+ * chunk number, so the output depends only on the settings
+ * and the seed, and not on the number of threads. Agents are
+ * generated and formatted by all threads one batch of chunks
+ * at a time, so memory use doesn't grow with the population.
+ * Files are written through FileHandler, .gz names are
+ * compressed.
+ *
+ * Output files are in the format read by ABM::create_households,
+ * create_schools, create_workplaces, and create_agents.
+ **************************************************************/
+
+class PopulationGenerator
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	PopulationGenerator() = delete;
+
+	/**
+	 * \brief Creates a generator and generates all the places
+	 * \details Throws std::invalid_argument if the settings are
+	 * 		inconsistent, e.g. there are agents but no households
+	 * @param population - settings of the population
+	 * @param seed - base seed of all random numbers
+	 * @param n_thr - number of threads, 0 for the number of
+	 * 		hardware threads
+	 */
+	PopulationGenerator(const PopulationSettings& population, const unsigned int seed,
+							const unsigned int n_thr = 0);
+
+	//
+	// Output
+	//
+
+	/// Households as ID, x, y
+	void write_households(const std::string& fname) const;
+	/// Schools as ID, x, y, and school type
+	void write_schools(const std::string& fname) const;
+	/// Workplaces as ID, x, y
+	void write_workplaces(const std::string& fname) const;
+
+	/**
+	 * \brief Generate agents and write them to a file
+	 * \details One agent per line - student and works flags, age,
+	 * 		x, y, household ID, school ID, school employee flag,
+	 * 		work ID, and infection status; Same seed always gives
+	 * 		the same agents
+	 * @param fname - output file name
+	 */
+	void write_agents(const std::string& fname) const;
+
+	//
+	// Getters
+	//
+
+	/// Settings of the population
+	const PopulationSettings& get_settings() const { return settings; }
+	/// Number of threads used for generation
+	unsigned int get_number_of_threads() const { return n_threads; }
+
+private:
+	PopulationSettings settings;
+	unsigned int base_seed = 0;
+	unsigned int n_threads = 1;
+
+	// Coordinates of places, formatted once since
+	// every agent repeats the household ones
+	std::vector<std::string> household_locations;
+	std::vector<std::string> school_locations;
+	std::vector<std::string> workplace_locations;
+	// Type of each school and IDs of schools of each type
+	std::vector<int> school_types;
+	std::vector<std::vector<int>> schools_by_type;
+
+	/// Random locations of n places, formatted as "x y"
+	std::vector<std::string> generate_locations(const int n, const unsigned int stream) const;
+
+	/// Write places as ID and location, with optional extra column
+	void write_places(const std::string& fname, const std::vector<std::string>& locations,
+						const std::vector<std::string>& extra = {}) const;
+
+	// One generated agent, written in the create_agents order
+	struct GeneratedAgent {
+		int age = 0;
+		int house_ID = 0;
+		int school_ID = 0;
+		int work_ID = 0;
+		bool works_at_school = false;
+		bool infected = false;
+	};
+
+	/// Agents of one chunk, replaces the content of out
+	void generate_agent_chunk(const int chunk, std::vector<GeneratedAgent>& out) const;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef POPULATION_TILING_H
+#define POPULATION_TILING_H
+
+#include "../common.h"
+
+/***************************************************************
+ * class: PopulationTiling
+ *
+ * Larger population made of copies of a real one
+ *
+ * Reads households, schools, workplaces, and agents in the
+ * model input format and writes them k times as k tiles.
+ * Each tile has place IDs offset by the number of places
+ * before it and coordinates shifted so that tiles are next
+ * to each other on a square grid without overlapping. Tile 0
+ * is the original population.
+ *
+ * Optionally a fraction of workers, other than school
+ * employees, works at the same workplace of a randomly
+ * chosen other tile. Commuters are drawn with a generator
+ * seeded per tile, so the same seed gives the same files.
+ *
+ * Files are read and written through FileHandler, .gz names
+ * are compressed.
+ **************************************************************/
+
+class PopulationTiling
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	PopulationTiling() = delete;
+
+	/**
+	 * \brief Reads the population to replicate
+	 * \details Throws std::invalid_argument if a file has lines
+	 * 		with too few entries or entries that are not numbers
+	 * @param hfile - households file
+	 * @param sfile - schools file
+	 * @param wfile - workplaces file
+	 * @param afile - agents file
+	 */
+	PopulationTiling(const std::string& hfile, const std::string& sfile,
+						const std::string& wfile, const std::string& afile);
+
+	//
+	// Output
+	//
+
+	/**
+	 * \brief Write n_tiles copies of the population
+	 * @param hfile - output households file
+	 * @param sfile - output schools file
+	 * @param wfile - output workplaces file
+	 * @param afile - output agents file
+	 * @param n_tiles - number of copies, at least 1
+	 * @param commuter_fraction - probability that a worker commutes
+	 * 		to another tile, ignored for a single tile
+	 * @param seed - seed of the choice of commuters
+	 */
+	void write(const std::string& hfile, const std::string& sfile,
+				const std::string& wfile, const std::string& afile,
+				const int n_tiles, const double commuter_fraction = 0.0,
+				const unsigned int seed = 0) const;
+
+	//
+	// Getters
+	//
+
+	/// Number of agents in one tile
+	int get_number_of_agents() const { return static_cast<int>(agents.size()); }
+	/// Number of households in one tile
+	int get_number_of_households() const { return static_cast<int>(households.size()); }
+	/// Number of schools in one tile
+	int get_number_of_schools() const { return static_cast<int>(schools.size()); }
+	/// Number of workplaces in one tile
+	int get_number_of_workplaces() const { return static_cast<int>(workplaces.size()); }
+
+	/**
+	 * \brief Shift of coordinates of a tile
+	 * @param tile - tile number, starting with 0
+	 * @param n_tiles - total number of tiles
+	 * @returns x and y shift
+	 */
+	std::pair<double, double> get_tile_shift(const int tile, const int n_tiles) const;
+
+private:
+	// Location and the remaining entries of a place
+	struct TiledPlace {
+		double x = 0.0, y = 0.0;
+		std::string rest;
+	};
+	// Agent entries
+	struct TiledAgent {
+		bool student = false, works = false, works_at_school = false, infected = false;
+		int age = 0, house_ID = 0, school_ID = 0, work_ID = 0;
+		double x = 0.0, y = 0.0;
+	};
+
+	std::vector<TiledPlace> households;
+	std::vector<TiledPlace> schools;
+	std::vector<TiledPlace> workplaces;
+	std::vector<TiledAgent> agents;
+	// Size of a tile, bounding box of all places with a margin
+	double width = 0.0, height = 0.0;
+
+	/// Read places with ID, x, y, and possibly more entries
+	std::vector<TiledPlace> read_places(const std::string& fname);
+
+	/// Write places of all tiles
+	void write_places(const std::string& fname, const std::vector<TiledPlace>& places,
+						const int n_tiles) const;
+};
+
+#endif
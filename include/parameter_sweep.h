@@ -0,0 +1,128 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "ensemble.h"
+
+/// Values of infection parameters changed for a single run, by name
+typedef std::map<std::string, double> ParameterSet;
+
+/*****************************************************
+ * class: ParameterSweep
+ *
+ * Runs a model for many sets of infection parameters
+ * in one process
+ *
+ * The population is loaded once with the base parameter
+ * file. Each run starts from a copy of it with some of
+ * the infection parameters replaced in memory, see
+ * ABM::set_infection_parameters; only the coefficients
+ * of places that depend on the replaced parameters are
+ * recomputed. Runs, i.e. all replicates of all parameter
+ * sets, are distributed over threads as in Ensemble and
+ * their results are collected in one output file.
+ *
+ * Parameter sets can be created as a grid, a list, or
+ * a Latin hypercube sample. Specification for all three
+ * can be read from a file in the format of the infection
+ * parameters file, with more values in a line, see
+ * LoadParameters::load_parameter_lists.
+ *
+ ******************************************************/
+
+class ParameterSweep{
+public:
+
+	//
+	// Constructors
+	//
+
+	ParameterSweep() = delete;
+
+	/**
+	 * \brief Creates a ParameterSweep from a fully created model
+	 * \details Model should have no infected agents, infection
+	 * 		is seeded in each run after the parameters change
+	 * @param population - model with places and agents created
+	 * @param n_thr - number of threads, 0 for the number of
+	 * 		hardware threads
+	 */
+	ParameterSweep(const ABM& population, const unsigned int n_thr = 0) :
+		ensemble(population, n_thr) { }
+
+	//
+	// Parameter sets
+	//
+
+	/**
+	 * \brief All combinations of values of each parameter
+	 * @param values - parameter names and their values
+	 * @returns parameter sets, last parameter in the map changes fastest
+	 */
+	static std::vector<ParameterSet> grid(const std::map<std::string, std::vector<double>>& values);
+
+	/**
+	 * \brief Parameter sets made of i-th value of every parameter
+	 * \details All parameters need to have the same number of values
+	 * @param values - parameter names and their values
+	 */
+	static std::vector<ParameterSet> list(const std::map<std::string, std::vector<double>>& values);
+
+	/**
+	 * \brief Latin hypercube sample of parameter ranges
+	 * \details Range of each parameter is divided into n_sets equal
+	 * 		intervals and every interval is sampled exactly once
+	 * @param ranges - parameter names with minimum and maximum value
+	 * @param n_sets - number of parameter sets
+	 * @param seed - seed of the sampling
+	 */
+	static std::vector<ParameterSet> latin_hypercube(const std::map<std::string, std::vector<double>>& ranges,
+								const int n_sets, const unsigned int seed);
+
+	//
+	// Running
+	//
+
+	/**
+	 * \brief Run replicates for every parameter set
+	 * \details Parameter names are checked before any runs start
+	 * @param sets - parameter sets to run
+	 * @param n_replicates - number of replicates of each set
+	 * @param replicate - function that simulates one replicate, called
+	 * 		with model copy with parameters already changed, index of the
+	 * 		parameter set, and replicate number; returns results of the run
+	 * @param base_seed - seed from which the seeds of all runs are derived
+	 * @returns results of all runs, replicates of a parameter set are next
+	 * 		to each other
+	 */
+	std::vector<std::vector<double>> run(const std::vector<ParameterSet>& sets, const int n_replicates,
+						const std::function<std::vector<double>(ABM&, const int, const int)>& replicate,
+						const unsigned int base_seed = 0) const;
+
+	/**
+	 * \brief Save results of all runs in one file
+	 * \details First line is a // comment with column names, then one line
+	 * 		per run - parameter set index, replicate number, values of the
+	 * 		changed parameters, and results; Delimiter is a space
+	 * @param fname - output file name
+	 * @param sets - parameter sets in the order they were run
+	 * @param n_replicates - number of replicates of each set
+	 * @param results - results as returned by run
+	 * @param result_names - names of result columns, for the first line
+	 */
+	static void save_results(const std::string& fname, const std::vector<ParameterSet>& sets,
+						const int n_replicates, const std::vector<std::vector<double>>& results,
+						const std::vector<std::string>& result_names = {});
+
+	//
+	// Getters
+	//
+
+	/// Number of threads used for running
+	unsigned int get_number_of_threads() const { return ensemble.get_number_of_threads(); }
+
+private:
+	// Runs with the shared population
+	Ensemble ensemble;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include "common.h"
+#include <array>
+#include <cstdint>
+
+/***************************************************************
+ * Hardware events counted for each timed phase
+ **************************************************************/
+
+enum class PerfEvent : int {
+	cycles = 0,
+	instructions,
+	llc_misses,
+	branch_misses,
+	// Number of events, not an event
+	n_events
+};
+
+/// Counts of all hardware events, -1 if an event is not available
+struct CounterValues {
+	static const std::size_t n_events = static_cast<std::size_t>(PerfEvent::n_events);
+	std::array<std::int64_t, n_events> values = {{-1, -1, -1, -1}};
+
+	std::int64_t& operator[](const PerfEvent event)
+		{ return values[static_cast<std::size_t>(event)]; }
+	std::int64_t operator[](const PerfEvent event) const
+		{ return values[static_cast<std::size_t>(event)]; }
+};
+
+/***************************************************************
+ * class: PerfCounters
+ *
+ * Hardware performance counters of the calling thread
+ *
+ * Uses perf_event_open on Linux to count cycles, retired
+ * instructions, last level cache misses, and branch misses.
+ * Counting is off until enabled. Once enabled, every
+ * ScopedTimer reads the counters of its thread at its start
+ * and end and adds the difference to its phase in PerfStats.
+ * Each thread opens its own counters the first time it reads
+ * them.
+ *
+ * Counters are often unavailable - in containers and virtual
+ * machines, with a restrictive perf_event_paranoid setting,
+ * or on other systems. Then enable() returns false and phases
+ * are timed as before. Single events that the hardware can't
+ * count are reported as -1.
+ **************************************************************/
+
+class PerfCounters
+{
+public:
+
+	PerfCounters() = delete;
+
+	/**
+	 * \brief Start counting in all timed scopes
+	 * \details Opens the counters of the calling thread to check if
+	 * 		they work
+	 * @return True if at least the cycle counter is available,
+	 * 		counting stays off otherwise
+	 */
+	static bool enable();
+
+	/// Stop counting, counters that are open stay open
+	static void disable();
+
+	/// True if counters are read in timed scopes
+	static bool is_enabled();
+
+	/// Why the counters could not be opened, empty if they could
+	static std::string get_error();
+
+	/**
+	 * \brief Current counts of the calling thread
+	 * @param counts - values since the counters of this thread
+	 * 		were opened, -1 for unavailable events
+	 * @return False if this thread has no working counters
+	 */
+	static bool read(CounterValues& counts);
+
+	/// Name of an event without spaces, for output
+	static const char* event_name(const PerfEvent event);
+};
+
+#endif
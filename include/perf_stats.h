@@ -0,0 +1,204 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include "common.h"
+#include "tracer.h"
+#include "perf_counters.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/***************************************************************
+ * Phases of a simulation with separately measured time
+ **************************************************************/
+
+enum class PerfPhase : int {
+	// Loading
+	read_input = 0,
+	register_agents,
+	// One call of transmit_infection and its parts
+	transmission,
+	agent_contributions,
+	place_contributions,
+	state_transitions,
+	reset_sums,
+	// Saving of the model state
+	output,
+	// Number of phases, not a phase
+	n_phases
+};
+
+/***************************************************************
+ * class: PerfStats
+ *
+ * Accumulated wall time of simulation phases
+ *
+ * Each phase has the total time and the number of times it
+ * was measured. Times are collected by ScopedTimer objects,
+ * created through the ABM_PERF_SCOPE macro, which does
+ * nothing unless the code is compiled with ABM_WITH_PERF_STATS.
+ * Without it the statistics stay empty and the timed code
+ * has no overhead.
+ *
+ * If PerfCounters are enabled, each phase also accumulates
+ * hardware event counts. With history recording on, every
+ * measurement is kept separately along with its time step.
+ **************************************************************/
+
+/// One measurement of a phase
+struct PhaseSample {
+	// Time step, the number of transmit_infection calls
+	// completed before the measurement started
+	std::int64_t step = 0;
+	PerfPhase phase = PerfPhase::n_phases;
+	std::int64_t ns = 0;
+	// Hardware event counts, -1 if not counted
+	CounterValues counters;
+};
+
+class PerfStats
+{
+public:
+
+	/// True if timers are compiled in
+#ifdef ABM_WITH_PERF_STATS
+	static constexpr bool enabled = true;
+#else
+	static constexpr bool enabled = false;
+#endif
+
+	/// Add a measured duration of a phase, nanoseconds
+	void add(const PerfPhase phase, const std::int64_t ns)
+		{ add(phase, ns, CounterValues()); }
+
+	/**
+	 * \brief Add a measured duration and hardware event counts of a phase
+	 * @param phase - measured phase
+	 * @param ns - duration in nanoseconds
+	 * @param events - counts of hardware events, -1 if not counted
+	 */
+	void add(const PerfPhase phase, const std::int64_t ns, const CounterValues& events);
+
+	/// Set all times and counts to 0, remove the history
+	void reset();
+
+	/// Keep every measurement, off by default
+	void record_history(const bool keep) { keep_history = keep; }
+
+	/// Total time of a phase in milliseconds
+	double get_total_ms(const PerfPhase phase) const
+		{ return total_ns[index(phase)]*1.0e-6; }
+
+	/// Number of measurements of a phase
+	std::int64_t get_count(const PerfPhase phase) const
+		{ return counts[index(phase)]; }
+
+	/// Total hardware event counts of a phase, -1 if never counted
+	const CounterValues& get_counters(const PerfPhase phase) const
+		{ return total_events[index(phase)]; }
+
+	/// All measurements since the last reset, if history is recorded
+	const std::vector<PhaseSample>& get_history() const { return history; }
+
+	/// Name of a phase, for output
+	static std::string phase_name(const PerfPhase phase);
+
+	/// Short name of a phase without spaces, for traces
+	static const char* phase_label(const PerfPhase phase);
+
+	/**
+	 * \brief Print a table of total and mean time of each phase
+	 * \details Phases that were never measured are skipped. Hardware
+	 * 		event columns are added if any phase has counts.
+	 */
+	void print(std::ostream& out) const;
+
+	/**
+	 * \brief Print the recorded history, one measurement per line
+	 * \details Columns are step, phase, time in ns, and the
+	 * 		hardware events, -1 for events that were not counted
+	 */
+	void print_history(std::ostream& out) const;
+
+private:
+	static const std::size_t n_phases = static_cast<std::size_t>(PerfPhase::n_phases);
+	std::array<std::int64_t, n_phases> total_ns = {};
+	std::array<std::int64_t, n_phases> counts = {};
+	std::array<CounterValues, n_phases> total_events = {};
+	bool keep_history = false;
+	std::vector<PhaseSample> history;
+
+	static std::size_t index(const PerfPhase phase)
+		{ return static_cast<std::size_t>(phase); }
+};
+
+/// Print a table of phase times
+std::ostream& operator<< (std::ostream& out, const PerfStats& stats);
+
+/***************************************************************
+ * class: ScopedTimer
+ *
+ * Adds the time from its creation to its destruction to
+ * a phase of PerfStats, and to the trace if Tracer is active.
+ * Also adds hardware event counts if PerfCounters are enabled.
+ **************************************************************/
+
+class ScopedTimer
+{
+public:
+	ScopedTimer(PerfStats& perf_stats, const PerfPhase timed) :
+		stats(perf_stats), phase(timed)
+	{
+		if (PerfCounters::is_enabled())
+			counting = PerfCounters::read(start_events);
+		start = std::chrono::steady_clock::now();
+	}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	~ScopedTimer()
+	{
+		const auto end = std::chrono::steady_clock::now();
+		const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		if (counting)
+			stats.add(phase, ns, event_difference());
+		else
+			stats.add(phase, ns);
+		if (Tracer::is_active())
+			Tracer::record(PerfStats::phase_label(phase), "abm", start, end);
+	}
+
+private:
+	PerfStats& stats;
+	PerfPhase phase;
+	std::chrono::steady_clock::time_point start;
+	bool counting = false;
+	CounterValues start_events;
+
+	// Events counted since the start, -1 if an event is not available
+	CounterValues event_difference() const
+	{
+		CounterValues events;
+		if (!PerfCounters::read(events))
+			return CounterValues();
+		for (std::size_t i = 0; i < CounterValues::n_events; ++i)
+			if (events.values[i] >= 0 && start_events.values[i] >= 0)
+				events.values[i] -= start_events.values[i];
+			else
+				events.values[i] = -1;
+		return events;
+	}
+};
+
+// Time the rest of the enclosing scope as a phase
+#define ABM_PERF_CONCAT_IMPL(a, b) a##b
+#define ABM_PERF_CONCAT(a, b) ABM_PERF_CONCAT_IMPL(a, b)
+#ifdef ABM_WITH_PERF_STATS
+#define ABM_PERF_SCOPE(stats, phase) \
+	ScopedTimer ABM_PERF_CONCAT(abm_perf_timer_, __LINE__)(stats, phase)
+#else
+#define ABM_PERF_SCOPE(stats, phase) do { } while (false)
+#endif
+
+#endif
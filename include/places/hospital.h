@@ -0,0 +1,132 @@
+#ifndef HOSPITAL_H
+#define HOSPITAL_H
+
+#include "place.h"
+
+class Place;
+
+/*****************************************************
+ * class: Hospital
+ *
+ * Defines and stores attributes of a single hospital
+ *
+ * Registered agents are the admitted COVID patients.
+ * Employees are members of a staff workplace, if any,
+ * and count towards the total number of agents; they
+ * are exposed to patients through the contribution
+ * of the hospital added to their workplace, so agents
+ * don't need a separate hospital membership.
+ *
+ *****************************************************/
+
+class Hospital : public Place{
+public:
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Creates a Hospital object with default attributes
+	 */
+	Hospital() = default;
+
+	/**
+	 * \brief Creates a Hospital object
+	 * \details Hospital with custom ID, location, and infection parameters
+	 *
+	 * @param hospital_ID - ID of the hospital
+	 * @param xi - x coordinate of the hospital
+	 * @param yi - y coordinate of the hospital
+	 * @param severity_cor - severity correction for symptomatic
+	 * @param beta_emp - transmission rate of employees, 1/time
+	 * @param beta_pt - transmission rate of non-COVID patients, 1/time
+	 * @param beta_tst - transmission rate of agents tested at the hospital, 1/time
+	 * @param beta_hsp - transmission rate of hospitalized patients, 1/time
+	 * @param beta_icu - transmission rate of patients in ICU, 1/time
+	 */
+	Hospital(const int hospital_ID, const double xi, const double yi,
+			 const double severity_cor, const double beta_emp, const double beta_pt,
+			 const double beta_tst, const double beta_hsp, const double beta_icu) :
+			Place(hospital_ID, xi, yi, severity_cor, beta_emp), beta_patient(beta_pt), 
+			beta_tested(beta_tst), beta_hospitalized(beta_hsp), beta_ICU(beta_icu){ }
+
+	//
+	// Infection related computations
+	//
+
+	/**
+	 *  \brief Include contribution of a hospitalized patient in the sum
+	 *	@param inf_var - agent infectiousness variability factor
+	 */
+	void add_hospitalized(double inf_var) { lambda_sum += inf_var*ck*beta_hospitalized; ++num_infected; }
+
+	/**
+	 *  \brief Include contribution of a patient in ICU in the sum
+	 *	@param inf_var - agent infectiousness variability factor
+	 */
+	void add_hospitalized_ICU(double inf_var) { lambda_sum += inf_var*ck*beta_ICU; ++num_infected; }
+
+	/**
+	 * \brief Calculates and stores the contribution of patients
+	 * \details Normalized by the number of patients and employees
+	 */
+	void compute_infected_contribution() override;
+
+	//
+	// Getters
+	//
+
+	/// ID of the workplace of employees, 0 if none
+	int get_staff_workplace_ID() const { return staff_work_ID; }
+
+	/// Number of employees used in the last contribution
+	int get_number_of_staff() const { return num_staff; }
+
+	//
+	// Setters
+	//
+
+	/// Set ID of the workplace of employees, 0 if none
+	void set_staff_workplace_ID(const int work_ID) { staff_work_ID = work_ID; }
+
+	/// Set number of employees, they are registered in the staff workplace
+	void set_number_of_staff(const int n_staff) { num_staff = n_staff; }
+
+	/// Set transmission rates of patients and tested agents, 1/time
+	void set_patient_transmission_rates(const double beta_pt, const double beta_tst,
+					const double beta_hsp, const double beta_icu)
+		{ beta_patient = beta_pt; beta_tested = beta_tst;
+		  beta_hospitalized = beta_hsp; beta_ICU = beta_icu; }
+
+	//
+ 	// I/O
+	//
+
+	/**
+	 * \brief Save information about a Hospital object
+	 * \details Saves to a file, everything but detailed agent
+	 * 		information; order is ID | x | y | number of agents |
+	 * 		number of infected agents | ck | beta employee |
+	 * 		beta non-COVID patient | beta tested | beta hospitalized |
+	 * 		beta ICU; Delimiter is a space.
+	 * 	@param where - output stream
+	 */
+	void print_basic(std::ostream& where) const override;
+
+	/// \brief Buffered version of print_basic, same content and format
+	void print_basic(BlockWriter& where) const override;
+
+private:
+	// Transmission rates of patients that are not
+	// infected and of tested agents
+	double beta_patient = 0.0;
+	double beta_tested = 0.0;
+	// Transmission rates of COVID patients
+	double beta_hospitalized = 0.0;
+	double beta_ICU = 0.0;
+	// Workplace of employees and their number
+	int staff_work_ID = 0;
+	int num_staff = 0;
+};
+#endif
@@ -40,6 +40,16 @@ public:
 	Household(int house_ID, double xi, double yi, const double alpha_exp, const double severity_cor, const double beta) :
 		alpha(alpha_exp), Place(house_ID, xi, yi, severity_cor, beta) { }
 
+	//
+	// Setters
+	//
+
+	/// Set household size correction
+	void set_size_correction(const double alpha_exp) { alpha = alpha_exp; }
+
+	/// Set transmission rate of home isolated agents, 1/time
+	void set_home_isolated_transmission_rate(const double beta) { beta_ih = beta; }
+
 	//
  	// I/O
 	//
@@ -55,6 +65,9 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// \brief Buffered version of print_basic, same content and format
+	void print_basic(BlockWriter& where) const override;
+
 	//
 	// Infection related computations
 	//
@@ -70,13 +83,13 @@ public:
 	 *  \brief Include contribution of a symptomatic, home isolated agent in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
-	void add_symptomatic_home_isolated(double inf_var) { lambda_sum += inf_var*ck*beta_ih; }
+	void add_symptomatic_home_isolated(double inf_var) { lambda_sum += inf_var*ck*beta_ih; ++num_infected; }
 
 	/** 
 	 *  \brief Include contribution of an exposed , home isolated agent in the sum
 	 *	@param inf_var - agent infectiousness variability factor
 	 */
-	void add_exposed_home_isolated(double inf_var) { lambda_sum += inf_var*beta_ih; }
+	void add_exposed_home_isolated(double inf_var) { lambda_sum += inf_var*beta_ih; ++num_infected; }
 
 private:
 	// Household size scaling factor
@@ -2,6 +2,17 @@
 #define PLACE_H
 
 #include "../common.h"
+#include <cstdint>
+
+class BlockWriter;
+
+/// Types of places, used to tag output and per-type settings
+enum class PlaceType : std::uint8_t {
+	none = 0,
+	household = 1,
+	school = 2,
+	workplace = 3
+};
 
 /***************************************************** 
  * class: Place
@@ -58,6 +69,21 @@ public:
 	 */
 	virtual void compute_infected_contribution();
 
+	/**
+	 * \brief Multiply the total contribution computed for this step
+	 * \details Same as multiplying the transmission rate of the place
+	 * @param factor - multiplier, 0 for a closed place
+	 */
+	void scale_infected_contribution(const double factor) { lambda_tot *= factor; }
+
+	/**
+	 * \brief Add to the total contribution computed for this step
+	 * \details Exposure of the members to another place, e.g. of
+	 * 		hospital employees to patients
+	 * @param lambda - contribution of the other place
+	 */
+	void add_infected_contribution(const double lambda) { lambda_tot += lambda; }
+
 	/**
 	 *	\brief Reset the lambda sum of a place after transmission step
 	 */
@@ -72,7 +98,13 @@ public:
 	int get_ID() const { return ID; }
 
 	/// Return IDs of agents registered in this place	
-	virtual std::vector<int> get_agent_IDs() const { return agent_IDs; }
+	virtual const std::vector<int>& get_agent_IDs() const { return *agent_IDs; }
+
+	/// Return IDs of former members of this place that died
+	const std::vector<int>& get_dead_agent_IDs() const { return dead_agent_IDs; }
+
+	/// Return number of former members of this place that died
+	int get_number_of_dead() const { return static_cast<int>(dead_agent_IDs.size()); }
 
 	/// Return total number of infected agents
 	int get_total_infected() const { return num_infected; }
@@ -80,6 +112,16 @@ public:
 	/// Return fraction/contribution of infected agents
 	double get_infected_contribution() const { return lambda_tot; }
 
+	//
+	// Setters
+	//
+
+	/// Set severity correction for symptomatic
+	void set_severity_correction(const double severity_cor) { ck = severity_cor; }
+
+	/// Set infection transmission rate, 1/time
+	void set_transmission_rate(const double beta) { beta_j = beta; }
+
 	//
  	// I/O
 	//
@@ -94,6 +136,13 @@ public:
 	 */
 	virtual void print_basic(std::ostream& where) const;
 
+	/**
+	 * \brief Save information about a Place object, buffered
+	 * \details Same content and format as the std::ostream version
+	 * 	@param where - BlockWriter object for the output file
+	 */
+	virtual void print_basic(BlockWriter& where) const;
+
 	//
 	// Initialization and update
 	//
@@ -109,7 +158,7 @@ public:
 	 * \brief Add a new agent to this place
 	 * @param index - agent ID (starts with 1)
 	 */
-	void add_agent(const int index) { agent_IDs.push_back(index); }
+	void add_agent(const int index) { unshared_agent_IDs().push_back(index); }
 
 	/**
 	 * \brief Remove an agent from this place
@@ -117,13 +166,24 @@ public:
 	 */
 	void remove_agent(const int index);
 
+	/**
+	 * \brief Record that a member of this place died
+	 * \details Dead members are kept for contact counting,
+	 * 		independently of the registered agents
+	 * @param index - agent ID (starts with 1)
+	 */
+	void add_dead_agent(const int index) { dead_agent_IDs.push_back(index); }
+
 protected:
 	// Place ID
 	int ID = -1;
 	// Location
 	double x = 0.0, y = 0.0;
-	// IDs of agents in this place
-	std::vector<int> agent_IDs;
+	// IDs of agents in this place, shared with copies of
+	// the place until one of them changes its members
+	std::shared_ptr<std::vector<int>> agent_IDs = std::make_shared<std::vector<int>>();
+	// IDs of former members that died
+	std::vector<int> dead_agent_IDs;
 	// Total number of agents
 	int num_tot = 0;
 	// Total number of infected
@@ -142,6 +202,9 @@ protected:
 
 	// Ratio of infected agents
 	double inf_ratio = 0.0;	
+
+	/// IDs of agents that can be changed, copied first if shared
+	std::vector<int>& unshared_agent_IDs();
 };
 
 /// Overloaded ostream operator for I/O
@@ -0,0 +1,91 @@
+#ifndef PLACE_ACTIVATION_H
+#define PLACE_ACTIVATION_H
+
+#include "../common.h"
+#include <cstdint>
+
+/*****************************************************
+ * class: PlaceActivation
+ *
+ * Open or closed state of each place of one type
+ *
+ * One bit per place, indexed from 0 in the order of
+ * the vector of places, i.e. ID - 1. Closed places
+ * contribute nothing to infection probability.
+ *
+ * Subsets opened with open_first() are nested: places
+ * are opened in the order of a random ranking, so for
+ * the same ranking a larger fraction always opens a
+ * superset of places of a smaller one.
+ *
+ *****************************************************/
+
+class PlaceActivation{
+public:
+
+	//
+	// Constructors
+	//
+
+	/// Empty set
+	PlaceActivation() = default;
+
+	/**
+	 * \brief Creates a set of places all open or all closed
+	 * @param n - number of places
+	 * @param open - true if all places are open
+	 */
+	PlaceActivation(const int n, const bool open = true) : n_places(n)
+		{ set_all(open); }
+
+	//
+	// State of places
+	//
+
+	/// True if a place, indexed from 0, is open
+	bool is_open(const int i) const
+		{ return (words[i >> 6] >> (i & 63)) & 1u; }
+
+	/// Open or close a place indexed from 0
+	void set(const int i, const bool open);
+
+	/// Open or close all places
+	void set_all(const bool open);
+
+	/**
+	 * \brief Open places first in a ranking, close the rest
+	 * @param ranking - indices of places in the order of opening,
+	 * 		see random_ranking()
+	 * @param fraction - fraction of places to open, rounded to the
+	 * 		nearest number of places
+	 */
+	void open_first(const std::vector<int>& ranking, const double fraction);
+
+	/**
+	 * \brief Random order of places, the same for the same seed
+	 * \details Independent of the standard library implementation
+	 * @param n - number of places
+	 * @param seed - seed of the ranking
+	 */
+	static std::vector<int> random_ranking(const int n, const unsigned int seed);
+
+	//
+	// Getters
+	//
+
+	/// Number of places
+	int size() const { return n_places; }
+
+	/// Number of open places
+	int count_open() const;
+
+	/// True if every open place of this set is also open in other
+	bool is_subset_of(const PlaceActivation& other) const;
+
+private:
+	int n_places = 0;
+	// Bits of places, last word padded with 0
+	std::vector<std::uint64_t> words;
+};
+
+#endif
@@ -69,6 +69,20 @@ public:
     //
     void change_employee_transmission_rate (const double new_rate) { beta_emp = new_rate; }
 
+	/// Set absenteeism corrections of employees and students
+	void set_absenteeism_corrections(const double psi_e, const double psi)
+		{ psi_emp = psi_e; psi_j = psi; }
+
+	/// Set school type - daycare, primary, middle, high, or college
+	void set_type(const std::string& school_type) { type = school_type; }
+
+	//
+	// Getters
+	//
+
+	/// Return school type
+	const std::string& get_type() const { return type; }
+
 	//
  	// I/O
 	//
@@ -83,12 +97,17 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// \brief Buffered version of print_basic, same content and format
+	void print_basic(BlockWriter& where) const override;
+
 private:
 	// Absenteeism correction - employee, students
 	double psi_emp = 0.0;
 	double psi_j = 0.0;
 	// Employee infection transmission rate , 1/time
 	double beta_emp = 0.0;
+	// School type
+	std::string type = {};
 };
 
 #endif
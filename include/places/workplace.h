@@ -49,6 +49,13 @@ public:
 	 */
 	void add_symptomatic(double inf_var) override { lambda_sum += inf_var*ck*beta_j*psi_j; }
 
+	//
+	// Setters
+	//
+
+	/// Set absenteeism correction
+	void set_absenteeism_correction(const double psi) { psi_j = psi; }
+
 	//
  	// I/O
 	//
@@ -63,6 +70,9 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// \brief Buffered version of print_basic, same content and format
+	void print_basic(BlockWriter& where) const override;
+
 private:
 	// Absenteeism correction
 	double psi_j = 0.0;
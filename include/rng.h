@@ -70,6 +70,12 @@ public:
         return dist(gen);
     }
 
+	/**
+	 *	\brief Restart the generator with a given seed
+	 *	@param seed - new seed
+	 */
+    void seed(const unsigned int seed) { gen.seed(seed); }
+
 private:
     std::mt19937 gen;
 };
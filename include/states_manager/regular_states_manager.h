@@ -39,6 +39,18 @@ public:
 	void set_dying_symptomatic(Agent& agent);
 	/// Set all states relevant to agent that will recover 
 	void set_recovering_symptomatic(Agent& agent);
+	/// Keep an infected agent home or let them return to all their places
+	void set_home_isolation(Agent& agent, const bool isolated);
+	/// Admit a symptomatic agent to a hospital
+	void set_hospitalized(Agent& agent, const int hospital_ID);
+	/// Move a hospitalized agent to or out of ICU
+	void set_ICU(Agent& agent, const bool in_ICU);
+	/// Release an agent from a hospital
+	void set_discharged(Agent& agent);
+	/// Mark an agent as waiting for a test or results, or done with testing
+	void set_tested(Agent& agent, const bool tested);
+	/// Store a positive test result, isolate at home if still infected
+	void set_tested_positive(Agent& agent);
 
 	
 	/// Set all removed related states
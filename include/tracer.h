@@ -0,0 +1,109 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include "common.h"
+#include <chrono>
+#include <cstdint>
+
+/***************************************************************
+ * class: Tracer
+ *
+ * Timeline of simulation phases in Chrome trace format
+ *
+ * Records a complete event - name, start, and duration - for
+ * every timed scope, i.e. every ABM_PERF_SCOPE and
+ * ABM_TRACE_SCOPE, while tracing is active. Each thread
+ * writes to its own preallocated ring buffer, so recording
+ * takes no locks and the newest events are kept when a
+ * buffer is full. Buffers of finished threads are reused by
+ * new ones.
+ *
+ * Events are saved as Chrome trace-event JSON, which can be
+ * opened in chrome://tracing or ui.perfetto.dev. Starting,
+ * saving, and counting events pause recording and wait for
+ * events being written, so other threads can keep running
+ * traced code; events ending during the pause are dropped.
+ *
+ * Scopes are only compiled in with ABM_WITH_PERF_STATS, see
+ * PerfStats, and only record while the tracer is active.
+ **************************************************************/
+
+class Tracer
+{
+public:
+
+	Tracer() = delete;
+
+	/**
+	 * \brief Start recording events
+	 * \details Removes previously recorded events
+	 * @param fname - if not empty, events are saved to this file
+	 * 		when the program exits
+	 * @param events_per_thread - size of the ring buffer of each thread
+	 */
+	static void start(const std::string& fname = "", const std::size_t events_per_thread = 1 << 16);
+
+	/// Stop recording, recorded events are kept
+	static void stop();
+
+	/// True while events are recorded
+	static bool is_active();
+
+	/// Save recorded events as Chrome trace-event JSON
+	static void save(const std::string& fname);
+
+	/// Number of events currently stored in all buffers
+	static std::size_t get_number_of_events();
+
+	/**
+	 * \brief Record a complete event of the calling thread
+	 * @param name - name of the event, has to outlive the tracer,
+	 * 		e.g. a string literal
+	 * @param category - category of the event, same requirements
+	 * @param begin - start time
+	 * @param end - end time
+	 */
+	static void record(const char* name, const char* category,
+						const std::chrono::steady_clock::time_point& begin,
+						const std::chrono::steady_clock::time_point& end);
+};
+
+/***************************************************************
+ * class: TraceScope
+ *
+ * Records its lifetime as an event if the tracer is active
+ **************************************************************/
+
+class TraceScope
+{
+public:
+	TraceScope(const char* event_name, const char* event_category) :
+		name(event_name), category(event_category),
+		start(std::chrono::steady_clock::now()) { }
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+	~TraceScope()
+	{
+		if (Tracer::is_active())
+			Tracer::record(name, category, start, std::chrono::steady_clock::now());
+	}
+
+private:
+	const char* name;
+	const char* category;
+	std::chrono::steady_clock::time_point start;
+};
+
+// Trace the rest of the enclosing scope
+#define ABM_TRACE_CONCAT_IMPL(a, b) a##b
+#define ABM_TRACE_CONCAT(a, b) ABM_TRACE_CONCAT_IMPL(a, b)
+#ifdef ABM_WITH_PERF_STATS
+#define ABM_TRACE_SCOPE(name, category) \
+	TraceScope ABM_TRACE_CONCAT(abm_trace_scope_, __LINE__)(name, category)
+#else
+#define ABM_TRACE_SCOPE(name, category) do { } while (false)
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef HOSPITAL_TRANSITIONS_H
+#define HOSPITAL_TRANSITIONS_H
+
+//
+// Places
+//
+
+#include "../places/hospital.h"
+
+//
+// Other
+//
+
+#include "../common.h"
+#include "../agent.h"
+#include "../infection.h"
+#include "../states_manager/regular_states_manager.h"
+#include <queue>
+
+/*****************************************************
+ * class: HospitalTransitions
+ *
+ * Treatment of symptomatic agents in hospitals and ICU
+ *
+ * Admission, moving to and from ICU, and discharge are
+ * decided at the onset of symptoms and kept as events
+ * in a queue ordered by time, so each step only handles
+ * the events that are due instead of checking all the
+ * symptomatic agents.
+ *
+ * Hospitalized agents that will die are admitted if it
+ * happens before their death and spend the last days
+ * in ICU. The others stay for a fixed time in hospital,
+ * or in ICU and then in hospital, and recover no sooner
+ * than at the discharge. Mortality is not changed.
+ *
+ ******************************************************/
+
+/// Changes of hospital treatment of an agent
+enum class HospitalEventType : std::uint8_t {
+	admitted = 0,
+	to_ICU = 1,
+	from_ICU = 2,
+	discharged = 3
+};
+
+/// Treatment change of an agent at some time
+struct HospitalEvent {
+	double time = 0.0;
+	// Order of scheduling, for events at the same time
+	long long order = 0;
+	int agent_ID = 0;
+	HospitalEventType type = HospitalEventType::admitted;
+};
+
+class HospitalTransitions{
+public:
+
+	//
+	// Constructors
+	//
+
+	/// Creates a HospitalTransitions object that doesn't hospitalize
+	HospitalTransitions() = default;
+
+	/**
+	 * \brief Set durations of treatment and start hospitalizing
+	 * @param infection_parameters - "time in hospital", "time in ICU",
+	 * 		"time in hospital after ICU", and "time before death to ICU", days
+	 */
+	void set_parameters(const std::map<std::string, double>& infection_parameters);
+
+	/// True if agents are hospitalized
+	bool enabled() const { return is_enabled; }
+
+	//
+	// Transitions
+	//
+
+	/**
+	 * \brief Decide the treatment of an agent at the onset of symptoms
+	 * \details Needs the time of death or recovery already set;
+	 * 		recovery of hospitalized agents is moved to the discharge
+	 * @param agent - agent that became symptomatic at this time
+	 * @param time - current time
+	 * @param infection - source of random numbers
+	 */
+	void schedule_treatment(Agent& agent, const double time, Infection& infection);
+
+	/**
+	 * \brief Apply all events due at this time
+	 * @param time - current time
+	 * @param agents - all agents
+	 * @param hospitals - all hospitals, admission is to a random one
+	 * @param infection - source of random numbers
+	 */
+	void process_events(const double time, std::vector<Agent>& agents,
+						std::vector<Hospital>& hospitals, Infection& infection);
+
+	/// Number of events waiting
+	int get_number_of_events() const { return static_cast<int>(events.size()); }
+
+private:
+
+	/// Later events have lower priority, in order of scheduling at the same time
+	struct Later {
+		bool operator()(const HospitalEvent& a, const HospitalEvent& b) const
+			{ return a.time > b.time || (a.time == b.time && a.order > b.order); }
+	};
+
+	bool is_enabled = false;
+	// Durations, days
+	double time_in_hospital = 0.0;
+	double time_in_ICU = 0.0;
+	double time_after_ICU = 0.0;
+	double time_before_death_ICU = 0.0;
+
+	std::priority_queue<HospitalEvent, std::vector<HospitalEvent>, Later> events;
+	long long n_scheduled = 0;
+
+	// For changing agent states
+	RegularStatesManager states_manager;
+
+	/// Add an event to the queue
+	void schedule(const double time, const int agent_ID, const HospitalEventType type);
+};
+
+#endif
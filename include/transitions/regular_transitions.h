@@ -18,6 +18,8 @@
 #include "../agent.h"
 #include "../infection.h"
 #include "../states_manager/regular_states_manager.h"
+#include "../io_operations/event_log.h"
+#include <array>
 
 
 /***************************************************** 
@@ -62,16 +64,39 @@ public:
 				std::vector<Workplace>& workplaces,
 				const std::map<std::string, double>& infection_parameters);
 
+	/// \brief Log transitions to event_log, nullptr to stop logging
+	void set_event_log(EventLog* log) { event_log = log; }
+
+	/// \brief Restart the generator for places of infection with a given seed
+	void set_seed(const unsigned int seed) { rng.seed(seed); }
+
+	/// \brief Isolate agents at home from the onset of symptoms if true
+	void set_symptomatic_home_isolation(const bool isolate) { isolate_symptomatic = isolate; }
+
 private:
 
 	// For changing agent states
 	RegularStatesManager states_manager;
 
+	// Transition event log, not owned, nullptr if not logging
+	EventLog* event_log = nullptr;
+	// True if agents isolate at home when they become symptomatic
+	bool isolate_symptomatic = false;
+	// Separate generator for sampling of places of infection 
+	// so that logging doesn't change the simulation 
+	RNG rng;
+
 	/// \brief Return total lambda of susceptible agent
 	double compute_susceptible_lambda(const Agent& agent, const double time, 
 					const std::vector<Household>& households, const std::vector<School>& schools,
 					const std::vector<Workplace>& workplaces);
 
+	/// \brief Sample place of infection proportionally to its contribution to lambda
+	/// @return Type and ID of the place
+	std::pair<PlaceType, int> attribute_infection(const Agent& agent, const double lambda_tot, 
+					const std::vector<Household>& households, const std::vector<School>& schools,
+					const std::vector<Workplace>& workplaces);
+
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
 				                const std::map<std::string, double>& infection_parameters);
@@ -93,6 +118,12 @@ private:
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces);
 
+	/// \brief Record agent's death in all places they belong to
+	/// \details Updates the dead members used for counting dead contacts
+	void add_dead_agent_to_all_places(const Agent& agent,
+					std::vector<Household>& households, std::vector<School>& schools,
+					std::vector<Workplace>& workplaces);
+
 	/// \brief Remove agent's index from all workplaces and schools that have them registered
 	void remove_from_all_workplaces_and_schools(const Agent& agent,
 							std::vector<School>& schools, std::vector<Workplace>& workplaces);
@@ -0,0 +1,193 @@
+#ifndef TESTING_TRANSITIONS_H
+#define TESTING_TRANSITIONS_H
+
+//
+// Other
+//
+
+#include "../common.h"
+#include "../agent.h"
+#include "../infection.h"
+#include "../states_manager/regular_states_manager.h"
+#include <queue>
+#include <set>
+#include <limits>
+
+/*****************************************************
+ * class: TestingTransitions
+ *
+ * Testing of infected agents and isolation of the
+ * positive ones
+ *
+ * Agents decide to get tested at the onset of symptoms
+ * or, if exposed, when they become infectious. The test
+ * and the results follow after fixed delays; decisions,
+ * tests, and results are kept as events in a queue
+ * ordered by time, so each step only handles the events
+ * that are due instead of checking all the agents.
+ *
+ * Tests are limited by a daily capacity. Agents due for
+ * a test wait in a bounded queue, symptomatic first and
+ * then in order of their test times; when it is full,
+ * the agents with the lowest priority are not tested.
+ * Agents removed before their test are not tested and
+ * don't use up the capacity; results of agents that died
+ * are ignored. Agents with positive results isolate at home.
+ *
+ ******************************************************/
+
+/// Steps of testing of an agent
+enum class TestingEventType : std::uint8_t {
+	decided = 0,
+	tested = 1,
+	results = 2
+};
+
+/// Testing step of an agent at some time
+struct TestingEvent {
+	double time = 0.0;
+	// Order of scheduling, for events at the same time
+	long long order = 0;
+	int agent_ID = 0;
+	TestingEventType type = TestingEventType::decided;
+	// Decided at the onset of symptoms
+	bool symptomatic = false;
+	// Outcome of the test, for results
+	bool positive = false;
+};
+
+class TestingTransitions{
+public:
+
+	//
+	// Constructors
+	//
+
+	/// Creates a TestingTransitions object that doesn't test
+	TestingTransitions() = default;
+
+	/**
+	 * \brief Set delays of testing and start testing
+	 * @param infection_parameters - "time from decision to test",
+	 * 		"time from test to results", and "start testing", days
+	 */
+	void set_parameters(const std::map<std::string, double>& infection_parameters);
+
+	/**
+	 * \brief Limit the number of tests
+	 * @param tests_per_day - maximum number of tests in a day
+	 * @param waiting - maximum number of agents waiting for a test
+	 * 		when the tests of the day are used up
+	 */
+	void set_capacity(const int tests_per_day, const int waiting)
+		{ capacity = tests_per_day; max_waiting = waiting; }
+
+	/// True if agents are tested
+	bool enabled() const { return is_enabled; }
+
+	//
+	// Transitions
+	//
+
+	/**
+	 * \brief Decide testing of a newly infected agent
+	 * \details Needs the start of infectiousness already set,
+	 * 		the decision is made then
+	 * @param agent - agent that got infected at this time
+	 * @param infection - source of random numbers
+	 */
+	void schedule_exposed(Agent& agent, Infection& infection)
+		{ decide(agent, agent.get_infectiousness_start_time(), infection, false); }
+
+	/**
+	 * \brief Decide testing at the onset of symptoms
+	 * @param agent - agent that became symptomatic at this time
+	 * @param time - current time
+	 * @param infection - source of random numbers
+	 */
+	void schedule_symptomatic(Agent& agent, const double time, Infection& infection)
+		{ decide(agent, time, infection, true); }
+
+	/**
+	 * \brief Apply all events due at this time and test waiting agents
+	 * @param time - current time
+	 * @param agents - all agents
+	 * @param infection - source of random numbers
+	 */
+	void process_events(const double time, std::vector<Agent>& agents, Infection& infection);
+
+	//
+	// Getters
+	//
+
+	/// Number of events waiting
+	int get_number_of_events() const { return static_cast<int>(events.size()); }
+
+	/// Number of agents waiting for a test
+	int get_number_waiting() const { return static_cast<int>(waiting.size()); }
+
+	/// Total number of tests
+	int get_number_tested() const { return n_tested; }
+
+	/// Total number of positive results
+	int get_number_positive() const { return n_positive; }
+
+	/// Total number of agents not tested because the queue was full
+	int get_number_not_tested() const { return n_not_tested; }
+
+private:
+
+	/// Later events have lower priority, in order of scheduling at the same time
+	struct Later {
+		bool operator()(const TestingEvent& a, const TestingEvent& b) const
+			{ return a.time > b.time || (a.time == b.time && a.order > b.order); }
+	};
+
+	/// Order of testing - symptomatic, then earlier, then in order of scheduling
+	struct TestedFirst {
+		bool operator()(const TestingEvent& a, const TestingEvent& b) const
+		{
+			if (a.symptomatic != b.symptomatic)
+				return a.symptomatic;
+			return a.time < b.time || (a.time == b.time && a.order < b.order);
+		}
+	};
+
+	bool is_enabled = false;
+	// Delays, days
+	double time_to_test = 0.0;
+	double time_to_results = 0.0;
+	// No decisions before this time
+	double start_time = 0.0;
+
+	// Tests in a day and agents that can wait
+	int capacity = std::numeric_limits<int>::max();
+	int max_waiting = 0;
+	// Day of the last tests and their number
+	long long current_day = -1;
+	int n_tested_today = 0;
+
+	int n_tested = 0;
+	int n_positive = 0;
+	int n_not_tested = 0;
+
+	std::priority_queue<TestingEvent, std::vector<TestingEvent>, Later> events;
+	std::set<TestingEvent, TestedFirst> waiting;
+	long long n_scheduled = 0;
+
+	// For changing agent states
+	RegularStatesManager states_manager;
+
+	/// Decide if the agent gets tested and schedule the decision
+	void decide(Agent& agent, const double time, Infection& infection, const bool symptomatic);
+
+	/// Test an agent now and schedule the results
+	void test(const TestingEvent& request, const double time, std::vector<Agent>& agents,
+				Infection& infection);
+
+	/// Add an event to the queue
+	void schedule(const double time, const int agent_ID, const TestingEventType type,
+				const bool symptomatic, const bool positive = false);
+};
+
+#endif
@@ -9,12 +9,15 @@
 #include "../places/household.h"
 #include "../places/school.h"
 #include "../places/workplace.h"
+#include "../places/hospital.h"
 
 //
 // Transitions
 //
 
 #include "regular_transitions.h"
+#include "hospital_transitions.h"
+#include "testing_transitions.h"
 
 
 //
@@ -49,7 +52,8 @@ public:
 	//
 
 	/// \brief Implement transitions relevant to susceptible
-	/// \details Returns 1 if the agent got infected 
+	/// \details Returns 1 if the agent got infected; decides 
+	/// 	testing of the newly infected if enabled
 	int susceptible_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection,	
 				std::vector<Household>& households, std::vector<School>& schools,
@@ -57,7 +61,8 @@ public:
 				double>& infection_parameters, std::vector<Agent>& agents);
 
 	/// \brief Implement transitions relevant to exposed
-	/// \details Return 1 if recovered without symptoms 
+	/// \details Return 1 if recovered without symptoms; schedules 
+	/// 	the hospital treatment and testing at the onset of symptoms if enabled
 	int exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Workplace>& workplaces,const std::map<std::string,
@@ -71,11 +76,52 @@ public:
 				std::vector<Workplace>& workplaces,const std::map<std::string,
 				double>& infection_parameters);
 
+	/// \brief Admissions, ICU, and discharges due at this time, if enabled
+	void hospital_transitions(const double time, std::vector<Agent>& agents,
+				std::vector<Hospital>& hospitals, Infection& infection)
+		{ if (hospital_tr.enabled()) hospital_tr.process_events(time, agents, hospitals, infection); }
+
+	/// \brief Start hospitalizing agents, with durations of treatment from the parameters
+	void set_hospital_parameters(const std::map<std::string, double>& infection_parameters)
+		{ hospital_tr.set_parameters(infection_parameters); }
+
+	/// \brief Number of hospital events waiting
+	int get_number_of_hospital_events() const { return hospital_tr.get_number_of_events(); }
+
+	/// \brief Decisions, tests, and results due at this time, if enabled
+	void testing_transitions(const double time, std::vector<Agent>& agents, Infection& infection)
+		{ if (testing_tr.enabled()) testing_tr.process_events(time, agents, infection); }
+
+	/// \brief Start testing agents, with delays of testing from the parameters
+	void set_testing_parameters(const std::map<std::string, double>& infection_parameters)
+		{ testing_tr.set_parameters(infection_parameters); }
+
+	/// \brief Limit the number of tests in a day and of agents waiting for a test
+	void set_testing_capacity(const int tests_per_day, const int max_waiting)
+		{ testing_tr.set_capacity(tests_per_day, max_waiting); }
+
+	/// \brief True if agents are tested
+	bool testing_enabled() const { return testing_tr.enabled(); }
+
+	/// \brief Const reference to the testing state, for counts of tests
+	const TestingTransitions& get_testing() const { return testing_tr; }
+
+	/// \brief Log transitions to event_log, nullptr to stop logging
+	void set_event_log(EventLog* log) { regular_tr.set_event_log(log); }
+
+	/// \brief Restart random number generators with a given seed
+	void set_seed(const unsigned int seed) { regular_tr.set_seed(seed); }
+
+	/// \brief Isolate agents at home from the onset of symptoms if true
+	void set_symptomatic_home_isolation(const bool isolate) 
+		{ regular_tr.set_symptomatic_home_isolation(isolate); }
 
 private:
 	
 	// Transition classes
 	RegularTransitions regular_tr;
+	HospitalTransitions hospital_tr;
+	TestingTransitions testing_tr;
 
 };
 
@@ -2,6 +2,7 @@
 #define UTILS_H
 
 #include "common.h"
+#include <functional>
 
 /**
  * \brief Convert a string to all lower case
@@ -11,4 +12,18 @@
  */
 std::string str_to_lower(std::string s); 
 
+/**
+ * \brief Call task for indices [first, last) distributed over threads
+ * \details Each thread takes the next index until none are left; the
+ * 		calling thread works too. The first exception thrown by a task
+ * 		stops the remaining indices and is rethrown after all threads end.
+ *
+ * @param [in] first - first index
+ * @param [in] last - one past the last index
+ * @param [in] n_threads - maximum number of threads
+ * @param [in] task - function called with each index
+ */
+void parallel_for(const int first, const int last, const unsigned int n_threads,
+					const std::function<void(const int)>& task);
+
 #endif
@@ -35,11 +35,12 @@ class Agents:
 		print('Assigning coordinates of the household')
 
 		# Indices of agents that are students and workers
-		# Using random.sample to get unique IDs
-		studentIDs = random.sample(range(1, self.ntot+1), self.n_at_schools) 
-		workerIDs = random.sample(range(1, self.ntot+1), self.n_at_works) 
+		# Using random.sample to get unique IDs, sets for
+		# constant time membership checks
+		studentIDs = set(random.sample(range(1, self.ntot+1), self.n_at_schools))
+		workerIDs = set(random.sample(range(1, self.ntot+1), self.n_at_works))
 		# Indices of agents that are infected
-		infectedIDs = random.sample(range(1, self.ntot+1), self.n_infected)
+		infectedIDs = set(random.sample(range(1, self.ntot+1), self.n_infected))
 
 		for i in range(1, self.ntot+1):
 			# Assign ID (not related to simulation ID)
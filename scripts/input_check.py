@@ -4,6 +4,9 @@
 #
 #	- Does not check for upper numeric limits since they are rather
 #		high 	
+#	- The C++ loaders perform the same checks while reading the
+#		population (InputValidator), this module is only needed
+#		for checking generated input from Python
 #
 # ------------------------------------------------------------------
 
@@ -0,0 +1,20 @@
+#!/bin/bash
+#
+# Profile guided optimization build of covid_exe and the rest
+#
+# Builds an instrumented copy, runs the New Rochelle simulation
+# to collect profiles, then rebuilds with them. The result is
+# in build/pgo. Run from the main directory of the repository.
+#
+
+set -e
+
+# Profiles of an earlier build would be mixed in
+rm -rf build/pgo-profiles
+
+cmake --preset pgo-generate
+cmake --build --preset pgo-generate -j "$(nproc)"
+cmake --build --preset pgo-train
+
+cmake --preset pgo-use
+cmake --build --preset pgo-use -j "$(nproc)"
@@ -0,0 +1,69 @@
+#include "../../include/equivalence.h"
+#include <chrono>
+
+/*****************************************************
+ *
+ * Statistical equivalence of a simulation engine with
+ * the reference ABM::transmit_infection on the model
+ * of COVID-19 SEIR in New Rochelle, NY
+ *
+ * Usage: ./equivalence_exe [engine] [replicates] [steps] [significance]
+ *
+ * Engines are listed in the map below; the program
+ * prints the failed tests and exits with 1 if there
+ * are any
+ *
+ ******************************************************/
+
+int main(int argc, char* argv[])
+{
+	const std::string name = (argc > 1) ? argv[1] : "reference";
+	const int n_replicates = (argc > 2) ? std::stoi(argv[2]) : 100;
+	const int n_steps = (argc > 3) ? std::stoi(argv[3]) : 200;
+	const double alpha = (argc > 4) ? std::stod(argv[4]) : 0.01;
+
+	// Candidate engines
+	const std::map<std::string, StepFunction> engines =
+		{ {"reference", EquivalenceTest::reference_engine()} };
+	if (engines.find(name) == engines.end())
+		throw std::invalid_argument("Unknown engine: " + name);
+
+	// Time in days, space in km
+	double dt = 0.25;
+	// Initially infected in each run
+	int ninf0 = 10;
+
+	// Input files
+	std::string fin("input_data/NR_agents.txt");
+	std::string hfile("input_data/NR_households.txt");
+	std::string sfile("input_data/NR_schools.txt");
+	std::string wfile("input_data/NR_workplaces.txt");
+
+	// File with infection parameters
+	std::string pfname("input_data/infection_parameters.txt");
+	// Files with age-dependent distributions;
+	std::string dmort_name("input_data/age_dist_mortality.txt");
+	// Map for abm loading of distributions
+	std::map<std::string, std::string> dfiles =
+		{ {"mortality", dmort_name} };
+
+	// Population is loaded once, without infected agents
+	ABM abm(dt, pfname, dfiles);
+	abm.create_households(hfile);
+	abm.create_schools(sfile);
+	abm.create_workplaces(wfile);
+	abm.create_agents(fin);
+
+	EquivalenceTest test(abm, ninf0, n_steps, n_replicates, alpha);
+	std::cout << "Engine " << name << ", " << n_replicates << " replicates of "
+			  << n_steps << " steps" << std::endl;
+
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	const std::vector<EquivalenceResult> results = test.compare(EquivalenceTest::reference_engine(),
+															engines.at(name));
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	std::cout << "Time difference = " << std::chrono::duration_cast<std::chrono::seconds> (end - begin).count() << "[s]" << std::endl;
+
+	EquivalenceTest::print(std::cout, results);
+	return EquivalenceTest::all_passed(results) ? 0 : 1;
+}
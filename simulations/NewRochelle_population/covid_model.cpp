@@ -5,16 +5,51 @@
  *
  * ABM run of COVID-19 SEIR in New Rochelle, NY 
  *
+ * Usage: ./covid_exe [trace file] [phase history file] [agent states file]
+ *					[event log file] [baseline|policy]
+ *
+ * All the files are optional, "none" skips a file.
+ * With a trace file name, phases of the simulation are
+ * saved there as a Chrome trace at exit.
+ * With a history file name, hardware performance counters are
+ * enabled if the system allows it, and every measured phase
+ * of every step is saved to that file.
+ * With an agent states file name, states of all agents are
+ * saved there every step, see AgentSnapshotWriter.
+ * With an event log file name, all transitions of agents
+ * with places of infection are logged there, see EventLog.
+ *
+ * The baseline scenario runs without interventions. In the
+ * policy scenario, schools close and businesses close and reopen
+ * at times given in the infection parameters, and symptomatic
+ * agents isolate at home.
+ *
  ******************************************************/
 
-int main()
+int main(int argc, char* argv[])
 {
+	// Optional output files, empty if not given
+	auto output_file = [argc, argv](const int i)
+		{ return (argc > i && std::string(argv[i]) != "none") ? std::string(argv[i]) : std::string(); };
+	const std::string trace_file = output_file(1);
+	const std::string history_file = output_file(2);
+	const std::string states_file = output_file(3);
+	const std::string events_file = output_file(4);
+	const std::string scenario = (argc > 5) ? argv[5] : "baseline";
+	if (scenario != "baseline" && scenario != "policy")
+		throw std::invalid_argument("Unknown scenario: " + scenario);
+
+	if (!trace_file.empty())
+		Tracer::start(trace_file);
+	if (!history_file.empty() && !PerfCounters::enable())
+		std::cout << "Hardware counters not available - " << PerfCounters::get_error() << "\n";
+
 	// Time in days, space in km
 	double dt = 0.25;
 	// Max number of steps to simulate
 	int tmax = 400;	
-	// Print agent info this many steps
-	int dt_out_agents = 401;
+	// Save agent states this many steps, if saved
+	int dt_out_agents = 1;
 
 	// Input files
 	std::string fin("input_data/NR_agents.txt");
@@ -32,6 +67,7 @@ int main()
 		{ {"mortality", dmort_name} };
 
 	ABM abm(dt, pfname, dfiles);
+	abm.record_perf_history(!history_file.empty());
 
 	// First the places
 	abm.create_households(hfile);
@@ -40,6 +76,15 @@ int main()
 
 	// Then the agents
 	abm.create_agents(fin, 10);
+
+	if (scenario == "policy"){
+		// School closure, lockdown, and reopening from the infection parameters
+		InterventionSchedule interventions = InterventionSchedule::from_parameters(abm.get_infection_parameters());
+		abm.set_intervention_schedule(interventions);
+		interventions.print(std::cout);
+		// Symptomatic agents stay home, with a lower household transmission rate
+		abm.set_symptomatic_home_isolation(true);
+	}
 	
 	// Simulation
 	// Collect infected agents and save
@@ -50,16 +95,27 @@ int main()
     std::vector<int> susceptible_count(tmax+1);
     // Add removed too
     std::vector<int> removed_count(tmax+1);
+	// Total contacts of living agents with living and dead agents
+	std::vector<long long> contacts_count(tmax+1);
+	std::vector<long long> dead_contacts_count(tmax+1);
+
+	// Log of agent transitions with places of infection
+	if (!events_file.empty())
+		abm.enable_event_log(events_file);
+
+	// Agent states with time, compact binary format
+	std::unique_ptr<AgentSnapshotWriter> agent_states;
+	if (!states_file.empty())
+		agent_states.reset(new AgentSnapshotWriter(states_file, abm.get_vector_of_agents().size()));
 
 	// For time measurement
 	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 
 	for (int ti = 0; ti<=tmax; ++ti){
-		// Save agent information
-/*		if (ti%dt_out_agents == 0){
-			std::string fname = "output/agents_t_" + std::to_string(ti) + ".txt";
-			abm.print_agents(fname);
-		}*/
+		// Save agent states
+		if (agent_states && ti%dt_out_agents == 0){
+			abm.save_agent_states(*agent_states);
+		}
 
         //Get the number of interactions for each agent
 //        if (ti == 0){
@@ -71,10 +127,16 @@ int main()
         susceptible_count.at(ti) = abm.get_num_susceptible();
         removed_count.at(ti) = abm.get_num_removed();
 
+		std::pair<long long, long long> contacts = abm.count_total_interactions();
+		contacts_count.at(ti) = contacts.first;
+		dead_contacts_count.at(ti) = contacts.second;
+
 		abm.transmit_infection();
 //		abm.collect_dead_interactions();
 	}
 
+	abm.disable_event_log();
+
 	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
 	std::cout << "Time difference = " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "[ms]" << std::endl;
 	std::cout << "Time difference = " << std::chrono::duration_cast<std::chrono::seconds> (end - begin).count() << "[s]" << std::endl;
@@ -92,6 +154,12 @@ int main()
     std::ofstream outR("output/removed_with_time.txt");
     std::copy(removed_count.begin(), removed_count.end(), std::ostream_iterator<int>(outR," "));
 
+	std::ofstream outC("output/contacts_with_time.txt");
+	std::copy(contacts_count.begin(), contacts_count.end(), std::ostream_iterator<long long>(outC," "));
+
+	std::ofstream outD("output/dead_contacts_with_time.txt");
+	std::copy(dead_contacts_count.begin(), dead_contacts_count.end(), std::ostream_iterator<long long>(outD," "));
+
 
 	// Output interactions
 //    abm.output_interactions("interactions.txt");
@@ -103,4 +171,11 @@ int main()
 	std::cout << "Total number of infected agents: " << abm.get_total_infected() << "\n"
 			  << "Total number of casualities: " << abm.get_total_dead() << "\n"
 			  << "Total number of recovered agents: " << abm.get_total_recovered() << "\n";
+
+	// Where the time went
+	std::cout << "\n" << abm.get_perf_stats();
+	if (!history_file.empty()){
+		std::ofstream history(history_file);
+		abm.get_perf_stats().print_history(history);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "../../include/parameter_sweep.h"
+#include <chrono>
+
+/*****************************************************
+ *
+ * Sweep of infection parameters of the ABM run of
+ * COVID-19 SEIR in New Rochelle, NY
+ *
+ * Usage: ./sweep_exe [grid|list|lhs] [replicates] [LHS sets]
+ *
+ * Values of the swept parameters are in
+ * input_data/sweep_parameters.txt; for lhs each
+ * parameter has a minimum and a maximum
+ *
+ ******************************************************/
+
+int main(int argc, char* argv[])
+{
+	const std::string mode = (argc > 1) ? argv[1] : "grid";
+	const int n_replicates = (argc > 2) ? std::stoi(argv[2]) : 2;
+	const int n_lhs = (argc > 3) ? std::stoi(argv[3]) : 10;
+
+	// Time in days, space in km
+	double dt = 0.25;
+	// Max number of steps to simulate
+	int tmax = 400;
+	// Initially infected in each run
+	int ninf0 = 10;
+
+	// Input files
+	std::string fin("input_data/NR_agents.txt");
+	std::string hfile("input_data/NR_households.txt");
+	std::string sfile("input_data/NR_schools.txt");
+	std::string wfile("input_data/NR_workplaces.txt");
+
+	// Base infection parameters and the swept ones
+	std::string pfname("input_data/infection_parameters.txt");
+	std::string sweep_name("input_data/sweep_parameters.txt");
+	// Files with age-dependent distributions;
+	std::string dmort_name("input_data/age_dist_mortality.txt");
+	// Map for abm loading of distributions
+	std::map<std::string, std::string> dfiles =
+		{ {"mortality", dmort_name} };
+
+	// Population is loaded once, without infected agents
+	ABM abm(dt, pfname, dfiles);
+	abm.create_households(hfile);
+	abm.create_schools(sfile);
+	abm.create_workplaces(wfile);
+	abm.create_agents(fin);
+
+	LoadParameters ldparam;
+	std::map<std::string, std::vector<double>> spec = ldparam.load_parameter_lists(sweep_name);
+	std::vector<ParameterSet> sets;
+	if (mode == "grid")
+		sets = ParameterSweep::grid(spec);
+	else if (mode == "list")
+		sets = ParameterSweep::list(spec);
+	else if (mode == "lhs")
+		sets = ParameterSweep::latin_hypercube(spec, n_lhs, 2020);
+	else
+		throw std::invalid_argument("Unknown sweep mode: " + mode);
+
+	// Totals and the epidemic peak
+	std::function<std::vector<double>(ABM&, const int, const int)> one_run =
+		[tmax, ninf0, dt](ABM& model, const int, const int){
+			model.infect_random_agents(ninf0);
+			int peak = 0, peak_step = 0;
+			for (int ti = 0; ti<=tmax; ++ti){
+				const int n_infected = model.get_num_infected();
+				if (n_infected > peak){
+					peak = n_infected;
+					peak_step = ti;
+				}
+				model.transmit_infection();
+			}
+			return std::vector<double>{static_cast<double>(model.get_total_infected()),
+					static_cast<double>(model.get_total_dead()), static_cast<double>(peak),
+					peak_step*dt};
+		};
+
+	ParameterSweep sweep(abm);
+	std::cout << sets.size() << " parameter sets, " << n_replicates << " replicates, "
+			  << sweep.get_number_of_threads() << " threads" << std::endl;
+
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	std::vector<std::vector<double>> results = sweep.run(sets, n_replicates, one_run, 2020);
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	std::cout << "Time difference = " << std::chrono::duration_cast<std::chrono::seconds> (end - begin).count() << "[s]" << std::endl;
+
+	ParameterSweep::save_results("output/sweep_results.txt", sets, n_replicates, results,
+				{"total infected", "total dead", "peak infected", "time of peak"});
+}
@@ -0,0 +1,82 @@
+import subprocess, glob, os
+
+#
+# Input 
+#
+
+# Path to the main directory
+path = '../../src/'
+# Compiler options
+cx = 'g++'
+std = '-std=c++11'
+opt = '-O3'
+thr = '-pthread'
+# For .zst output add -DABM_WITH_ZSTD to opt and -lzstd here
+lib = '-lz'
+
+# Source files of the generator and tiling
+gen_files = path + 'io_operations/population_generator.cpp'
+gen_files += ' ' + path + 'io_operations/population_tiling.cpp'
+gen_files += ' ' + path + 'io_operations/input_validation.cpp'
+gen_files += ' ' + path + 'io_operations/FileHandler.cpp'
+gen_files += ' ' + path + 'io_operations/compressed_stream.cpp'
+gen_files += ' ' + path + 'io_operations/block_writer.cpp'
+gen_files += ' ' + path + 'tracer.cpp'
+gen_files += ' ' + path + 'utils.cpp'
+
+# Source files of the model
+src_files = path + 'abm.cpp' 
+src_files += ' ' + path + 'agent.cpp' 
+src_files += ' ' + path + 'infection.cpp'
+src_files += ' ' + path + 'contributions.cpp'
+src_files += ' ' + path + 'intervention_schedule.cpp'
+src_files += ' ' + path + 'interactions.cpp'
+src_files += ' ' + path + 'perf_stats.cpp'
+src_files += ' ' + path + 'tracer.cpp'
+src_files += ' ' + path + 'perf_counters.cpp'
+src_files += ' ' + path + 'ensemble.cpp'
+src_files += ' ' + path + 'parameter_sweep.cpp'
+src_files += ' ' + path + 'fork_runner.cpp'
+src_files += ' ' + path + 'equivalence.cpp'
+src_files += ' ' + path + 'transitions/transitions.cpp'
+src_files += ' ' + path + 'transitions/regular_transitions.cpp'
+src_files += ' ' + path + 'transitions/hospital_transitions.cpp'
+src_files += ' ' + path + 'transitions/testing_transitions.cpp'
+src_files += ' ' + path + 'states_manager/states_manager.cpp'
+src_files += ' ' + path + 'states_manager/regular_states_manager.cpp'
+src_files += ' ' + path + 'utils.cpp'
+src_files += ' ' + path + 'places/place.cpp'
+src_files += ' ' + path + 'places/household.cpp'
+src_files += ' ' + path + 'places/workplace.cpp'
+src_files += ' ' + path + 'places/hospital.cpp'
+src_files += ' ' + path + 'places/school.cpp'
+src_files += ' ' + path + 'places/place_activation.cpp'
+src_files += ' ' + path + 'io_operations/FileHandler.cpp'
+src_files += ' ' + path + 'io_operations/compressed_stream.cpp'
+src_files += ' ' + path + 'io_operations/input_validation.cpp'
+src_files += ' ' + path + 'io_operations/contact_network.cpp'
+src_files += ' ' + path + 'io_operations/block_writer.cpp'
+src_files += ' ' + path + 'io_operations/population_generator.cpp'
+src_files += ' ' + path + 'io_operations/population_tiling.cpp'
+src_files += ' ' + path + 'io_operations/load_parameters.cpp'
+src_files += ' ' + path + 'io_operations/agent_snapshots.cpp'
+src_files += ' ' + path + 'io_operations/event_log.cpp'
+
+# Name of the executable
+exe_name = 'generator_exe'
+# Files needed only for this build
+spec_files = 'generate_population.cpp '
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, gen_files, lib])
+subprocess.call([compile_com], shell=True)
+
+# Tiles of the New Rochelle population
+exe_name = 'tiling_exe'
+spec_files = 'tile_population.cpp '
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, gen_files, lib])
+subprocess.call([compile_com], shell=True)
+
+# Weak scaling with tiled populations
+exe_name = 'weak_scaling_exe'
+spec_files = 'weak_scaling.cpp '
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
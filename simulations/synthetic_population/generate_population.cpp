@@ -0,0 +1,46 @@
+#include "../../include/io_operations/population_generator.h"
+#include <chrono>
+
+/*****************************************************
+ *
+ * Random synthetic population of a given size for
+ * scaling studies
+ *
+ * Usage: ./generator_exe [agents] [seed] [output prefix]
+ * 			[threads] [extension]
+ *
+ * Writes households, schools, workplaces, and agents
+ * files named prefix + "_households" + extension etc.;
+ * extension .txt.gz compresses the output
+ *
+ ******************************************************/
+
+int main(int argc, char* argv[])
+{
+	const int n_agents = (argc > 1) ? std::stoi(argv[1]) : 1000000;
+	const unsigned int seed = (argc > 2) ? std::stoul(argv[2]) : 0;
+	const std::string prefix = (argc > 3) ? argv[3] : "synthetic";
+	const unsigned int n_threads = (argc > 4) ? std::stoul(argv[4]) : 0;
+	const std::string ext = (argc > 5) ? argv[5] : ".txt";
+
+	// Places scaled to the number of agents, coordinates in km
+	PopulationSettings settings = PopulationSettings::scaled(n_agents);
+	settings.x_max = 100.0;
+	settings.y_max = 100.0;
+
+	auto start = std::chrono::steady_clock::now();
+
+	PopulationGenerator generator(settings, seed, n_threads);
+	generator.write_households(prefix + "_households" + ext);
+	generator.write_schools(prefix + "_schools" + ext);
+	generator.write_workplaces(prefix + "_workplaces" + ext);
+	generator.write_agents(prefix + "_agents" + ext);
+
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Generated " << n_agents << " agents, " << settings.n_households
+				<< " households, " << settings.n_schools << " schools, and "
+				<< settings.n_workplaces << " workplaces using "
+				<< generator.get_number_of_threads() << " threads in "
+				<< std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+				<< " ms" << std::endl;
+}
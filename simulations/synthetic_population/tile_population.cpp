@@ -0,0 +1,42 @@
+#include "../../include/io_operations/population_tiling.h"
+#include <chrono>
+
+/*****************************************************
+ *
+ * Larger population made of copies of the New Rochelle
+ * population
+ *
+ * Usage: ./tiling_exe [tiles] [output prefix]
+ * 			[commuter fraction] [seed] [extension]
+ *
+ * Writes households, schools, workplaces, and agents
+ * files named prefix + "_households" + extension etc.;
+ * extension .txt.gz compresses the output
+ *
+ ******************************************************/
+
+int main(int argc, char* argv[])
+{
+	const int n_tiles = (argc > 1) ? std::stoi(argv[1]) : 10;
+	const std::string prefix = (argc > 2) ? argv[2] : "tiled";
+	const double commuters = (argc > 3) ? std::stod(argv[3]) : 0.0;
+	const unsigned int seed = (argc > 4) ? std::stoul(argv[4]) : 0;
+	const std::string ext = (argc > 5) ? argv[5] : ".txt";
+
+	// Population to replicate
+	const std::string data_dir("../NewRochelle_population/input_data/");
+
+	auto start = std::chrono::steady_clock::now();
+
+	PopulationTiling tiling(data_dir + "NR_households.txt", data_dir + "NR_schools.txt",
+							data_dir + "NR_workplaces.txt", data_dir + "NR_agents.txt");
+	tiling.write(prefix + "_households" + ext, prefix + "_schools" + ext,
+					prefix + "_workplaces" + ext, prefix + "_agents" + ext,
+					n_tiles, commuters, seed);
+
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Wrote " << n_tiles << " tiles, "
+				<< static_cast<long long>(n_tiles)*tiling.get_number_of_agents() << " agents, in "
+				<< std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+				<< " ms" << std::endl;
+}
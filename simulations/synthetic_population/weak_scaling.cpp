@@ -0,0 +1,77 @@
+#include "../../include/abm.h"
+#include "../../include/io_operations/population_tiling.h"
+#include <chrono>
+
+/*****************************************************
+ *
+ * Weak scaling of the New Rochelle ABM - time of
+ * transmit_infection for populations made of 1, 10,
+ * ... copies of New Rochelle with the same number of
+ * initially infected per copy
+ *
+ * Usage: ./weak_scaling_exe [tiles, comma separated]
+ * 			[steps] [commuter fraction]
+ *
+ * Results are saved in weak_scaling.txt, one line per
+ * population size
+ *
+ ******************************************************/
+
+int main(int argc, char* argv[])
+{
+	const std::string tiles_arg = (argc > 1) ? argv[1] : "1,10";
+	const int n_steps = (argc > 2) ? std::stoi(argv[2]) : 100;
+	const double commuters = (argc > 3) ? std::stod(argv[3]) : 0.0;
+
+	std::vector<int> tiles;
+	std::istringstream tiles_in(tiles_arg);
+	std::string entry;
+	while (std::getline(tiles_in, entry, ','))
+		tiles.push_back(std::stoi(entry));
+
+	// Time in days, initially infected in each copy
+	const double dt = 0.25;
+	const int ninf0 = 10;
+	const unsigned int seed = 7;
+
+	const std::string data_dir("../NewRochelle_population/input_data/");
+	const std::string prefix("weak_scaling_tiled");
+	std::map<std::string, std::string> dfiles =
+		{ {"mortality", data_dir + "age_dist_mortality.txt"} };
+
+	PopulationTiling tiling(data_dir + "NR_households.txt", data_dir + "NR_schools.txt",
+							data_dir + "NR_workplaces.txt", data_dir + "NR_agents.txt");
+
+	std::ofstream out("weak_scaling.txt");
+	out << "// tiles, agents, loading time [ms], time per step [ms], time per step and agent [ns], infected\n";
+	for (const int k : tiles){
+		tiling.write(prefix + "_households.txt", prefix + "_schools.txt",
+						prefix + "_workplaces.txt", prefix + "_agents.txt", k, commuters, seed);
+
+		auto start = std::chrono::steady_clock::now();
+		ABM abm(dt, data_dir + "infection_parameters.txt", dfiles);
+		abm.create_households(prefix + "_households.txt");
+		abm.create_schools(prefix + "_schools.txt");
+		abm.create_workplaces(prefix + "_workplaces.txt");
+		abm.create_agents(prefix + "_agents.txt");
+		auto loaded = std::chrono::steady_clock::now();
+
+		abm.set_seed(seed);
+		abm.infect_random_agents(ninf0*k);
+		auto begin = std::chrono::steady_clock::now();
+		for (int ti = 0; ti < n_steps; ++ti)
+			abm.transmit_infection();
+		auto end = std::chrono::steady_clock::now();
+
+		const double n_agents = static_cast<double>(abm.get_vector_of_agents().size());
+		const double load_ms = std::chrono::duration<double, std::milli>(loaded - start).count();
+		const double step_ms = std::chrono::duration<double, std::milli>(end - begin).count()/n_steps;
+		out << k << " " << n_agents << " " << load_ms << " " << step_ms << " "
+			<< 1.0e6*step_ms/n_agents << " " << abm.get_total_infected() << std::endl;
+		std::cout << k << " tiles, " << n_agents << " agents: " << step_ms
+				  << " ms per step, " << 1.0e6*step_ms/n_agents << " ns per agent" << std::endl;
+	}
+
+	for (const std::string kind : {"households", "schools", "workplaces", "agents"})
+		std::remove((prefix + "_" + kind + ".txt").c_str());
+}
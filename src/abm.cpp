@@ -26,34 +26,200 @@ void ABM::load_infection_parameters(const std::string infile)
 {
 	// Load parameters
 	LoadParameters ldparam;
-	infection_parameters = ldparam.load_parameter_map(infile);
+	std::shared_ptr<ModelParameters> loaded = std::make_shared<ModelParameters>(*parameters);
+	loaded->infection_parameters = ldparam.load_parameter_map(infile);
+	parameters = loaded;
 
+	set_infection_distributions();
+}
+
+// Send distributions and probabilities to the Infection object
+void ABM::set_infection_distributions()
+{
 	// Set infection distributions
-	infection.set_latency_distribution(infection_parameters.at("latency log-normal mean"),
-					infection_parameters.at("latency log-normal standard deviation"));	
-	infection.set_inf_variability_distribution(infection_parameters.at("agent variability gamma shape"),
-					infection_parameters.at("agent variability gamma scale"));
-	infection.set_onset_to_death_distribution(infection_parameters.at("otd logn mean"), 
-					infection_parameters.at("otd logn std"));
+	infection.set_latency_distribution(infection_parameters().at("latency log-normal mean"),
+					infection_parameters().at("latency log-normal standard deviation"));	
+	infection.set_inf_variability_distribution(infection_parameters().at("agent variability gamma shape"),
+					infection_parameters().at("agent variability gamma scale"));
+	infection.set_onset_to_death_distribution(infection_parameters().at("otd logn mean"), 
+					infection_parameters().at("otd logn std"));
 	// Set single-number probabilities
-	infection.set_other_probabilities(infection_parameters.at("fraction exposed never symptomatic"));
+	infection.set_other_probabilities(infection_parameters().at("fraction exposed never symptomatic"));
+}
+
+// Name of the absenteeism correction of a school type
+std::string ABM::school_absenteeism_parameter(const std::string& school_type) const
+{
+	if (school_type == "daycare")
+		return "daycare absenteeism correction";
+	else if (school_type == "primary" || school_type == "middle")
+		return "primary and middle school absenteeism correction";
+	else if (school_type == "high")
+		return "high school absenteeism correction";
+	else if (school_type == "college")
+		return "college absenteeism correction";
+	return "";
+}
+
+// Replace values of some infection parameters
+void ABM::set_infection_parameters(const std::map<std::string, double>& overrides)
+{
+	// All or nothing
+	for (const auto& entry : overrides)
+		if (infection_parameters().find(entry.first) == infection_parameters().end())
+			throw std::invalid_argument("Unknown infection parameter: " + entry.first);
+
+	// Parameters used by each type of places
+	const std::vector<std::string> house_names = {"household scaling parameter",
+			"severity correction", "household transmission rate",
+			"transmission rate of home isolated"};
+	const std::vector<std::string> school_names = {"severity correction",
+			"school employee absenteeism correction", "school employee transmission rate",
+			"school transmission rate", "daycare absenteeism correction",
+			"primary and middle school absenteeism correction",
+			"high school absenteeism correction", "college absenteeism correction"};
+	const std::vector<std::string> work_names = {"severity correction",
+			"work absenteeism correction", "workplace transmission rate"};
+	const std::vector<std::string> hospital_names = {"severity correction",
+			"healthcare employees transmission rate", "hospital patients transmission rate",
+			"hospital tested transmission rate", "hospitalized transmission rate",
+			"hospitalized ICU transmission rate", "time in hospital", "time in ICU",
+			"time in hospital after ICU", "time before death to ICU",
+			"oth gamma shape", "oth gamma scale"};
+	const std::vector<std::string> testing_names = {"fraction to get tested",
+			"exposed fraction to get tested", "fraction false negative",
+			"fraction false positive", "time from decision to test",
+			"time from test to results", "start testing"};
+	auto uses = [&overrides](const std::vector<std::string>& names){
+		for (const auto& name : names)
+			if (overrides.find(name) != overrides.end())
+				return true;
+		return false;
+	};
+
+	// Copies of the model keep the old parameters
+	std::shared_ptr<ModelParameters> changed = std::make_shared<ModelParameters>(*parameters);
+	for (const auto& entry : overrides)
+		changed->infection_parameters.at(entry.first) = entry.second;
+	parameters = changed;
+	set_infection_distributions();
+
+	// Only the affected places
+	if (uses(house_names)){
+		for (auto& house : households){
+			house.set_size_correction(infection_parameters().at("household scaling parameter"));
+			house.set_severity_correction(infection_parameters().at("severity correction"));
+			house.set_transmission_rate(infection_parameters().at("household transmission rate"));
+			house.set_home_isolated_transmission_rate(
+						infection_parameters().at("transmission rate of home isolated"));
+		}
+	}
+	if (uses(school_names)){
+		for (auto& school : schools){
+			school.set_severity_correction(infection_parameters().at("severity correction"));
+			school.set_transmission_rate(infection_parameters().at("school transmission rate"));
+			school.change_employee_transmission_rate(
+						infection_parameters().at("school employee transmission rate"));
+			school.set_absenteeism_corrections(
+						infection_parameters().at("school employee absenteeism correction"),
+						infection_parameters().at(school_absenteeism_parameter(school.get_type())));
+		}
+	}
+	if (uses(work_names)){
+		for (auto& work : workplaces){
+			work.set_severity_correction(infection_parameters().at("severity correction"));
+			work.set_absenteeism_correction(infection_parameters().at("work absenteeism correction"));
+			work.set_transmission_rate(infection_parameters().at("workplace transmission rate"));
+		}
+	}
+	if (!hospitals.empty() && uses(hospital_names))
+		set_hospital_parameters();
+	if (transitions.testing_enabled() && uses(testing_names))
+		set_testing_parameters();
+}
+
+// Parameters of hospitals and of hospital treatment
+void ABM::set_hospital_parameters()
+{
+	for (auto& hospital : hospitals){
+		hospital.set_severity_correction(infection_parameters().at("severity correction"));
+		hospital.set_transmission_rate(infection_parameters().at("healthcare employees transmission rate"));
+		hospital.set_patient_transmission_rates(
+					infection_parameters().at("hospital patients transmission rate"),
+					infection_parameters().at("hospital tested transmission rate"),
+					infection_parameters().at("hospitalized transmission rate"),
+					infection_parameters().at("hospitalized ICU transmission rate"));
+	}
+	infection.set_onset_to_hospitalization_distribution(infection_parameters().at("oth gamma shape"),
+					infection_parameters().at("oth gamma scale"));
+	transitions.set_hospital_parameters(infection_parameters());
+}
+
+// Start testing with a limited capacity
+void ABM::set_testing(const int tests_per_day, const int max_waiting)
+{
+	if (tests_per_day < 1)
+		throw std::invalid_argument("Number of tests per day needs to be positive");
+	if (max_waiting < 0)
+		throw std::invalid_argument("Number of agents waiting for a test can't be negative");
+	transitions.set_testing_capacity(tests_per_day, max_waiting);
+	set_testing_parameters();
+}
+
+// Probabilities and delays of testing
+void ABM::set_testing_parameters()
+{
+	infection.set_testing_probabilities(infection_parameters().at("fraction to get tested"),
+					infection_parameters().at("exposed fraction to get tested"),
+					infection_parameters().at("fraction false negative"),
+					infection_parameters().at("fraction false positive"));
+	transitions.set_testing_parameters(infection_parameters());
+}
+
+// Compile a schedule of interventions for this model
+void ABM::set_intervention_schedule(const InterventionSchedule& schedule)
+{
+	interventions = schedule;
+	interventions.compile(dt, static_cast<int>(schools.size()), static_cast<int>(workplaces.size()));
+	intervention_phase = -1;
+}
+
+// Phase of the current step, one comparison while it doesn't change
+void ABM::update_intervention_phase()
+{
+	const int step = static_cast<int>(std::lround(time/dt));
+	const int n_phases = interventions.get_number_of_phases();
+	if (intervention_phase + 1 >= n_phases || step < interventions.get_start_step(intervention_phase + 1))
+		return;
+	while (intervention_phase + 1 < n_phases && step >= interventions.get_start_step(intervention_phase + 1))
+		++intervention_phase;
+	if (interventions.get_open_schools(intervention_phase).size() != static_cast<int>(schools.size()) 
+			|| interventions.get_open_workplaces(intervention_phase).size() != static_cast<int>(workplaces.size()))
+		throw std::runtime_error("Intervention schedule was set before creating all the places");
 }
 
 // Load age-dependent distributions, store in a map of maps
 void ABM::load_age_dependent_distributions(const std::map<std::string, std::string> dist_files)
 {
 	LoadParameters ldparam;
+	std::shared_ptr<ModelParameters> loaded = std::make_shared<ModelParameters>(*parameters);
 	std::map<std::string, double> one_file;
 	for (const auto& dfile : dist_files){
 		one_file = ldparam.load_age_dependent(dfile.second);
 		for (const auto& entry : one_file){
-			age_dependent_distributions[dfile.first][entry.first] = entry.second;
+			loaded->age_dependent_distributions[dfile.first][entry.first] = entry.second;
 		}
 		one_file.clear();
 	}
+	parameters = loaded;
 
 	// Send to Infection class for further processing 
-	infection.set_mortality_rates(age_dependent_distributions.at("mortality"));
+	infection.set_mortality_rates(age_dependent_distributions().at("mortality"));
+	// Only needed with hospitals
+	if (age_dependent_distributions().count("hospitalization"))
+		infection.set_hospitalization_rates(age_dependent_distributions().at("hospitalization"));
+	if (age_dependent_distributions().count("ICU"))
+		infection.set_ICU_rates(age_dependent_distributions().at("ICU"));
 }
 
 // Generate and store household objects
@@ -61,18 +227,33 @@ void ABM::create_households(const std::string fname)
 {
 	// Read the whole file
 	std::vector<std::vector<std::string>> file = read_object(fname);
+	InputValidator check(fname);
+	std::vector<Household> loaded;
 	
 	// One household per line
+	int line = 0;
 	for (auto& house : file){
+		if (!check.next_line(++line, house, 3))
+			continue;
+		// IDs have to correspond to positions in the vector
+		const int ID = check.get_int(house, 0, "household ID");
+		if (ID != static_cast<int>(households.size() + loaded.size()) + 1)
+			check.add_error("household IDs not continuous, expected " 
+					+ std::to_string(households.size() + loaded.size() + 1));
 		// Extract properties, add infection parameters
-		Household temp_house(std::stoi(house.at(0)), 
-			std::stod(house.at(1)), std::stod(house.at(2)),
-			infection_parameters.at("household scaling parameter"),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("household transmission rate"));
-		// Store 
-		households.push_back(temp_house);
+		Household temp_house(ID, 
+			check.get_double(house, 1, "x coordinate"), check.get_double(house, 2, "y coordinate"),
+			infection_parameters().at("household scaling parameter"),
+			infection_parameters().at("severity correction"),
+			infection_parameters().at("household transmission rate"));
+		temp_house.set_home_isolated_transmission_rate(
+						infection_parameters().at("transmission rate of home isolated"));
+		loaded.push_back(temp_house);
 	}
+
+	// Store if all correct
+	check.throw_if_invalid();
+	households.insert(households.end(), loaded.begin(), loaded.end());
 }
 
 // Generate and store school objects
@@ -80,35 +261,45 @@ void ABM::create_schools(const std::string fname)
 {
 	// Read the whole file
 	std::vector<std::vector<std::string>> file = read_object(fname);
+	InputValidator check(fname);
+	std::vector<School> loaded;
 	
-	// One workplace per line
+	// One school per line
+	int line = 0;
 	for (auto& school : file){
+		if (!check.next_line(++line, school, 4))
+			continue;
+		// IDs have to correspond to positions in the vector
+		const int ID = check.get_int(school, 0, "school ID");
+		if (ID != static_cast<int>(schools.size() + loaded.size()) + 1)
+			check.add_error("school IDs not continuous, expected " 
+					+ std::to_string(schools.size() + loaded.size() + 1));
+
 		// Extract properties, add infection parameters
 
 		// School-type dependent absenteeism
 		double psi = 0.0;
 		std::string school_type = school.at(3);
-		if (school_type == "daycare")
- 			psi = infection_parameters.at("daycare absenteeism correction");
-		else if (school_type == "primary" || school_type == "middle")
- 			psi = infection_parameters.at("primary and middle school absenteeism correction");
-		else if (school_type == "high")
- 			psi = infection_parameters.at("high school absenteeism correction");
-		else if (school_type == "college")
- 			psi = infection_parameters.at("college absenteeism correction");
+		const std::string psi_name = school_absenteeism_parameter(school_type);
+		if (!psi_name.empty())
+ 			psi = infection_parameters().at(psi_name);
 		else
-			throw std::invalid_argument("Wrong school type: " + school_type);
-
-        School temp_school(std::stoi(school.at(0)),
-                           std::stod(school.at(1)), std::stod(school.at(2)),
-                           infection_parameters.at("severity correction"),
-                           infection_parameters.at("school employee absenteeism correction"), psi,
-                           infection_parameters.at("school employee transmission rate"),
-                           infection_parameters.at("school transmission rate"));
-
-		// Store 
-		schools.push_back(temp_school);
+			check.add_error("Wrong school type: " + school_type);
+
+        School temp_school(ID,
+                           check.get_double(school, 1, "x coordinate"), 
+						   check.get_double(school, 2, "y coordinate"),
+                           infection_parameters().at("severity correction"),
+                           infection_parameters().at("school employee absenteeism correction"), psi,
+                           infection_parameters().at("school employee transmission rate"),
+                           infection_parameters().at("school transmission rate"));
+		temp_school.set_type(school_type);
+		loaded.push_back(temp_school);
 	}
+
+	// Store if all correct
+	check.throw_if_invalid();
+	schools.insert(schools.end(), loaded.begin(), loaded.end());
 }
 
 // Generate and store workplace objects
@@ -116,19 +307,82 @@ void ABM::create_workplaces(const std::string fname)
 {
 	// Read the whole file
 	std::vector<std::vector<std::string>> file = read_object(fname);
+	InputValidator check(fname);
+	std::vector<Workplace> loaded;
 	
 	// One workplace per line
+	int line = 0;
 	for (auto& work : file){
+		if (!check.next_line(++line, work, 3))
+			continue;
+		// IDs have to correspond to positions in the vector
+		const int ID = check.get_int(work, 0, "workplace ID");
+		if (ID != static_cast<int>(workplaces.size() + loaded.size()) + 1)
+			check.add_error("workplace IDs not continuous, expected " 
+					+ std::to_string(workplaces.size() + loaded.size() + 1));
 		// Extract properties, add infection parameters
-		Workplace temp_work(std::stoi(work.at(0)), 
-			std::stod(work.at(1)), std::stod(work.at(2)),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("work absenteeism correction"),
-			infection_parameters.at("workplace transmission rate"));
-
-		// Store 
-		workplaces.push_back(temp_work);
+		Workplace temp_work(ID, 
+			check.get_double(work, 1, "x coordinate"), check.get_double(work, 2, "y coordinate"),
+			infection_parameters().at("severity correction"),
+			infection_parameters().at("work absenteeism correction"),
+			infection_parameters().at("workplace transmission rate"));
+		loaded.push_back(temp_work);
 	}
+
+	// Store if all correct
+	check.throw_if_invalid();
+	workplaces.insert(workplaces.end(), loaded.begin(), loaded.end());
+}
+
+// Generate and store hospital objects
+void ABM::create_hospitals(const std::string fname)
+{
+	if (!age_dependent_distributions().count("hospitalization") 
+			|| !age_dependent_distributions().count("ICU"))
+		throw std::invalid_argument("Hospitals require hospitalization and ICU age-dependent distributions");
+
+	// Read the whole file
+	std::vector<std::vector<std::string>> file = read_object(fname);
+	InputValidator check(fname);
+	const int n_workplaces = static_cast<int>(workplaces.size());
+	std::vector<Hospital> loaded;
+	
+	// One hospital per line
+	int line = 0;
+	for (auto& hospital : file){
+		if (!check.next_line(++line, hospital, 3))
+			continue;
+		// IDs have to correspond to positions in the vector
+		const int ID = check.get_int(hospital, 0, "hospital ID");
+		if (ID != static_cast<int>(hospitals.size() + loaded.size()) + 1)
+			check.add_error("hospital IDs not continuous, expected " 
+					+ std::to_string(hospitals.size() + loaded.size() + 1));
+		// Extract properties, add infection parameters
+		Hospital temp_hospital(ID, 
+			check.get_double(hospital, 1, "x coordinate"), check.get_double(hospital, 2, "y coordinate"),
+			infection_parameters().at("severity correction"),
+			infection_parameters().at("healthcare employees transmission rate"),
+			infection_parameters().at("hospital patients transmission rate"),
+			infection_parameters().at("hospital tested transmission rate"),
+			infection_parameters().at("hospitalized transmission rate"),
+			infection_parameters().at("hospitalized ICU transmission rate"));
+		// Employees, if any
+		if (hospital.size() > 3){
+			const int work_ID = check.get_int(hospital, 3, "staff workplace ID");
+			if (work_ID != 0)
+				check.check_ID(work_ID, n_workplaces, "staff workplace ID");
+			temp_hospital.set_staff_workplace_ID(work_ID);
+		}
+		loaded.push_back(temp_hospital);
+	}
+	// Hospital transitions need at least one hospital to send agents to
+	if (loaded.empty())
+		check.add_error("no hospitals in the file");
+
+	// Store if all correct
+	check.throw_if_invalid();
+	hospitals.insert(hospitals.end(), loaded.begin(), loaded.end());
+	set_hospital_parameters();
 }
 
 
@@ -158,20 +412,51 @@ void ABM::load_agents(const std::string fname, const int ninf0)
 	// Counter for agent IDs
 	int agent_ID = 1;
 
-	// One agent per line, with properties as defined in the line
-	for (auto agent : file){
-		// Agent status
-		bool student = false, works = false, worksSch = false;
-		int house_ID = -1;
+	// Places need to be loaded first for the cross-reference checks
+	InputValidator check(fname);
+	const int n_households = static_cast<int>(households.size());
+	const int n_schools = static_cast<int>(schools.size());
+	const int n_workplaces = static_cast<int>(workplaces.size());
+	std::vector<Agent> loaded;
 
-		house_ID = std::stoi(agent.at(5));
+	// One agent per line, with properties as defined in the line
+	int line = 0;
+	for (auto& agent : file){
+		if (!check.next_line(++line, agent, 10))
+			continue;
 
-		// Check if agent is a student
-		if (std::stoi(agent.at(0)) == 1)
-			student = true;
-		// Check if agents works
-		if (std::stoi(agent.at(1)) == 1)
-			works = true;
+		// Agent status
+		const bool student = check.get_flag(agent, 0, "student flag");
+		const bool works = check.get_flag(agent, 1, "works flag");
+		const int age = check.get_int(agent, 2, "age");
+		const double xi = check.get_double(agent, 3, "x coordinate");
+		const double yi = check.get_double(agent, 4, "y coordinate");
+		const int house_ID = check.get_int(agent, 5, "household ID");
+		const int school_ID = check.get_int(agent, 6, "school ID");
+		const bool worksSch = check.get_flag(agent, 7, "school employee flag");
+		const int work_ID = check.get_int(agent, 8, "work ID");
+		const bool infected_in_file = check.get_flag(agent, 9, "infection status");
+
+		// Consistency and cross-references
+		if (age < 0)
+			check.add_error("negative age " + std::to_string(age));
+		check.check_ID(house_ID, n_households, "household ID");
+		if (student)
+			check.check_ID(school_ID, n_schools, "school ID");
+		else if (school_ID != 0)
+			check.add_error("agent is not a student but school ID is not 0");
+		if (works){
+			// School employees work at a school
+			if (worksSch)
+				check.check_ID(work_ID, n_schools, "school ID of a school employee");
+			else
+				check.check_ID(work_ID, n_workplaces, "work ID");
+		} else {
+			if (work_ID != 0)
+				check.add_error("agent does not work but work ID is not 0");
+			if (worksSch)
+				check.add_error("agent does not work but is marked as a school employee");
+		}
 
 		// Random or from the input file
 		bool infected = false;
@@ -183,18 +468,14 @@ void ABM::load_agents(const std::string fname, const int ninf0)
                 n_infected_tot++;
             }
         } else {
-            if (std::stoi(agent.at(9)) == 1){
+            if (infected_in_file){
                 infected = true;
                 n_infected_tot++;
             }
         }
 
-        if (std::stoi(agent.at(7)) == 1)
-            worksSch = true;
-
-		Agent temp_agent(student, works, std::stoi(agent.at(2)),
-			std::stod(agent.at(3)), std::stod(agent.at(4)), house_ID,
-			std::stoi(agent.at(6)), worksSch, std::stoi(agent.at(8)), infected);
+		Agent temp_agent(student, works, age, xi, yi, house_ID,
+			school_ID, worksSch, work_ID, infected);
 
 		// Set Agent ID
 		temp_agent.set_ID(agent_ID++);
@@ -203,14 +484,18 @@ void ABM::load_agents(const std::string fname, const int ninf0)
 		if (temp_agent.infected() == true)
 			initial_exposed(temp_agent);
 
-		// Store
-		agents.push_back(temp_agent);
+		loaded.push_back(temp_agent);
 	}
+
+	// Store if all correct
+	check.throw_if_invalid();
+	agents.insert(agents.end(), loaded.begin(), loaded.end());
 }
 
 // Assign agents to households, schools, and workplaces
 void ABM::register_agents()
 {
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::register_agents);
 	int house_ID = 0, school_ID = 0, work_ID = 0;
 	int agent_ID = 0;
 	bool infected = false;
@@ -247,6 +532,32 @@ void ABM::register_agents()
 	} 
 }
 
+// Infect randomly chosen susceptible agents
+void ABM::infect_random_agents(const int ninf)
+{
+	const int n_agents = static_cast<int>(agents.size());
+	for (int i=0; i<ninf; ++i){
+		Agent& agent = agents[infection.get_random_agent_ID(n_agents) - 1];
+		if (agent.infected() || agent.removed())
+			continue;
+		agent.set_infected(true);
+		initial_exposed(agent);
+		n_infected_tot++;
+	}
+}
+
+// Restart all random number generators
+void ABM::set_seed(const unsigned int seed)
+{
+	// Separate streams for the infection model and
+	// for sampling of places of infection
+	std::seed_seq seq = {seed};
+	std::vector<unsigned int> seeds(2);
+	seq.generate(seeds.begin(), seeds.end());
+	infection.set_seed(seeds[0]);
+	transitions.set_seed(seeds[1]);
+}
+
 // Initial set-up of exposed agents
 void ABM::initial_exposed(Agent& agent)
 {
@@ -254,11 +565,11 @@ void ABM::initial_exposed(Agent& agent)
     // Total latency period
     double latency = infection.latency();
     // Portion of latency when the agent is not infectious
-    double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+    double dt_ninf = std::min(infection_parameters().at("time from exposed to infectiousness"), latency);
 
     if (never_sy){
         // Set to total latency + infectiousness duration
-        double rec_time = infection_parameters.at("recovery time");
+        double rec_time = infection_parameters().at("recovery time");
         agent.set_latency_duration(latency + rec_time);
         agent.set_latency_end_time(time);
         agent.set_infectiousness_start_time(time, dt_ninf);
@@ -280,6 +591,7 @@ void ABM::initial_exposed(Agent& agent)
 /// Transmit infection according to Infection model
 void ABM::transmit_infection() 
 { 
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::transmission);
 	// Compute infectious agents contributions
 	// to probability sums in each place as
 	// well as total place contributions
@@ -289,7 +601,7 @@ void ABM::transmit_infection()
 	compute_state_transitions();
 	
 	// Reset the place sums
-	contributions.reset_sums(households, schools, workplaces);
+	reset_place_sums();
 
 	// Increase the time
 	advance_in_time();	
@@ -298,6 +610,33 @@ void ABM::transmit_infection()
 // Count contributions of all infectious agents in each place
 void ABM::compute_place_contributions()
 {
+	compute_agent_contributions();
+	total_place_contributions();
+}
+
+// Total contributions of places, with factors of interventions
+void ABM::total_place_contributions()
+{
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::place_contributions);
+	update_intervention_phase();
+	if (intervention_phase < 0){
+		contributions.total_place_contributions(households, schools, workplaces);
+	} else {
+		contributions.total_place_contributions(households, schools, workplaces,
+						interventions.get_school_factors(intervention_phase),
+						interventions.get_workplace_factors(intervention_phase),
+						interventions.get_open_schools(intervention_phase),
+						interventions.get_open_workplaces(intervention_phase));
+	}
+	// Hospitals stay open
+	if (!hospitals.empty())
+		contributions.total_hospital_contributions(hospitals, workplaces);
+}
+
+// Add contributions of infectious agents to their places
+void ABM::compute_agent_contributions()
+{
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::agent_contributions);
 	for (const auto& agent : agents){
 
 		// Removed and susceptible don't contribute
@@ -314,6 +653,8 @@ void ABM::compute_place_contributions()
 		if (agent.exposed() == true){
 			contributions.compute_exposed_contributions(agent, time, households, 
 							schools, workplaces);
+		}else if (agent.hospitalized() == true){
+			contributions.compute_hospitalized_contributions(agent, hospitals);
 		}else if (agent.symptomatic() == true){
 			contributions.compute_symptomatic_contributions(agent, time, households, 
 							schools, workplaces);
@@ -321,14 +662,13 @@ void ABM::compute_place_contributions()
 			throw std::runtime_error("Agent does not have any state");
 		}
 	}
-	contributions.total_place_contributions(households, schools, 
-											workplaces);
 }
 
 // Determine infection propagation and
 // state changes 
 void ABM::compute_state_transitions()
 {
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::state_transitions);
 	int newly_infected = 0, is_recovered = 0;
 	// First entry is one if agent recovered, second if agent died
 	std::vector<int> removed = {0,0};
@@ -342,21 +682,27 @@ void ABM::compute_state_transitions()
 
 		if (agent.infected() == false){
 			newly_infected = transitions.susceptible_transitions(agent, time,
-							dt, infection, households, schools, workplaces, infection_parameters, agents);
+							dt, infection, households, schools, workplaces, infection_parameters(), agents);
 			n_infected_tot += newly_infected;
 		}else if (agent.exposed() == true){
 			is_recovered = transitions.exposed_transitions(agent, infection, time, dt, 
-										households, schools, workplaces, infection_parameters);
+										households, schools, workplaces, infection_parameters());
 			n_recovered_tot += is_recovered;
 		}else if (agent.symptomatic() == true){
 			removed = transitions.symptomatic_transitions(agent, time, dt,
-							infection, households, schools, workplaces, infection_parameters);
+							infection, households, schools, workplaces, infection_parameters());
 			n_recovered_tot += removed.at(0);
 			n_dead_tot += removed.at(1);
+			if (removed.at(1) == 1)
+				add_death_to_contact_totals(agent);
 		}else{
 			throw std::runtime_error("Agent does not have any infection-related state");
 		}		
 	}
+
+	// Treatment changes and testing that are due
+	transitions.hospital_transitions(time, agents, hospitals, infection);
+	transitions.testing_transitions(time, agents, infection);
 }
 
 //
@@ -403,6 +749,61 @@ int ABM::get_num_removed() const
     return removed_count;
 }
 
+// Count agents isolated at home
+int ABM::get_num_home_isolated() const
+{
+    int isolated_count = 0;
+    for (const auto& agent : agents){
+        if (agent.home_isolated())
+            ++isolated_count;
+    }
+    return isolated_count;
+}
+
+// Count agents in hospitals
+int ABM::get_num_hospitalized() const
+{
+    int hospitalized_count = 0;
+    for (const auto& agent : agents){
+        if (agent.hospitalized())
+            ++hospitalized_count;
+    }
+    return hospitalized_count;
+}
+
+// Count agents in ICU
+int ABM::get_num_ICU() const
+{
+    int ICU_count = 0;
+    for (const auto& agent : agents){
+        if (agent.in_ICU())
+            ++ICU_count;
+    }
+    return ICU_count;
+}
+
+//
+// Event logging
+//
+
+// Start logging agent transitions
+void ABM::enable_event_log(const std::string filename)
+{
+	disable_event_log();
+	event_log = std::make_shared<EventLog>(filename, dt);
+	transitions.set_event_log(event_log.get());
+}
+
+// Write all the logged events and stop logging
+void ABM::disable_event_log()
+{
+	transitions.set_event_log(nullptr);
+	if (event_log){
+		event_log->flush();
+		event_log.reset();
+	}
+}
+
 //
 // I/O
 //
@@ -410,6 +811,7 @@ int ABM::get_num_removed() const
 // General function for reading an object from a file
 std::vector<std::vector<std::string>> ABM::read_object(std::string fname)
 {
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::read_input);
 	// AbmIO settings
 	std::string delim(" ");
 	bool sflag = true;
@@ -433,10 +835,11 @@ std::vector<std::vector<std::string>> ABM::read_object(std::string fname)
 // Save infection information
 void ABM::print_infection_parameters(const std::string filename) const
 {
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
 	FileHandler file(filename, std::ios_base::out | std::ios_base::trunc);
-	std::fstream &out = file.get_stream();	
+	std::iostream &out = file.get_stream();	
 
-	for (const auto& entry : infection_parameters){
+	for (const auto& entry : infection_parameters()){
 		out << entry.first << " " << entry.second << "\n";
 	}	
 }
@@ -444,10 +847,11 @@ void ABM::print_infection_parameters(const std::string filename) const
 // Save age-dependent distributions
 void ABM::print_age_dependent_distributions(const std::string filename) const
 {
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
 	FileHandler file(filename, std::ios_base::out | std::ios_base::trunc);
-	std::fstream &out = file.get_stream();	
+	std::iostream &out = file.get_stream();	
 
-	for (const auto& entry : age_dependent_distributions){
+	for (const auto& entry : age_dependent_distributions()){
 		out << entry.first << "\n";
 		for (const auto& e : entry.second)
 			out << e.first << " " << e.second << "\n";
@@ -474,6 +878,12 @@ void ABM::print_workplaces(const std::string fname) const
 	print_places<Workplace>(workplaces, fname);
 }
 
+// Save current hospital information to file 
+void ABM::print_hospitals(const std::string fname) const
+{
+	print_places<Hospital>(hospitals, fname);
+}
+
 // Save IDs of all agents in all households
 void ABM::print_agents_in_households(const std::string filename) const
 {
@@ -496,6 +906,7 @@ void ABM::print_agents_in_workplaces(const std::string filename) const
 // Save current agent information to file 
 void ABM::print_agents(const std::string fname) const
 {
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
 	// AbmIO settings
 	std::string delim(" ");
 	bool sflag = true;
@@ -506,42 +917,164 @@ void ABM::print_agents(const std::string fname) const
 	abm_io.write_vector<Agent>(agents);	
 }
 
+// Save states of all agents as a snapshot step
+void ABM::save_agent_states(AgentSnapshotWriter& writer) const
+{
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
+	std::vector<std::uint8_t>& states = writer.get_state_buffer();
+	if (states.size() != agents.size())
+		throw std::invalid_argument("Snapshot writer created for a different number of agents");
+
+	AgentStateCode code = AgentStateCode::susceptible;
+	for (size_t i = 0; i < agents.size(); ++i){
+		const Agent& agent = agents[i];
+		if (agent.get_dead())
+			code = AgentStateCode::dead;
+		else if (agent.get_recovered())
+			code = AgentStateCode::recovered;
+		else if (agent.exposed() && agent.recovering_exposed())
+			code = AgentStateCode::exposed_never_symptomatic;
+		else if (agent.exposed())
+			code = AgentStateCode::exposed;
+		else if (agent.symptomatic() && agent.dying())
+			code = AgentStateCode::symptomatic_dying;
+		else if (agent.symptomatic())
+			code = AgentStateCode::symptomatic_recovering;
+		else
+			code = AgentStateCode::susceptible;
+		std::uint8_t flags = 0;
+		if (agent.hospitalized())
+			flags |= static_cast<std::uint8_t>(AgentStateFlag::hospitalized);
+		if (agent.in_ICU())
+			flags |= static_cast<std::uint8_t>(AgentStateFlag::ICU);
+		if (agent.home_isolated())
+			flags |= static_cast<std::uint8_t>(AgentStateFlag::home_isolated);
+		if (agent.tested_positive())
+			flags |= static_cast<std::uint8_t>(AgentStateFlag::tested_positive);
+		states[i] = static_cast<std::uint8_t>(code) | flags;
+	}
+	writer.write_step(time);
+}
+
 // Missing descriptions in all these
 // The interior of collect_ should be part of the Agent class
 // i.e. the collection should be done in the class, and ABM
 // here should just call it 
 void ABM::collect_all_interactions(){
-    for (Agent& agent : agents){
- 		std::vector<int>& interactions = agent.get_all_interactions();
+	index_contacts();
+	for (std::size_t i = 0; i < agents.size(); ++i){
+ 		std::vector<int>& interactions = agents[i].get_all_interactions();
 		// Dead agent - enter -1
-		if (agent.get_dead()){
+		if (agents[i].get_dead())
 			interactions.push_back(-1);       
-		}else {
-			// First index: # of interactions Second index: # of dead
-			// Should be part of the agent class in it's entirety 
-        	std::vector<int> stats = agent.collect_interactions(agents);
-        	interactions.push_back(stats.at(0));
-		}
+		else
+        	interactions.push_back(contact_counter.get_number_of_contacts(i) 
+										- count_dead_contacts(agents[i]));
     }
 }
 
 void ABM::collect_dead_interactions() {
-    for (Agent& agent : agents){
- 		std::vector<int>& dead_interactions = agent.get_dead_interactions();
+	for (std::size_t i = 0; i < agents.size(); ++i){
+ 		std::vector<int>& dead_interactions = agents[i].get_dead_interactions();
  		// Dead agent - enter -1
-		if (agent.get_dead()){
+		if (agents[i].get_dead())
 			dead_interactions.push_back(-1);       
-		}else {  
-   			// First index: # of interactions Second index: # of dead
-        	std::vector<int> stats = agent.collect_interactions(agents);
-			// Should be part of the agent class in it's entirety
-			dead_interactions.push_back(stats.at(1));
-		}
+		else
+			dead_interactions.push_back(count_dead_contacts(agents[i]));
     }
 }
 
+std::pair<long long, long long> ABM::count_total_interactions()
+{
+	if (!has_contact_totals || !contact_counter.is_indexed(agents.size())){
+		index_contacts();
+		n_living_contacts = 0;
+		n_dead_contacts = 0;
+		for (std::size_t i = 0; i < agents.size(); ++i){
+			if (agents[i].get_dead())
+				continue;
+			n_living_contacts += contact_counter.get_number_of_contacts(i);
+			n_dead_contacts += count_dead_contacts(agents[i]);
+		}
+		has_contact_totals = true;
+	}
+	return std::make_pair(n_living_contacts - n_dead_contacts, n_dead_contacts);
+}
+
+// Index memberships for counting contacts, if needed
+void ABM::index_contacts()
+{
+	if (!contact_counter.is_indexed(agents.size()))
+		contact_counter.build_index(agents, static_cast<int>(households.size()), 
+					static_cast<int>(schools.size()), static_cast<int>(workplaces.size()));
+}
+
+// Agent is no longer a living agent with dead contacts, and
+// each of its living contacts has one more dead contact
+void ABM::add_death_to_contact_totals(const Agent& agent)
+{
+	if (!has_contact_totals)
+		return;
+	const int n_contacts = contact_counter.get_number_of_contacts(agent.get_ID()-1);
+	// Without the agent itself
+	const int n_dead = count_dead_contacts(agent) - 1;
+	n_living_contacts -= n_contacts;
+	n_dead_contacts += n_contacts - 2*n_dead;
+}
+
+// Dead contacts of an agent as dead members of the school S and the
+// workplace W, without the ones in both, plus dead household members
+// that are in neither of them
+int ABM::count_dead_contacts(const Agent& agent) const
+{
+	// School of a student and place of work, nullptr if none
+	auto places_of = [this](const Agent& member){
+		const Place* school = nullptr;
+		const Place* work = nullptr;
+		if (member.student())
+			school = &schools[member.get_school_ID()-1];
+		if (member.works()){
+			if (member.school_employee())
+				work = &schools[member.get_work_ID()-1];
+			else
+				work = &workplaces[member.get_work_ID()-1];
+		}
+		if (work == school)
+			work = nullptr;
+		return std::make_pair(school, work);
+	};
+	auto is_member = [this, &places_of](const int ID, const Place* place){
+		const std::pair<const Place*, const Place*> member_places = places_of(agents[ID-1]);
+		return place != nullptr && (member_places.first == place || member_places.second == place);
+	};
+
+	const std::pair<const Place*, const Place*> own = places_of(agent);
+	const Place* school = own.first;
+	const Place* work = own.second;
+	int n_dead = 0;
+	if (school != nullptr)
+		n_dead += school->get_number_of_dead();
+	if (work != nullptr)
+		n_dead += work->get_number_of_dead();
+	if (school != nullptr && work != nullptr){
+		// Only the shorter list needs to be checked
+		const bool school_first = school->get_number_of_dead() <= work->get_number_of_dead();
+		const Place* shorter = school_first ? school : work;
+		const Place* other = school_first ? work : school;
+		for (const int ID : shorter->get_dead_agent_IDs())
+			if (is_member(ID, other))
+				--n_dead;
+	}
+	for (const int ID : households[agent.get_household_ID()-1].get_dead_agent_IDs())
+		if (!is_member(ID, school) && !is_member(ID, work))
+			++n_dead;
+	return n_dead;
+}
+
 void ABM::output_interactions(std::string filename) {
-    std::ofstream out(filename);
+    ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
+    FileHandler file(filename, std::ios_base::out | std::ios_base::trunc);
+    std::iostream &out = file.get_stream();
     for (Agent& agent : agents){
         std::vector<int>& interactions = agent.get_all_interactions();
         out << agent.get_ID() << " ";
@@ -551,7 +1084,9 @@ void ABM::output_interactions(std::string filename) {
 }
 
 void ABM::output_dead_interactions(std::string filename) {
-    std::ofstream out(filename);
+    ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
+    FileHandler file(filename, std::ios_base::out | std::ios_base::trunc);
+    std::iostream &out = file.get_stream();
     for (Agent& agent : agents){
         std::vector<int>& dead_interactions = agent.get_dead_interactions();
         out << agent.get_ID() << " ";
@@ -560,5 +1095,16 @@ void ABM::output_dead_interactions(std::string filename) {
     }
 }
 
+// Save agent-place and agent-agent graphs
+void ABM::output_contact_network(const std::string& bipartite_name,
+					const std::string& projection_name, const ContactWeights& weights) const
+{
+	ABM_PERF_SCOPE(perf_stats, PerfPhase::output);
+	ContactNetwork network(static_cast<int>(agents.size()), households, schools, workplaces);
+	network.write_bipartite(bipartite_name, weights);
+	if (!projection_name.empty())
+		network.write_projection(projection_name, weights);
+}
+
 
 
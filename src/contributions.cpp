@@ -6,6 +6,9 @@
  * Functionality for computing of infection probability
  * contributions from agents to places and eventually 
  * mobility 
+ *
+ * Place IDs of agents are checked when the population
+ * is loaded, places are indexed without bounds checks
  * 
  ******************************************************/
 
@@ -24,20 +27,25 @@ void Contributions::compute_exposed_contributions(const Agent& agent, const doub
 	inf_var = agent.get_inf_variability_factor();
 
     // Household
-    Household& household = households.at(agent.get_household_ID()-1);
+    Household& household = households[agent.get_household_ID()-1];
+	// Isolated agents stay registered in other places but don't go there
+	if (agent.home_isolated()){
+		household.add_exposed_home_isolated(inf_var);
+		return;
+	}
     household.add_exposed(inf_var);
 
     // Other places
     if (agent.student() == true){
-        School& school = schools.at(agent.get_school_ID()-1);
+        School& school = schools[agent.get_school_ID()-1];
         school.add_exposed(inf_var);
     }
     if (agent.works() == true){
         if (agent.school_employee()){
-            School& sch = schools.at(agent.get_work_ID()-1);
+            School& sch = schools[agent.get_work_ID()-1];
             sch.add_exposed_employee(inf_var);
         } else {
-            Workplace& workplace = workplaces.at(agent.get_work_ID()-1);
+            Workplace& workplace = workplaces[agent.get_work_ID()-1];
             workplace.add_exposed(inf_var);
         }
     }
@@ -53,25 +61,40 @@ void Contributions::compute_symptomatic_contributions(const Agent& agent, const
 	inf_var = agent.get_inf_variability_factor();
 
     // Household
-    Household& household = households.at(agent.get_household_ID()-1);
+    Household& household = households[agent.get_household_ID()-1];
+	if (agent.home_isolated()){
+		household.add_symptomatic_home_isolated(inf_var);
+		return;
+	}
     household.add_symptomatic(inf_var);
 
     // Other places
     if (agent.student() == true){
-        School& school = schools.at(agent.get_school_ID()-1);
+        School& school = schools[agent.get_school_ID()-1];
         school.add_symptomatic(inf_var);
     }
     if (agent.works() == true){
         if (agent.school_employee()){
-            School& sch = schools.at(agent.get_work_ID()-1);
+            School& sch = schools[agent.get_work_ID()-1];
             sch.add_symptomatic_employee(inf_var);
         } else {
-            Workplace& workplace = workplaces.at(agent.get_work_ID()-1);
+            Workplace& workplace = workplaces[agent.get_work_ID()-1];
             workplace.add_symptomatic(inf_var);
         }
     }
 }
 
+// Contributions of a hospitalized agent, only to the hospital
+void Contributions::compute_hospitalized_contributions(const Agent& agent, 
+					std::vector<Hospital>& hospitals)
+{
+	Hospital& hospital = hospitals[agent.get_hospital_ID()-1];
+	if (agent.in_ICU())
+		hospital.add_hospitalized_ICU(agent.get_inf_variability_factor());
+	else
+		hospital.add_hospitalized(agent.get_inf_variability_factor());
+}
+
 // Compute the total contribution to infection probability at every place
 void Contributions::total_place_contributions(std::vector<Household>& households, 
 					std::vector<School>& schools, std::vector<Workplace>& workplaces)
@@ -83,6 +106,43 @@ void Contributions::total_place_contributions(std::vector<Household>& households
 	std::for_each(workplaces.begin(), workplaces.end(), infected_contribution);
 }
 
+// Total contributions of open places with factors of school and workplace transmission rates
+void Contributions::total_place_contributions(std::vector<Household>& households, 
+					std::vector<School>& schools, std::vector<Workplace>& workplaces,
+					const std::vector<double>& school_factors,
+					const std::vector<double>& workplace_factors,
+					const PlaceActivation& open_schools, const PlaceActivation& open_workplaces)
+{
+	auto infected_contribution = [](Place& place){ place.compute_infected_contribution(); };
+	std::for_each(households.begin(), households.end(), infected_contribution);
+
+	// Factors and open places are compiled for these places, 
+	// closed ones contribute nothing to agents that visit them
+	for (std::size_t i = 0; i < schools.size(); ++i){
+		schools[i].compute_infected_contribution();
+		schools[i].scale_infected_contribution(open_schools.is_open(i) ? school_factors[i] : 0.0);
+	}
+	for (std::size_t i = 0; i < workplaces.size(); ++i){
+		workplaces[i].compute_infected_contribution();
+		workplaces[i].scale_infected_contribution(open_workplaces.is_open(i) ? workplace_factors[i] : 0.0);
+	}
+}
+
+// Total contributions of hospitals, also to their employees
+void Contributions::total_hospital_contributions(std::vector<Hospital>& hospitals, 
+					std::vector<Workplace>& workplaces)
+{
+	for (auto& hospital : hospitals){
+		const int work_ID = hospital.get_staff_workplace_ID();
+		if (work_ID > 0)
+			hospital.set_number_of_staff(
+				static_cast<int>(workplaces[work_ID-1].get_agent_IDs().size()));
+		hospital.compute_infected_contribution();
+		if (work_ID > 0)
+			workplaces[work_ID-1].add_infected_contribution(hospital.get_infected_contribution());
+	}
+}
+
 /// \brief Set contributions/sums from all agents in places to 0.0 
 void Contributions::reset_sums(std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Workplace>& workplaces)
@@ -94,4 +154,9 @@ void Contributions::reset_sums(std::vector<Household>& households, std::vector<S
 	std::for_each(workplaces.begin(), workplaces.end(), reset_contributions);
 }
 
-
+// Set contributions/sums from all patients in hospitals to 0.0 
+void Contributions::reset_sums(std::vector<Hospital>& hospitals)
+{
+	for (auto& hospital : hospitals)
+		hospital.reset_contributions();
+}
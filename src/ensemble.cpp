@@ -0,0 +1,32 @@
+#include "../include/ensemble.h"
+#include <thread>
+
+/*****************************************************
+ * class: Ensemble
+ *
+ * Runs replicates of a model concurrently in one
+ * process
+ *
+ ******************************************************/
+
+// Copy the population once and set the number of threads
+Ensemble::Ensemble(const ABM& model, const unsigned int n_thr)
+{
+	std::shared_ptr<ABM> copy = std::make_shared<ABM>(model);
+	// The log would be shared by all replicates
+	copy->disable_event_log();
+	population = copy;
+
+	n_threads = n_thr;
+	if (n_threads == 0)
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Seed of a replicate derived from the base seed
+unsigned int Ensemble::replicate_seed(const unsigned int base_seed, const int replicate)
+{
+	std::seed_seq seq = {base_seed, static_cast<unsigned int>(replicate)};
+	unsigned int seed = 0;
+	seq.generate(&seed, &seed + 1);
+	return seed;
+}
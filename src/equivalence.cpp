@@ -0,0 +1,321 @@
+#include "../include/equivalence.h"
+#include <iomanip>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+/*****************************************************
+ * Two-sample tests of equal distributions
+ ******************************************************/
+
+namespace {
+	// Kolmogorov distribution, probability that the scaled
+	// largest difference exceeds lambda
+	double kolmogorov_q(const double lambda)
+	{
+		// The series converges slowly, the value is 1 to double precision
+		if (lambda < 0.2)
+			return 1.0;
+		double sum = 0.0, sign = 1.0;
+		for (int j = 1; j <= 100; ++j){
+			const double term = std::exp(-2.0*j*j*lambda*lambda);
+			sum += sign*term;
+			if (term < 1e-16*sum)
+				break;
+			sign = -sign;
+		}
+		return std::min(1.0, std::max(0.0, 2.0*sum));
+	}
+
+	// Least squares fit of log(p) to the critical values of the
+	// Anderson-Darling test, coefficients of 1, x, x^2
+	std::array<double, 3> ad_fit(const std::array<double, 7>& critical,
+									const std::array<double, 7>& levels)
+	{
+		// Normal equations, solved by Cramer's rule
+		std::array<double, 5> sx = {};
+		std::array<double, 3> sy = {};
+		for (std::size_t i = 0; i < critical.size(); ++i){
+			double xp = 1.0;
+			for (std::size_t p = 0; p < 5; ++p){
+				sx[p] += xp;
+				if (p < 3)
+					sy[p] += xp*std::log(levels[i]);
+				xp *= critical[i];
+			}
+		}
+		auto det = [](const double a, const double b, const double c,
+						const double d, const double e, const double f,
+						const double g, const double h, const double i){
+			return a*(e*i - f*h) - b*(d*i - f*g) + c*(d*h - e*g); };
+		const double d = det(sx[0], sx[1], sx[2], sx[1], sx[2], sx[3], sx[2], sx[3], sx[4]);
+		return {{det(sy[0], sx[1], sx[2], sy[1], sx[2], sx[3], sy[2], sx[3], sx[4])/d,
+				 det(sx[0], sy[0], sx[2], sx[1], sy[1], sx[3], sx[2], sy[2], sx[4])/d,
+				 det(sx[0], sx[1], sy[0], sx[1], sx[2], sy[1], sx[2], sx[3], sy[2])/d}};
+	}
+
+	// P-value of the standardized statistic of two samples
+	double ad_p_value(const double a2_std)
+	{
+		// Critical values of Scholz and Stephens, Table 2, for k - 1 = 1
+		static const std::array<double, 7> critical = {{0.325, 1.226, 1.961, 2.718, 3.752, 4.592, 6.546}};
+		static const std::array<double, 7> levels = {{0.25, 0.1, 0.05, 0.025, 0.01, 0.005, 0.001}};
+		static const std::array<double, 3> c = ad_fit(critical, levels);
+		if (a2_std < critical.front())
+			return levels.front();
+		const double x = std::min(a2_std, critical.back());
+		double log_p = c[0] + c[1]*x + c[2]*x*x;
+		// Beyond the table along the tangent of the fit
+		if (a2_std > critical.back())
+			log_p += (c[1] + 2.0*c[2]*x)*(a2_std - x);
+		return std::min(1.0, std::exp(log_p));
+	}
+
+	// True if all values of both samples are the same
+	bool single_value(const std::vector<double>& x, const std::vector<double>& y)
+	{
+		const double v = x.front();
+		return std::all_of(x.begin(), x.end(), [v](const double z){ return z == v; })
+			&& std::all_of(y.begin(), y.end(), [v](const double z){ return z == v; });
+	}
+}
+
+// Two-sample Kolmogorov-Smirnov test
+TwoSampleResult ks_test(std::vector<double> x, std::vector<double> y)
+{
+	if (x.empty() || y.empty())
+		throw std::invalid_argument("Kolmogorov-Smirnov test needs non-empty samples");
+	std::sort(x.begin(), x.end());
+	std::sort(y.begin(), y.end());
+	const double n = x.size(), m = y.size();
+
+	// Largest difference after each distinct value
+	TwoSampleResult result;
+	std::size_t i = 0, j = 0;
+	while (i < x.size() && j < y.size()){
+		const double v = std::min(x[i], y[j]);
+		while (i < x.size() && x[i] == v)
+			++i;
+		while (j < y.size() && y[j] == v)
+			++j;
+		result.statistic = std::max(result.statistic, std::abs(i/n - j/m));
+	}
+
+	const double en = std::sqrt(n*m/(n + m));
+	result.p_value = kolmogorov_q((en + 0.12 + 0.11/en)*result.statistic);
+	return result;
+}
+
+// Two-sample Anderson-Darling test
+TwoSampleResult anderson_darling_test(std::vector<double> x, std::vector<double> y)
+{
+	if (x.empty() || y.empty() || x.size() + y.size() < 4)
+		throw std::invalid_argument("Anderson-Darling test needs non-empty samples with at least 4 values");
+	TwoSampleResult result;
+	if (single_value(x, y))
+		return result;
+
+	std::sort(x.begin(), x.end());
+	std::sort(y.begin(), y.end());
+	std::vector<double> pooled(x);
+	pooled.insert(pooled.end(), y.begin(), y.end());
+	std::sort(pooled.begin(), pooled.end());
+	const double N = pooled.size();
+
+	// Sum over distinct values of the pooled sample, ties at midranks
+	double a2 = 0.0;
+	for (std::size_t lo = 0; lo < pooled.size(); ){
+		const double z = pooled[lo];
+		const std::size_t hi = std::upper_bound(pooled.begin(), pooled.end(), z) - pooled.begin();
+		const double lj = hi - lo;
+		const double bj = lo + lj/2.0;
+		for (const auto sample : {&x, &y}){
+			const double ni = sample->size();
+			const double below = std::lower_bound(sample->begin(), sample->end(), z) - sample->begin();
+			const double upto = std::upper_bound(sample->begin(), sample->end(), z) - sample->begin();
+			const double mij = upto - (upto - below)/2.0;
+			const double diff = N*mij - bj*ni;
+			a2 += lj/N*diff*diff/(bj*(N - bj) - N*lj/4.0)/ni;
+		}
+		lo = hi;
+	}
+	a2 *= (N - 1.0)/N;
+	result.statistic = a2;
+
+	// Standardized with the variance for k = 2 samples
+	const double k = 2.0;
+	const double H = 1.0/x.size() + 1.0/y.size();
+	double h = 1.0, g = 0.0, partial = 0.0;
+	for (int i = 1; i <= static_cast<int>(N) - 2; ++i){
+		partial += 1.0/(N - i);
+		g += partial/(i + 1);
+	}
+	h += partial;
+	const double a = (4*g - 6)*(k - 1) + (10 - 6*g)*H;
+	const double b = (2*g - 4)*k*k + 8*h*k + (2*g - 14*h - 4)*H - 8*h + 4*g - 6;
+	const double c = (6*h + 2*g - 2)*k*k + (4*h - 4*g + 6)*k + (2*h - 6)*H + 4*h;
+	const double d = (2*h + 6)*k*k - 4*h*k;
+	const double sigma2 = (a*N*N*N + b*N*N + c*N + d)/((N - 1.0)*(N - 2.0)*(N - 3.0));
+	result.p_value = ad_p_value((a2 - (k - 1))/std::sqrt(sigma2));
+	return result;
+}
+
+/*****************************************************
+ * class: EquivalenceTest
+ *
+ * Statistical comparison of two simulation engines
+ *
+ ******************************************************/
+
+// Checks the settings and copies the population
+EquivalenceTest::EquivalenceTest(const ABM& population, const int n_initial, const int n_steps,
+					const int n_replicates, const double alpha, const unsigned int n_thr) :
+	ensemble(population, n_thr), initial_infected(n_initial), steps(n_steps),
+	replicates(n_replicates), significance(alpha)
+{
+	if (n_initial < 0)
+		throw std::invalid_argument("Number of initially infected agents can't be negative");
+	if (n_steps < 1)
+		throw std::invalid_argument("Equivalence test needs at least one time step");
+	if (n_replicates < 2)
+		throw std::invalid_argument("Equivalence test needs at least two replicates of each engine");
+	if (alpha <= 0.0 || alpha >= 1.0)
+		throw std::invalid_argument("Significance level has to be between 0 and 1");
+	step_stride = std::max(1, n_steps/10);
+}
+
+// Compare compartments every this many steps
+void EquivalenceTest::set_step_stride(const int stride)
+{
+	if (stride < 1)
+		throw std::invalid_argument("Step stride has to be positive");
+	step_stride = stride;
+}
+
+// Curves of all replicates simulated with an engine
+std::vector<EpidemicCurve> EquivalenceTest::simulate(const StepFunction& engine,
+											const unsigned int base_seed) const
+{
+	const int n_initial = initial_infected, n_steps = steps;
+	std::function<EpidemicCurve(ABM&, const int)> replicate = [&engine, n_initial, n_steps](ABM& abm, const int){
+			if (n_initial > 0)
+				abm.infect_random_agents(n_initial);
+			EpidemicCurve curve;
+			for (int ti = 0; ti <= n_steps; ++ti){
+				curve.susceptible.push_back(abm.get_num_susceptible());
+				curve.exposed.push_back(abm.get_num_exposed());
+				curve.infected.push_back(abm.get_num_infected());
+				curve.removed.push_back(abm.get_num_removed());
+				if (curve.infected.back() > curve.peak_infected){
+					curve.peak_infected = curve.infected.back();
+					curve.peak_step = ti;
+				}
+				if (ti < n_steps)
+					engine(abm);
+			}
+			curve.final_size = static_cast<int>(abm.get_vector_of_agents().size()) - curve.susceptible.back();
+			return curve;
+		};
+	return ensemble.run(replicates, replicate, base_seed);
+}
+
+// Simulate with both engines and compare
+std::vector<EquivalenceResult> EquivalenceTest::compare(const StepFunction& reference,
+											const StepFunction& candidate) const
+{
+	return compare(simulate(reference, reference_seed), simulate(candidate, candidate_seed));
+}
+
+// Compare curves of two ensembles
+std::vector<EquivalenceResult> EquivalenceTest::compare(const std::vector<EpidemicCurve>& reference,
+											const std::vector<EpidemicCurve>& candidate) const
+{
+	if (reference.size() < 2 || candidate.size() < 2)
+		throw std::invalid_argument("Equivalence test needs at least two replicates of each engine");
+
+	// Samples of all compared quantities
+	struct Quantity {
+		std::string name;
+		int step;
+		std::vector<double> x, y;
+	};
+	std::vector<Quantity> quantities;
+	auto add = [&](const std::string& name, const int step,
+					const std::function<int(const EpidemicCurve&)>& value){
+		Quantity q = {name, step, {}, {}};
+		for (const auto& curve : reference)
+			q.x.push_back(value(curve));
+		for (const auto& curve : candidate)
+			q.y.push_back(value(curve));
+		if (!single_value(q.x, q.y))
+			quantities.push_back(q);
+	};
+
+	add("final size", -1, [](const EpidemicCurve& c){ return c.final_size; });
+	add("peak step", -1, [](const EpidemicCurve& c){ return c.peak_step; });
+	const int n_points = static_cast<int>(std::min(reference.front().infected.size(),
+											candidate.front().infected.size()));
+	for (int ti = step_stride; ti < n_points + step_stride - 1; ti += step_stride){
+		const int step = std::min(ti, n_points - 1);
+		add("susceptible", step, [step](const EpidemicCurve& c){ return c.susceptible.at(step); });
+		add("exposed", step, [step](const EpidemicCurve& c){ return c.exposed.at(step); });
+		add("infected", step, [step](const EpidemicCurve& c){ return c.infected.at(step); });
+		add("removed", step, [step](const EpidemicCurve& c){ return c.removed.at(step); });
+	}
+
+	// Bonferroni correction over all tests
+	const double threshold = significance/std::max<std::size_t>(1, 2*quantities.size());
+	std::vector<EquivalenceResult> results;
+	for (const auto& q : quantities){
+		for (const std::string test : {"KS", "AD"}){
+			const TwoSampleResult r = (test == "KS") ? ks_test(q.x, q.y)
+													: anderson_darling_test(q.x, q.y);
+			EquivalenceResult result;
+			result.quantity = q.name;
+			result.step = q.step;
+			result.test = test;
+			result.statistic = r.statistic;
+			result.p_value = r.p_value;
+			result.threshold = threshold;
+			result.passed = (r.p_value >= threshold);
+			results.push_back(result);
+		}
+	}
+	return results;
+}
+
+// True if every test passed
+bool EquivalenceTest::all_passed(const std::vector<EquivalenceResult>& results)
+{
+	return std::all_of(results.begin(), results.end(),
+						[](const EquivalenceResult& r){ return r.passed; });
+}
+
+// Table of results
+void EquivalenceTest::print(std::ostream& out, const std::vector<EquivalenceResult>& results,
+						const bool all)
+{
+	const std::ios_base::fmtflags flags = out.flags();
+	const std::streamsize precision = out.precision();
+	out << std::left << std::setw(14) << "quantity" << std::right << std::setw(6) << "step"
+		<< std::setw(6) << "test" << std::setw(12) << "statistic" << std::setw(12) << "p-value"
+		<< std::setw(12) << "threshold" << "  result\n";
+	int n_failed = 0;
+	for (const auto& r : results){
+		if (!r.passed)
+			++n_failed;
+		if (r.passed && !all)
+			continue;
+		out << std::left << std::setw(14) << r.quantity << std::right << std::setw(6);
+		if (r.step < 0)
+			out << "-";
+		else
+			out << r.step;
+		out << std::setw(6) << r.test << std::fixed << std::setprecision(4) << std::setw(12) << r.statistic
+			<< std::scientific << std::setprecision(3) << std::setw(12) << r.p_value
+			<< std::setw(12) << r.threshold << "  " << (r.passed ? "pass" : "FAIL") << "\n";
+		out.flags(flags);
+	}
+	out << results.size() << " tests, " << n_failed << " failed\n";
+	out.precision(precision);
+}
@@ -0,0 +1,226 @@
+#include "../include/fork_runner.h"
+#include "../include/ensemble.h"
+#include <thread>
+#include <cstdio>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+/*****************************************************
+ * class: ForkRunner
+ *
+ * Runs replicates of a model in child processes
+ *
+ * Message sent by a child:
+ * 	uint8 status (0 results, 1 exception), then for results
+ * 	uint64 number of values and the values as doubles, for
+ * 	an exception the message
+ *
+ ******************************************************/
+
+namespace {
+	const std::uint8_t child_results = 0;
+	const std::uint8_t child_exception = 1;
+
+	// Write all the bytes, false on error
+	bool write_all(const int fd, const char* data, std::size_t n_bytes)
+	{
+		while (n_bytes > 0){
+			const ssize_t n_written = write(fd, data, n_bytes);
+			if (n_written < 0){
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+			data += n_written;
+			n_bytes -= static_cast<std::size_t>(n_written);
+		}
+		return true;
+	}
+
+	// Child process that is still sending results
+	struct Child {
+		pid_t pid = -1;
+		int fd = -1;
+		int replicate = 0;
+		std::vector<char> message;
+	};
+
+	// Results of a finished child, error description if it failed
+	std::string collect_results(const Child& child, const int status, std::vector<double>& results)
+	{
+		if (WIFSIGNALED(status))
+			return "killed by signal " + std::to_string(WTERMSIG(status));
+		const std::vector<char>& msg = child.message;
+		if (msg.empty())
+			return "exited with status " + std::to_string(WEXITSTATUS(status)) + " without results";
+		if (static_cast<std::uint8_t>(msg[0]) == child_exception)
+			return "exception: " + std::string(msg.begin() + 1, msg.end());
+
+		std::uint64_t n_values = 0;
+		if (msg.size() < 1 + sizeof(n_values))
+			return "incomplete results";
+		std::memcpy(&n_values, msg.data() + 1, sizeof(n_values));
+		if (msg.size() != 1 + sizeof(n_values) + n_values*sizeof(double))
+			return "incomplete results";
+		results.resize(n_values);
+		std::memcpy(results.data(), msg.data() + 1 + sizeof(n_values), n_values*sizeof(double));
+		return "";
+	}
+}
+
+// Store the model and the limits
+ForkRunner::ForkRunner(ABM& model, const unsigned int n_proc, const std::size_t mem_limit) :
+	population(model), memory_limit(mem_limit)
+{
+	// The children would write to the same log
+	population.disable_event_log();
+	n_processes = n_proc;
+	if (n_processes == 0)
+		n_processes = std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Run replicates, return their results in order
+std::vector<std::vector<double>> ForkRunner::run(const int n_replicates,
+						const std::function<std::vector<double>(ABM&, const int)>& replicate,
+						const unsigned int base_seed, std::vector<std::string>* errors) const
+{
+	if (n_replicates < 0)
+		throw std::invalid_argument("Number of replicates can't be negative");
+
+	std::vector<std::vector<double>> results(n_replicates);
+	std::vector<std::string> failures(n_replicates);
+	std::vector<Child> running;
+	std::vector<pollfd> polled;
+	std::vector<char> buffer(1 << 16);
+	int next = 0;
+
+	// Output buffered so far would be written by every child
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(nullptr);
+
+	// Stop all children if the parent can't continue
+	auto stop_all = [&running](const std::string& msg){
+		const int error = errno;
+		for (auto& child : running){
+			kill(child.pid, SIGKILL);
+			close(child.fd);
+			waitpid(child.pid, nullptr, 0);
+		}
+		throw std::runtime_error(msg + ": " + std::strerror(error));
+	};
+
+	while (next < n_replicates || !running.empty()){
+		// Start new children up to the limit
+		while (next < n_replicates && running.size() < n_processes){
+			int fds[2];
+			if (pipe(fds) != 0)
+				stop_all("Creating a pipe for a replicate failed");
+			const pid_t pid = fork();
+			if (pid < 0){
+				close(fds[0]);
+				close(fds[1]);
+				stop_all("Starting a replicate process failed");
+			}
+			if (pid == 0){
+				close(fds[0]);
+				for (const auto& child : running)
+					close(child.fd);
+				run_child(fds[1], next, replicate, base_seed);
+			}
+			close(fds[1]);
+			Child child;
+			child.pid = pid;
+			child.fd = fds[0];
+			child.replicate = next++;
+			running.push_back(child);
+		}
+
+		// Read whatever is ready, a child is done at the end of its pipe
+		polled.clear();
+		for (const auto& child : running)
+			polled.push_back({child.fd, POLLIN, 0});
+		if (poll(polled.data(), polled.size(), -1) < 0){
+			if (errno == EINTR)
+				continue;
+			stop_all("Waiting for replicate results failed");
+		}
+		for (std::size_t i = 0; i < running.size(); ++i){
+			if (polled[i].revents == 0)
+				continue;
+			Child& child = running[i];
+			const ssize_t n_read = read(child.fd, buffer.data(), buffer.size());
+			if (n_read > 0){
+				child.message.insert(child.message.end(), buffer.data(), buffer.data() + n_read);
+				continue;
+			}
+			if (n_read < 0 && errno == EINTR)
+				continue;
+			close(child.fd);
+			child.fd = -1;
+			int status = 0;
+			while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR)
+				;
+			failures[child.replicate] = collect_results(child, status, results[child.replicate]);
+		}
+		running.erase(std::remove_if(running.begin(), running.end(),
+							[](const Child& child){ return child.fd < 0; }), running.end());
+	}
+
+	if (errors != nullptr){
+		*errors = failures;
+		return results;
+	}
+	std::string report;
+	int n_failed = 0;
+	for (int i=0; i<n_replicates; ++i){
+		if (failures[i].empty())
+			continue;
+		++n_failed;
+		report += "\n\treplicate " + std::to_string(i) + ": " + failures[i];
+	}
+	if (n_failed > 0)
+		throw std::runtime_error(std::to_string(n_failed) + " of " + std::to_string(n_replicates)
+							+ " replicates failed" + report);
+	return results;
+}
+
+// Simulate one replicate in the child, send results, and exit
+void ForkRunner::run_child(const int fd, const int rep,
+					const std::function<std::vector<double>(ABM&, const int)>& replicate,
+					const unsigned int base_seed) const
+{
+	std::vector<char> message(1, static_cast<char>(child_results));
+	try {
+		if (memory_limit > 0){
+			struct rlimit limit;
+			limit.rlim_cur = memory_limit;
+			limit.rlim_max = memory_limit;
+			setrlimit(RLIMIT_AS, &limit);
+		}
+		population.set_seed(Ensemble::replicate_seed(base_seed, rep));
+		const std::vector<double> values = replicate(population, rep);
+		const std::uint64_t n_values = values.size();
+		const char* size_bytes = reinterpret_cast<const char*>(&n_values);
+		const char* value_bytes = reinterpret_cast<const char*>(values.data());
+		message.insert(message.end(), size_bytes, size_bytes + sizeof(n_values));
+		message.insert(message.end(), value_bytes, value_bytes + n_values*sizeof(double));
+	} catch (const std::exception& e) {
+		const std::string what = e.what();
+		message.assign(1, static_cast<char>(child_exception));
+		message.insert(message.end(), what.begin(), what.end());
+	} catch (...) {
+		const std::string what = "unknown exception";
+		message.assign(1, static_cast<char>(child_exception));
+		message.insert(message.end(), what.begin(), what.end());
+	}
+	const bool sent = write_all(fd, message.data(), message.size());
+	close(fd);
+	// Destructors and exit handlers belong to the parent
+	_exit(sent ? 0 : 1);
+}
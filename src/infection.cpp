@@ -45,19 +45,19 @@ bool Infection::recovering_exposed()
 // Determine if agent will die 
 bool Infection::will_die(const int age)
 {
-	double tot_prob = 0.0;
-	// Probability of death 
-	for (const auto& mrt : mortality_rates){
-		if ( age >= std::get<0>(mrt.second) &&
-			 age <= std::get<1>(mrt.second)){
-			tot_prob = std::get<2>(mrt.second);
-		}
-	}
-	// true if going to die
-	if (rng.get_random(0.0, 1.0) <= tot_prob)
-		return true;
-	else
-		return false;	
+	return sample_by_age(*mortality_rates, age);
+}
+
+// Determine if agent will be hospitalized
+bool Infection::will_be_hospitalized(const int age)
+{
+	return sample_by_age(*hospitalization_rates, age);
+}
+
+// Determine if hospitalized agent will need ICU
+bool Infection::will_need_ICU(const int age)
+{
+	return sample_by_age(*ICU_rates, age);
 }
 
 
@@ -67,6 +67,31 @@ double Infection::time_to_death()
 	return rng.get_random_lognormal(otd_mean, otd_std);
 }
 
+// Determine time from onset to hospitalization
+double Infection::time_to_hospitalization()
+{
+	return rng.get_random_gamma(oth_k, oth_theta);
+}
+
+// Determine if agent will get tested
+bool Infection::will_get_tested(const bool symptomatic)
+{
+	const double prob = symptomatic ? prob_sy_tested : prob_exp_tested;
+	return (rng.get_random(0, 1) < prob);
+}
+
+// Determine if test of an infected agent is negative
+bool Infection::false_negative_test()
+{
+	return (rng.get_random(0, 1) < prob_false_neg);
+}
+
+// Determine if test of an agent not infected is positive
+bool Infection::false_positive_test()
+{
+	return (rng.get_random(0, 1) < prob_false_pos);
+}
+
 // Returns random household ID for testing
 int Infection::get_random_household_ID(int n_hs)
 {
@@ -79,6 +104,12 @@ int Infection::get_random_agent_ID(const int n_ag)
     return rng.get_random_int(1, n_ag);
 }
 
+// Returns random hospital ID
+int Infection::get_random_hospital_ID(const int n_hsp)
+{
+	return rng.get_random_int(1, n_hsp);
+}
+
 
 //
 // Setters
@@ -87,12 +118,22 @@ int Infection::get_random_agent_ID(const int n_ag)
 // Process and store the age-dependent mortality rate distribution
 void Infection::set_mortality_rates(const std::map<std::string, double> raw_rates)
 {
-	std::vector<int> ages = {0,0};
+	mortality_rates = std::make_shared<const std::map<std::string, std::tuple<int, int, double>>>(
+					process_age_groups(raw_rates));
+}
 
-	for (const auto& rr : raw_rates){
-		ages = parse_age_group(rr.first);
-		mortality_rates[rr.first] = std::make_tuple(ages[0], ages[1], rr.second);
-	}
+// Process and store the age-dependent hospitalization rate distribution
+void Infection::set_hospitalization_rates(const std::map<std::string, double> raw_rates)
+{
+	hospitalization_rates = std::make_shared<const std::map<std::string, std::tuple<int, int, double>>>(
+					process_age_groups(raw_rates));
+}
+
+// Process and store the age-dependent ICU rate distribution
+void Infection::set_ICU_rates(const std::map<std::string, double> raw_rates)
+{
+	ICU_rates = std::make_shared<const std::map<std::string, std::tuple<int, int, double>>>(
+					process_age_groups(raw_rates));
 }
 
 //
@@ -116,6 +157,35 @@ std::vector<int> Infection::parse_age_group(const std::string group_range)
 	return ages;
 }
 
+// Age groups with their probabilities
+std::map<std::string, std::tuple<int, int, double>> Infection::process_age_groups(
+				const std::map<std::string, double>& raw_rates)
+{
+	std::map<std::string, std::tuple<int, int, double>> rates;
+	std::vector<int> ages = {0,0};
+
+	for (const auto& rr : raw_rates){
+		ages = parse_age_group(rr.first);
+		rates[rr.first] = std::make_tuple(ages[0], ages[1], rr.second);
+	}
+	return rates;
+}
+
+// True with the probability of the age group
+bool Infection::sample_by_age(const std::map<std::string, std::tuple<int, int, double>>& rates, 
+				const int age)
+{
+	double tot_prob = 0.0;
+	for (const auto& rate : rates){
+		if ( age >= std::get<0>(rate.second) &&
+			 age <= std::get<1>(rate.second)){
+			tot_prob = std::get<2>(rate.second);
+		}
+	}
+	// true with that probability
+	return rng.get_random(0.0, 1.0) <= tot_prob;
+}
+
 // Compute if agent got infected
 bool Infection::infected(const double lambda)
 {
@@ -0,0 +1,105 @@
+#include "../include/interactions.h"
+#include <unordered_map>
+
+/*****************************************************
+ * class: Interactions
+ *
+ * Counts contacts of agents through the places they
+ * belong to
+ *
+ * Contacts of an agent are the union of its household
+ * H, school S, and workplace W, without the agent
+ * itself, computed as |S| + |W| - |S and W| plus the
+ * members of H that are in neither S nor W. Households
+ * are small so they are checked member by member.
+ * Agents in both S and W are exactly the agents with
+ * the same school-workplace pair.
+ *
+ ******************************************************/
+
+// Index place memberships and count contacts of all agents
+void Interactions::build_index(const std::vector<Agent>& agents, const int n_households,
+									const int n_schools, const int n_workplaces)
+{
+	// Per agent - household index, keys of the school and
+	// the place of work (-1 if none), index of the pair of
+	// both (-1 if not in two such places)
+	const int n_agents = static_cast<int>(agents.size());
+	std::vector<int> house(n_agents, 0);
+	std::vector<int> place_1(n_agents, -1), place_2(n_agents, -1);
+	std::vector<int> pair(n_agents, -1);
+
+	// Schools are keys 0 to n_schools-1, workplaces follow
+	std::unordered_map<long long, int> pair_index;
+	for (int i=0; i<n_agents; ++i){
+		const Agent& agent = agents[i];
+		house[i] = agent.get_household_ID() - 1;
+		if (agent.student())
+			place_1[i] = agent.get_school_ID() - 1;
+		if (agent.works()){
+			if (agent.school_employee())
+				place_2[i] = agent.get_work_ID() - 1;
+			else
+				place_2[i] = n_schools + agent.get_work_ID() - 1;
+		}
+		// Employee of own school is one membership
+		if (place_1[i] == place_2[i])
+			place_2[i] = -1;
+		if (place_1[i] >= 0 && place_2[i] >= 0){
+			// Same pair regardless of which one is the school of a student
+			const long long key = (static_cast<long long>(std::min(place_1[i], place_2[i])) << 32)
+										| std::max(place_1[i], place_2[i]);
+			auto iter = pair_index.find(key);
+			if (iter == pair_index.end())
+				iter = pair_index.insert(std::make_pair(key, static_cast<int>(pair_index.size()))).first;
+			pair[i] = iter->second;
+		}
+	}
+
+	// Household members, counting sort by household
+	std::vector<int> house_start(n_households + 1, 0);
+	for (int i=0; i<n_agents; ++i)
+		++house_start[house[i] + 1];
+	for (int h=0; h<n_households; ++h)
+		house_start[h + 1] += house_start[h];
+	std::vector<int> house_members(n_agents);
+	std::vector<int> next(house_start.begin(), house_start.end() - 1);
+	for (int i=0; i<n_agents; ++i)
+		house_members[next[house[i]]++] = i;
+
+	// Members of each school or workplace and of each school-workplace pair
+	std::vector<int> place_size(n_schools + n_workplaces, 0);
+	std::vector<int> pair_size(pair_index.size(), 0);
+	for (int i=0; i<n_agents; ++i){
+		if (place_1[i] >= 0)
+			++place_size[place_1[i]];
+		if (place_2[i] >= 0)
+			++place_size[place_2[i]];
+		if (pair[i] >= 0)
+			++pair_size[pair[i]];
+	}
+
+	// True if agent with index j belongs to place with key
+	auto is_member = [&place_1, &place_2](const int j, const int key)
+		{ return key >= 0 && (place_1[j] == key || place_2[j] == key); };
+
+	contacts.assign(n_agents, 0);
+	for (int i=0; i<n_agents; ++i){
+		const int p1 = place_1[i], p2 = place_2[i];
+		int n_contacts = 0;
+		if (p1 >= 0)
+			n_contacts += place_size[p1];
+		if (p2 >= 0)
+			n_contacts += place_size[p2];
+		if (pair[i] >= 0)
+			n_contacts -= pair_size[pair[i]];
+		// Household members not met elsewhere
+		for (int k = house_start[house[i]]; k < house_start[house[i] + 1]; ++k){
+			const int j = house_members[k];
+			if (!is_member(j, p1) && !is_member(j, p2))
+				++n_contacts;
+		}
+		// The agent itself was counted too
+		contacts[i] = n_contacts - 1;
+	}
+}
@@ -0,0 +1,131 @@
+#include "../include/intervention_schedule.h"
+#include <iomanip>
+
+/*****************************************************
+ * class: InterventionSchedule
+ *
+ * Timeline of interventions that change transmission
+ * in schools and workplaces
+ *
+ ******************************************************/
+
+// Closures and reopening from infection parameters
+InterventionSchedule InterventionSchedule::from_parameters(const std::map<std::string, double>& parameters)
+{
+	auto get = [&parameters](const std::string& name){
+			const auto it = parameters.find(name);
+			if (it == parameters.end())
+				throw std::invalid_argument("Missing intervention parameter: " + name);
+			return it->second;
+		};
+	auto fraction = [&get](const std::string& name){
+			const double value = get(name);
+			if (value < 0.0 || value > 1.0)
+				throw std::invalid_argument("Fraction of open businesses has to be between 0 and 1: " + name);
+			return value;
+		};
+
+	// Changes of open places of one type, in time order
+	struct Change {
+		std::string name;
+		double time;
+		bool school;
+		double open;
+	};
+	std::vector<Change> changes = {
+		{"school closure", get("school closure"), true, 0.0},
+		{"lockdown", get("lockdown"), false, fraction("fraction of ld businesses")},
+		{"reopening phase 1", get("reopening phase 1"), false, fraction("fraction of phase 1 businesses")},
+		{"reopening phase 2", get("reopening phase 2"), false, fraction("fraction of phase 2 businesses")},
+		{"reopening phase 3", get("reopening phase 3"), false, fraction("fraction of phase 3 businesses")} };
+	std::stable_sort(changes.begin(), changes.end(),
+				[](const Change& a, const Change& b){ return a.time < b.time; });
+
+	// Each phase keeps the open places of the other type
+	InterventionSchedule schedule;
+	double school_open = 1.0, workplace_open = 1.0;
+	for (const auto& change : changes){
+		if (change.school)
+			school_open = change.open;
+		else
+			workplace_open = change.open;
+		schedule.add_phase(change.name, change.time, 1.0, 1.0, school_open, workplace_open);
+	}
+	return schedule;
+}
+
+// Add a phase in order of start
+void InterventionSchedule::add_phase(const std::string& name, const double time,
+					const double school_factor, const double workplace_factor,
+					const double school_open, const double workplace_open)
+{
+	if (time < 0.0)
+		throw std::invalid_argument("Intervention can't start before time 0: " + name);
+	if (school_factor < 0.0 || workplace_factor < 0.0)
+		throw std::invalid_argument("Transmission rate factors can't be negative: " + name);
+	if (school_open < 0.0 || school_open > 1.0 || workplace_open < 0.0 || workplace_open > 1.0)
+		throw std::invalid_argument("Fractions of open places have to be between 0 and 1: " + name);
+
+	InterventionPhase phase;
+	phase.name = name;
+	phase.time = time;
+	phase.school_factor = school_factor;
+	phase.workplace_factor = workplace_factor;
+	phase.school_open = school_open;
+	phase.workplace_open = workplace_open;
+	// After phases with the same start
+	const auto where = std::upper_bound(phases.begin(), phases.end(), time,
+				[](const double t, const InterventionPhase& p){ return t < p.time; });
+	phases.insert(where, phase);
+	clear_compiled();
+}
+
+// Steps where phases start, open places, and factors of each place
+void InterventionSchedule::compile(const double dt, const int n_schools, const int n_workplaces)
+{
+	if (dt <= 0.0)
+		throw std::invalid_argument("Time step has to be positive");
+	clear_compiled();
+
+	// Separate rankings of the two place types
+	std::seed_seq seq = {seed};
+	std::vector<unsigned int> seeds(2);
+	seq.generate(seeds.begin(), seeds.end());
+	const std::vector<int> school_ranking = PlaceActivation::random_ranking(n_schools, seeds[0]);
+	const std::vector<int> workplace_ranking = PlaceActivation::random_ranking(n_workplaces, seeds[1]);
+
+	for (const auto& phase : phases){
+		// Tolerance for start times that are multiples of dt
+		start_steps.push_back(static_cast<int>(std::ceil(phase.time/dt - 1e-9)));
+		school_factors.push_back(std::vector<double>(n_schools, phase.school_factor));
+		workplace_factors.push_back(std::vector<double>(n_workplaces, phase.workplace_factor));
+		open_schools.push_back(PlaceActivation(n_schools));
+		open_schools.back().open_first(school_ranking, phase.school_open);
+		open_workplaces.push_back(PlaceActivation(n_workplaces));
+		open_workplaces.back().open_first(workplace_ranking, phase.workplace_open);
+	}
+}
+
+// Remove the compiled phases
+void InterventionSchedule::clear_compiled()
+{
+	start_steps.clear();
+	school_factors.clear();
+	workplace_factors.clear();
+	open_schools.clear();
+	open_workplaces.clear();
+}
+
+// Phases, one per line
+void InterventionSchedule::print(std::ostream& out) const
+{
+	const std::ios_base::fmtflags flags = out.flags();
+	for (const auto& phase : phases)
+		out << std::left << std::setw(20) << phase.name << std::right
+			<< " day " << std::setw(6) << phase.time
+			<< "  open schools " << std::setw(6) << phase.school_open
+			<< " workplaces " << std::setw(6) << phase.workplace_open
+			<< "  factors of schools " << std::setw(6) << phase.school_factor
+			<< " workplaces " << std::setw(6) << phase.workplace_factor << "\n";
+	out.flags(flags);
+}
@@ -12,6 +12,18 @@
 
 void FileHandler::open_file()
 {
+	codec = CompressedBuffer::codec_from_name(fname);
+	if (codec != Codec::none){
+		zbuf.reset(new CompressedBuffer(fname, codec, mode));
+		if (!zbuf->is_open()){
+			std::cerr << "Error opening file " << fname << std::endl;
+			throw std::ios_base::failure(std::strerror(errno));
+		}
+		zstream.reset(new std::iostream(zbuf.get()));
+		stream = zstream.get();
+		return;
+	}
+
 	file.open(fname, mode);
 	if (!file.is_open()){
 		std::cerr << "Error opening file " << fname << std::endl;
@@ -24,9 +36,15 @@ FileHandler::~FileHandler()
 	// This is all that is being checked since std::getline sets failbit on EOF
 	// https://stackoverflow.com/a/7855777/2763915
 	// Leaving it like this for now - maybe extend in the future
-	if (file.bad())
+	if (stream->bad())
 		std::cerr << "Error reading or writing to file " << fname 
 				  << "\nDetected badbit set i.e. broken stream." << std::endl;
-	file.close();
+	if (zbuf){
+		// Compresses and writes the last block
+		if (!zbuf->close())
+			std::cerr << "Error compressing file " << fname << std::endl;
+	} else {
+		file.close();
+	}
 }		
 
@@ -0,0 +1,290 @@
+#include "../../include/io_operations/agent_snapshots.h"
+#include "../../include/tracer.h"
+
+/***************************************************************
+ * Agent state snapshots
+ *
+ * Compact binary format for per-step agent states with
+ * keyframes, delta-encoded changes, and a step index
+ **************************************************************/
+
+namespace {
+	// Magic strings marking the header and the footer
+	const char snapshot_magic[8] = {'A','B','M','S','N','A','P','1'};
+	const char index_magic[8] = {'A','B','M','S','I','D','X','1'};
+	// Record types
+	const std::uint8_t keyframe_record = 0;
+	const std::uint8_t delta_record = 1;
+	// Size of the header of a single step record
+	const std::uint64_t record_header_size = sizeof(std::uint8_t)
+				+ sizeof(std::uint32_t) + sizeof(double);
+	// Size of the footer
+	const std::uint64_t footer_size = sizeof(std::uint64_t) + sizeof(index_magic);
+}
+
+//
+// AgentSnapshotWriter
+//
+
+// Create the writer and save the header
+AgentSnapshotWriter::AgentSnapshotWriter(const std::string name, const int nag, const int kint) :
+	file(name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc)
+{
+	if (nag < 0)
+		throw std::invalid_argument("Number of agents in a snapshot can't be negative");
+	if (kint < 1)
+		throw std::invalid_argument("Snapshot keyframe interval needs to be at least 1");
+	n_agents = static_cast<std::uint32_t>(nag);
+	key_interval = static_cast<std::uint32_t>(kint);
+	current.assign(n_agents, 0);
+	previous.assign(n_agents, 0);
+	write_header();
+}
+
+// Save the file header
+void AgentSnapshotWriter::write_header()
+{
+	record.clear();
+	record.insert(record.end(), snapshot_magic, snapshot_magic + sizeof(snapshot_magic));
+	append(n_agents);
+	append(key_interval);
+	file.get_stream().write(record.data(), record.size());
+	position = record.size();
+}
+
+// Save states currently in the buffer as keyframe or delta
+void AgentSnapshotWriter::write_step(const double time)
+{
+	ABM_TRACE_SCOPE("agent_snapshot", "io");
+	if (closed)
+		throw std::runtime_error("Writing to a closed agent snapshot file");
+	if (current.size() != n_agents)
+		throw std::invalid_argument("Agent snapshot state buffer has wrong size");
+
+	const std::uint32_t step = static_cast<std::uint32_t>(index.size());
+	std::uint8_t type = delta_record;
+
+	record.clear();
+	append(type);
+	append(step);
+	append(time);
+
+	if (step % key_interval != 0){
+		// Collect the changes after the count which is filled in later
+		const std::size_t count_pos = record.size();
+		std::uint32_t n_changes = 0, last = 0;
+		append(n_changes);
+		for (std::uint32_t i = 0; i < n_agents; ++i){
+			if (current[i] == previous[i])
+				continue;
+			append_varint(i - last);
+			append(current[i]);
+			last = i;
+			++n_changes;
+		}
+		// Fall back to a keyframe if the delta is not smaller
+		if (record.size() - count_pos >= n_agents){
+			type = keyframe_record;
+		} else {
+			std::memcpy(&record[count_pos], &n_changes, sizeof(n_changes));
+		}
+	} else {
+		type = keyframe_record;
+	}
+
+	if (type == keyframe_record){
+		record.resize(record_header_size);
+		record[0] = static_cast<char>(keyframe_record);
+		record.insert(record.end(), current.begin(), current.end());
+	}
+
+	file.get_stream().write(record.data(), record.size());
+
+	IndexEntry entry;
+	entry.step = step;
+	entry.time = time;
+	entry.offset = position;
+	entry.type = type;
+	index.push_back(entry);
+
+	position += record.size();
+	std::swap(current, previous);
+	// Caller overwrites all the states, but keep the
+	// buffer consistent if only changes are set
+	current = previous;
+}
+
+// Save index and footer
+void AgentSnapshotWriter::close()
+{
+	if (closed)
+		return;
+
+	record.clear();
+	append(static_cast<std::uint32_t>(index.size()));
+	for (const auto& entry : index){
+		append(entry.step);
+		append(entry.time);
+		append(entry.offset);
+		append(entry.type);
+	}
+	append(position);
+	record.insert(record.end(), index_magic, index_magic + sizeof(index_magic));
+
+	std::iostream &out = file.get_stream();
+	out.write(record.data(), record.size());
+	out.flush();
+	closed = true;
+}
+
+AgentSnapshotWriter::~AgentSnapshotWriter()
+{
+	close();
+}
+
+// Append raw bytes of a value
+template <typename T>
+void AgentSnapshotWriter::append(const T& value)
+{
+	const char* bytes = reinterpret_cast<const char*>(&value);
+	record.insert(record.end(), bytes, bytes + sizeof(T));
+}
+
+// LEB128 encoding - 7 bits per byte, high bit marks continuation
+void AgentSnapshotWriter::append_varint(std::uint32_t value)
+{
+	while (value >= 0x80){
+		record.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	record.push_back(static_cast<char>(value));
+}
+
+//
+// AgentSnapshotReader
+//
+
+// Open and load the index
+AgentSnapshotReader::AgentSnapshotReader(const std::string name) :
+	file(name, std::ios_base::in | std::ios_base::binary)
+{
+	if (file.is_compressed())
+		throw std::invalid_argument("Agent snapshots need random access, "
+						"decompress " + name + " before reading");
+	read_header_and_index();
+}
+
+// Check the header and footer, load the index
+void AgentSnapshotReader::read_header_and_index()
+{
+	std::iostream &in = file.get_stream();
+	char magic[8];
+
+	in.read(magic, sizeof(magic));
+	if (!in || std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0)
+		throw std::runtime_error("Not an agent snapshot file");
+	n_agents = read_value<std::uint32_t>();
+	key_interval = read_value<std::uint32_t>();
+
+	in.seekg(-static_cast<std::streamoff>(footer_size), std::ios_base::end);
+	const std::uint64_t index_offset = read_value<std::uint64_t>();
+	in.read(magic, sizeof(magic));
+	if (!in || std::memcmp(magic, index_magic, sizeof(magic)) != 0)
+		throw std::runtime_error("Agent snapshot file has no index - writer not closed");
+
+	in.seekg(static_cast<std::streamoff>(index_offset), std::ios_base::beg);
+	const std::uint32_t n_steps = read_value<std::uint32_t>();
+	index.resize(n_steps);
+	for (auto& entry : index){
+		entry.step = read_value<std::uint32_t>();
+		entry.time = read_value<double>();
+		entry.offset = read_value<std::uint64_t>();
+		entry.type = read_value<std::uint8_t>();
+	}
+}
+
+// Reconstruct states at a step
+std::vector<std::uint8_t> AgentSnapshotReader::read_step(const int step)
+{
+	if (step < 0 || step >= get_number_of_steps())
+		throw std::out_of_range("Step not present in the agent snapshot file");
+
+	// Closest preceeding keyframe
+	int key = step;
+	while (index.at(key).type != keyframe_record)
+		--key;
+
+	std::vector<std::uint8_t> states(n_agents, 0);
+	for (int i = key; i <= step; ++i)
+		apply_record(i, states);
+
+	return states;
+}
+
+// Agents that changed state at a step
+std::vector<std::pair<int, std::uint8_t>> AgentSnapshotReader::read_changes(const int step)
+{
+	std::vector<std::pair<int, std::uint8_t>> changes;
+	std::vector<std::uint8_t> states = read_step(step);
+
+	// For the first step every agent is a change
+	std::vector<std::uint8_t> prev_states;
+	if (step > 0)
+		prev_states = read_step(step - 1);
+	else
+		prev_states.assign(n_agents, 0);
+
+	for (std::uint32_t i = 0; i < n_agents; ++i){
+		if (step == 0 || states[i] != prev_states[i])
+			changes.push_back(std::make_pair(static_cast<int>(i) + 1, states[i]));
+	}
+	return changes;
+}
+
+// Apply one record to the state vector
+void AgentSnapshotReader::apply_record(const int step, std::vector<std::uint8_t>& states)
+{
+	std::iostream &in = file.get_stream();
+	in.clear();
+	in.seekg(static_cast<std::streamoff>(index.at(step).offset + record_header_size),
+				std::ios_base::beg);
+
+	if (index.at(step).type == keyframe_record){
+		in.read(reinterpret_cast<char*>(states.data()), n_agents);
+	} else {
+		const std::uint32_t n_changes = read_value<std::uint32_t>();
+		std::uint32_t agent = 0;
+		for (std::uint32_t i = 0; i < n_changes; ++i){
+			agent += read_varint();
+			states.at(agent) = read_value<std::uint8_t>();
+		}
+	}
+	if (!in)
+		throw std::runtime_error("Agent snapshot file is truncated");
+}
+
+// Read raw bytes of a value
+template <typename T>
+T AgentSnapshotReader::read_value()
+{
+	T value{};
+	if (!file.get_stream().read(reinterpret_cast<char*>(&value), sizeof(T)))
+		throw std::runtime_error("Agent snapshot file is truncated");
+	return value;
+}
+
+// Decode LEB128 unsigned integer, at most 5 bytes for 32 bits
+std::uint32_t AgentSnapshotReader::read_varint()
+{
+	std::uint32_t value = 0;
+	int shift = 0;
+	std::uint8_t byte = 0;
+	do {
+		if (shift > 28)
+			throw std::runtime_error("Agent snapshot file is corrupted");
+		byte = read_value<std::uint8_t>();
+		value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return value;
+}
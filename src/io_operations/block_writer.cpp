@@ -0,0 +1,92 @@
+#include "../../include/io_operations/block_writer.h"
+#include "../../include/tracer.h"
+
+/***************************************************************
+ * class: BlockWriter
+ *
+ * Buffered text output for large, frequent saves
+ **************************************************************/
+
+namespace {
+	// Longest formatted number - int or %g double
+	const std::size_t max_number_length = 32;
+}
+
+// Open the file and allocate the buffer
+BlockWriter::BlockWriter(const std::string name, const std::size_t block) :
+	file(name, std::ios_base::out | std::ios_base::trunc)
+{
+	buffer.resize(std::max(block, max_number_length));
+}
+
+// Format an integer, digits are generated from the back
+BlockWriter& BlockWriter::operator<< (const int value)
+{
+	reserve(max_number_length);
+
+	char digits[max_number_length];
+	char* end = digits + max_number_length;
+	char* pos = end;
+
+	// Unsigned to also handle the most negative int
+	unsigned int mag = (value < 0) ? 0u - static_cast<unsigned int>(value)
+						: static_cast<unsigned int>(value);
+	do {
+		*--pos = static_cast<char>('0' + mag % 10);
+		mag /= 10;
+	} while (mag != 0);
+	if (value < 0)
+		*--pos = '-';
+
+	std::memcpy(&buffer[used], pos, end - pos);
+	used += end - pos;
+	return *this;
+}
+
+// Format a double the way std::ostream does by default
+BlockWriter& BlockWriter::operator<< (const double value)
+{
+	reserve(max_number_length);
+	const int n = std::snprintf(&buffer[used], max_number_length, "%g", value);
+	if (n > 0)
+		used += std::min(static_cast<std::size_t>(n), max_number_length - 1);
+	return *this;
+}
+
+// Format a double with a fixed number of decimals
+BlockWriter& BlockWriter::write_fixed(const double value, const int decimals)
+{
+	// Fixed notation of large values can be long
+	char text[512];
+	const int n = std::snprintf(text, sizeof(text), "%.*f", decimals, value);
+	if (n > 0)
+		append(text, std::min(static_cast<std::size_t>(n), sizeof(text) - 1));
+	return *this;
+}
+
+// Copy len characters, flushing as the buffer fills
+void BlockWriter::append(const char* value, std::size_t len)
+{
+	while (len > 0){
+		reserve(1);
+		const std::size_t n = std::min(len, buffer.size() - used);
+		std::memcpy(&buffer[used], value, n);
+		used += n;
+		value += n;
+		len -= n;
+	}
+}
+
+// Write the buffer content to the file
+void BlockWriter::flush()
+{
+	ABM_TRACE_SCOPE("block_writer_flush", "io");
+	if (used > 0)
+		file.get_stream().write(buffer.data(), used);
+	used = 0;
+}
+
+BlockWriter::~BlockWriter()
+{
+	flush();
+}
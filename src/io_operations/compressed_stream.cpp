@@ -0,0 +1,361 @@
+#include "../../include/io_operations/compressed_stream.h"
+#include <zlib.h>
+#include <thread>
+#ifdef ABM_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+/***************************************************************
+ * class: CompressedBuffer
+ *
+ * Stream buffer for reading or writing a compressed file
+ **************************************************************/
+
+namespace {
+	// Compression levels, defaults of the command line tools
+	const int gzip_level = 6;
+	const int zstd_level = 3;
+	// zlib window bits with gzip header and trailer
+	const int gzip_window = 15 + 16;
+
+	bool ends_with(const std::string& str, const std::string& suffix)
+	{
+		return str.size() >= suffix.size() &&
+				str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
+
+	// Compress one block into a complete gzip member
+	std::vector<char> gzip_block(const std::vector<char>& data)
+	{
+		z_stream zs;
+		zs.zalloc = Z_NULL;
+		zs.zfree = Z_NULL;
+		zs.opaque = Z_NULL;
+		if (deflateInit2(&zs, gzip_level, Z_DEFLATED, gzip_window, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			throw std::runtime_error("Failed to initialize gzip compression");
+
+		std::vector<char> out(deflateBound(&zs, data.size()));
+		zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+		zs.avail_in = static_cast<uInt>(data.size());
+		zs.next_out = reinterpret_cast<Bytef*>(out.data());
+		zs.avail_out = static_cast<uInt>(out.size());
+		const int ret = deflate(&zs, Z_FINISH);
+		out.resize(zs.total_out);
+		deflateEnd(&zs);
+		if (ret != Z_STREAM_END)
+			throw std::runtime_error("gzip compression failed");
+		return out;
+	}
+
+#ifdef ABM_WITH_ZSTD
+	// Compress one block into a complete zstd frame
+	std::vector<char> zstd_block(const std::vector<char>& data)
+	{
+		std::vector<char> out(ZSTD_compressBound(data.size()));
+		const std::size_t n = ZSTD_compress(out.data(), out.size(),
+										data.data(), data.size(), zstd_level);
+		if (ZSTD_isError(n))
+			throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(n));
+		out.resize(n);
+		return out;
+	}
+#endif
+
+	std::vector<char> compress_block(const Codec codec, const std::vector<char> data)
+	{
+#ifdef ABM_WITH_ZSTD
+		if (codec == Codec::zstd)
+			return zstd_block(data);
+#endif
+		return gzip_block(data);
+	}
+}
+
+/// Streaming decompression of concatenated members or frames
+struct CompressedBuffer::Decoder {
+	Codec codec = Codec::none;
+	// True at the end of a member or frame, i.e. where the input
+	// can be complete
+	bool at_boundary = true;
+	z_stream zs;
+#ifdef ABM_WITH_ZSTD
+	ZSTD_DStream* zds = nullptr;
+#endif
+
+	explicit Decoder(const Codec cd) : codec(cd)
+	{
+#ifdef ABM_WITH_ZSTD
+		if (codec == Codec::zstd){
+			zds = ZSTD_createDStream();
+			if (zds == nullptr)
+				throw std::runtime_error("Failed to initialize zstd decompression");
+			return;
+		}
+#endif
+		zs.zalloc = Z_NULL;
+		zs.zfree = Z_NULL;
+		zs.opaque = Z_NULL;
+		zs.next_in = Z_NULL;
+		zs.avail_in = 0;
+		if (inflateInit2(&zs, gzip_window) != Z_OK)
+			throw std::runtime_error("Failed to initialize gzip decompression");
+	}
+
+	/// Start again from the beginning of a file
+	void reset()
+	{
+		at_boundary = true;
+#ifdef ABM_WITH_ZSTD
+		if (codec == Codec::zstd){
+			ZSTD_DCtx_reset(zds, ZSTD_reset_session_only);
+			return;
+		}
+#endif
+		inflateReset(&zs);
+	}
+
+	/**
+	 * \brief Decompress as much as possible
+	 * @param in - compressed data, advanced past the consumed bytes
+	 * @param n_in - number of compressed bytes, reduced by the consumed bytes
+	 * @param out - buffer for decompressed data
+	 * @param n_out - size of the buffer
+	 * @returns number of decompressed bytes
+	 */
+	std::size_t run(const char*& in, std::size_t& n_in, char* out, const std::size_t n_out)
+	{
+#ifdef ABM_WITH_ZSTD
+		if (codec == Codec::zstd){
+			ZSTD_inBuffer ib = {in, n_in, 0};
+			ZSTD_outBuffer ob = {out, n_out, 0};
+			const std::size_t ret = ZSTD_decompressStream(zds, &ob, &ib);
+			if (ZSTD_isError(ret))
+				throw std::runtime_error(std::string("Corrupted zstd data: ") + ZSTD_getErrorName(ret));
+			in += ib.pos;
+			n_in -= ib.pos;
+			if (ib.pos > 0 || ob.pos > 0)
+				at_boundary = (ret == 0);
+			return ob.pos;
+		}
+#endif
+		zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+		zs.avail_in = static_cast<uInt>(n_in);
+		zs.next_out = reinterpret_cast<Bytef*>(out);
+		zs.avail_out = static_cast<uInt>(n_out);
+		const int ret = inflate(&zs, Z_NO_FLUSH);
+		if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+			throw std::runtime_error("Corrupted gzip data");
+
+		const std::size_t consumed = n_in - zs.avail_in;
+		in += consumed;
+		n_in -= consumed;
+		if (consumed > 0)
+			at_boundary = false;
+		if (ret == Z_STREAM_END){
+			// Next member, if any
+			inflateReset(&zs);
+			at_boundary = true;
+		}
+		return n_out - zs.avail_out;
+	}
+
+	~Decoder()
+	{
+#ifdef ABM_WITH_ZSTD
+		if (codec == Codec::zstd){
+			ZSTD_freeDStream(zds);
+			return;
+		}
+#endif
+		inflateEnd(&zs);
+	}
+};
+
+// Open the file and allocate buffers
+CompressedBuffer::CompressedBuffer(const std::string& name, const Codec cd,
+						const std::ios_base::openmode mode, const std::size_t block,
+						const int n_threads) : codec(cd), block_size(block)
+{
+	if (codec == Codec::none)
+		throw std::invalid_argument("CompressedBuffer requires a compression format");
+	if (block_size == 0)
+		throw std::invalid_argument("Compressed block size needs to be positive");
+
+	writing = (mode & std::ios_base::out) && (!(mode & std::ios_base::in) ||
+				(mode & std::ios_base::trunc) || (mode & std::ios_base::app));
+	if (writing){
+		const std::ios_base::openmode raw_mode = std::ios_base::out | std::ios_base::binary |
+					((mode & std::ios_base::app) ? std::ios_base::app : std::ios_base::trunc);
+		if (raw.open(name, raw_mode) == nullptr)
+			return;
+		int n_workers = n_threads;
+		if (n_workers <= 0)
+			n_workers = static_cast<int>(std::thread::hardware_concurrency());
+		max_in_flight = static_cast<std::size_t>(std::max(n_workers, 1));
+		this->block.resize(block_size);
+		setp(this->block.data(), this->block.data() + block_size);
+	} else {
+		if (raw.open(name, std::ios_base::in | std::ios_base::binary) == nullptr)
+			return;
+		decoder.reset(new Decoder(codec));
+		compressed.resize(block_size);
+		decompressed.resize(block_size);
+		setg(decompressed.data(), decompressed.data(), decompressed.data());
+	}
+}
+
+// Codec corresponding to the extension of a file name
+Codec CompressedBuffer::codec_from_name(const std::string& name)
+{
+	if (ends_with(name, ".gz"))
+		return Codec::gzip;
+	if (ends_with(name, ".zst")){
+#ifdef ABM_WITH_ZSTD
+		return Codec::zstd;
+#else
+		throw std::invalid_argument("Compiled without zstd support, "
+						"define ABM_WITH_ZSTD to read or write " + name);
+#endif
+	}
+	return Codec::none;
+}
+
+// Hand over the current block for compression
+void CompressedBuffer::submit_block()
+{
+	const std::size_t n = static_cast<std::size_t>(pptr() - pbase());
+	if (n == 0 && any_output)
+		return;
+	while (in_flight.size() >= max_in_flight)
+		write_front();
+
+	block.resize(n);
+	in_flight.push_back(std::async(std::launch::async, compress_block, codec, std::move(block)));
+	bytes_out += n;
+	any_output = true;
+
+	block = std::vector<char>(block_size);
+	setp(block.data(), block.data() + block_size);
+}
+
+// Write the oldest compressed block to the file
+void CompressedBuffer::write_front()
+{
+	std::future<std::vector<char>> front = std::move(in_flight.front());
+	in_flight.pop_front();
+	const std::vector<char> data = front.get();
+	const std::streamsize n = static_cast<std::streamsize>(data.size());
+	if (raw.sputn(data.data(), n) != n)
+		throw std::runtime_error("Error writing compressed data");
+}
+
+// Compress a full block and start a new one
+CompressedBuffer::int_type CompressedBuffer::overflow(int_type ch)
+{
+	if (!writing || !raw.is_open())
+		return traits_type::eof();
+	submit_block();
+	if (!traits_type::eq_int_type(ch, traits_type::eof())){
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+// Write the blocks that are already compressed
+int CompressedBuffer::sync()
+{
+	if (!writing)
+		return 0;
+	while (!in_flight.empty())
+		write_front();
+	return (raw.pubsync() == 0) ? 0 : -1;
+}
+
+// Decompress the next portion of the file
+CompressedBuffer::int_type CompressedBuffer::underflow()
+{
+	if (gptr() < egptr())
+		return traits_type::to_int_type(*gptr());
+	if (writing || !raw.is_open())
+		return traits_type::eof();
+
+	while (true){
+		if (cmp_pos == cmp_end){
+			cmp_pos = 0;
+			cmp_end = static_cast<std::size_t>(raw.sgetn(compressed.data(),
+									static_cast<std::streamsize>(compressed.size())));
+			if (cmp_end == 0){
+				if (!decoder->at_boundary)
+					throw std::runtime_error("Compressed file is truncated");
+				return traits_type::eof();
+			}
+		}
+		const char* in = compressed.data() + cmp_pos;
+		std::size_t n_in = cmp_end - cmp_pos;
+		const std::size_t n_out = decoder->run(in, n_in, decompressed.data(), decompressed.size());
+		cmp_pos = cmp_end - n_in;
+		if (n_out > 0){
+			bytes_in += static_cast<std::streamoff>(n_out);
+			setg(decompressed.data(), decompressed.data(), decompressed.data() + n_out);
+			return traits_type::to_int_type(*gptr());
+		}
+	}
+}
+
+// Supports telling the position and rewinding an input file
+CompressedBuffer::pos_type CompressedBuffer::seekoff(off_type off, std::ios_base::seekdir dir,
+										std::ios_base::openmode which)
+{
+	if (off == 0 && dir == std::ios_base::cur){
+		if (writing)
+			return pos_type(bytes_out + (pptr() - pbase()));
+		return pos_type(bytes_in - (egptr() - gptr()));
+	}
+	if (dir == std::ios_base::beg)
+		return seekpos(pos_type(off), which);
+	return pos_type(off_type(-1));
+}
+
+// Only rewinding to the beginning is supported
+CompressedBuffer::pos_type CompressedBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	if (writing || !raw.is_open() || pos != pos_type(0))
+		return pos_type(off_type(-1));
+	if (raw.pubseekpos(0, std::ios_base::in) == pos_type(off_type(-1)))
+		return pos_type(off_type(-1));
+	decoder->reset();
+	cmp_pos = cmp_end = 0;
+	bytes_in = 0;
+	setg(decompressed.data(), decompressed.data(), decompressed.data());
+	return pos_type(0);
+}
+
+// Compress and write remaining data, close the file
+bool CompressedBuffer::close()
+{
+	if (!raw.is_open())
+		return !write_error;
+	if (writing){
+		try {
+			submit_block();
+			while (!in_flight.empty())
+				write_front();
+		} catch (const std::exception& e) {
+			std::cerr << e.what() << std::endl;
+			write_error = true;
+		}
+		// Remaining tasks still need to finish
+		for (auto& task : in_flight)
+			task.wait();
+		in_flight.clear();
+	}
+	if (raw.close() == nullptr)
+		write_error = true;
+	return !write_error;
+}
+
+CompressedBuffer::~CompressedBuffer()
+{
+	close();
+}
@@ -0,0 +1,213 @@
+#include "../../include/io_operations/contact_network.h"
+
+/***************************************************************
+ * Contact network export
+ *
+ * Binary CSR form of the agent-place graph and of its
+ * agent-agent projection
+ **************************************************************/
+
+namespace {
+	// Magic string marking the header
+	const char network_magic[8] = {'A','B','M','C','S','R','0','1'};
+	// Graph types
+	const std::uint8_t bipartite_graph = 0;
+	const std::uint8_t projection_graph = 1;
+
+	// Write a vector as raw bytes
+	template <typename T>
+	void write_array(std::ostream& out, const std::vector<T>& values)
+	{
+		out.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(T));
+	}
+}
+
+// Return weight of a place type
+float ContactWeights::get(const PlaceType type) const
+{
+	switch (type){
+		case PlaceType::household:
+			return household;
+		case PlaceType::school:
+			return school;
+		case PlaceType::workplace:
+			return workplace;
+		default:
+			throw std::invalid_argument("Contact weight requested for an unknown place type");
+	}
+}
+
+//
+// ContactNetwork
+//
+
+// Index memberships of all places
+ContactNetwork::ContactNetwork(const int nag, const std::vector<Household>& households,
+					const std::vector<School>& schools, const std::vector<Workplace>& workplaces) :
+	n_agents(nag)
+{
+	if (n_agents < 0)
+		throw std::invalid_argument("Number of agents in a contact network can't be negative");
+	n_households = static_cast<std::uint32_t>(households.size());
+	n_schools = static_cast<std::uint32_t>(schools.size());
+	n_workplaces = static_cast<std::uint32_t>(workplaces.size());
+
+	place_start.push_back(0);
+	for (const auto& house : households)
+		add_place(house, PlaceType::household);
+	for (const auto& school : schools)
+		add_place(school, PlaceType::school);
+	for (const auto& work : workplaces)
+		add_place(work, PlaceType::workplace);
+
+	// Places of each agent, counting sort by agent; places
+	// are visited in order so they are sorted in each row
+	agent_start.assign(n_agents + 1, 0);
+	for (const std::uint32_t i : place_agents)
+		++agent_start[i + 1];
+	for (int i=0; i<n_agents; ++i)
+		agent_start[i + 1] += agent_start[i];
+	agent_places.resize(place_agents.size());
+	std::vector<std::uint64_t> next(agent_start.begin(), agent_start.end() - 1);
+	const std::uint32_t n_places = static_cast<std::uint32_t>(place_types.size());
+	for (std::uint32_t p = 0; p < n_places; ++p)
+		for (std::uint64_t k = place_start[p]; k < place_start[p + 1]; ++k)
+			agent_places[next[place_agents[k]]++] = p;
+}
+
+// Add members of a place, each agent once
+void ContactNetwork::add_place(const Place& place, const PlaceType type)
+{
+	// Employees of a school they attend are registered twice
+	std::vector<int> IDs = place.get_agent_IDs();
+	std::sort(IDs.begin(), IDs.end());
+	IDs.erase(std::unique(IDs.begin(), IDs.end()), IDs.end());
+	for (const int ID : IDs){
+		if (ID < 1 || ID > n_agents)
+			throw std::out_of_range("Agent ID " + std::to_string(ID)
+						+ " registered in a place is out of range");
+		place_agents.push_back(static_cast<std::uint32_t>(ID - 1));
+	}
+	place_start.push_back(place_agents.size());
+	place_types.push_back(type);
+}
+
+// Save the agent-place graph
+void ContactNetwork::write_bipartite(const std::string& fname, const ContactWeights& weights) const
+{
+	FileHandler file(fname, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	std::iostream& out = file.get_stream();
+	write_header(out, bipartite_graph, agent_start);
+	write_array(out, agent_places);
+
+	std::vector<float> edge_weights(agent_places.size());
+	for (std::size_t k = 0; k < agent_places.size(); ++k)
+		edge_weights[k] = weights.get(place_types[agent_places[k]]);
+	write_array(out, edge_weights);
+}
+
+// Save the agent-agent graph row by row
+void ContactNetwork::write_projection(const std::string& fname, const ContactWeights& weights,
+										const std::size_t block_size) const
+{
+	if (block_size == 0)
+		throw std::invalid_argument("Contact network block size has to be positive");
+
+	std::vector<float> place_weights(place_types.size());
+	for (std::size_t p = 0; p < place_types.size(); ++p)
+		place_weights[p] = weights.get(place_types[p]);
+
+	// Agents met by agent i, weights accumulated in shared_weight;
+	// last_row marks agents already found in this row
+	std::vector<std::int64_t> last_row(n_agents, -1);
+	std::vector<float> shared_weight(n_agents, 0.0f);
+	std::vector<std::uint32_t> neighbors;
+	auto project_row = [&](const std::uint32_t i){
+		neighbors.clear();
+		for (std::uint64_t a = agent_start[i]; a < agent_start[i + 1]; ++a){
+			const std::uint32_t p = agent_places[a];
+			for (std::uint64_t k = place_start[p]; k < place_start[p + 1]; ++k){
+				const std::uint32_t j = place_agents[k];
+				if (j == i)
+					continue;
+				if (last_row[j] != i){
+					last_row[j] = i;
+					shared_weight[j] = 0.0f;
+					neighbors.push_back(j);
+				}
+				shared_weight[j] += place_weights[p];
+			}
+		}
+		std::sort(neighbors.begin(), neighbors.end());
+	};
+
+	// First pass - size of each row
+	std::vector<std::uint64_t> row_start(n_agents + 1, 0);
+	for (int i=0; i<n_agents; ++i){
+		project_row(static_cast<std::uint32_t>(i));
+		row_start[i + 1] = row_start[i] + neighbors.size();
+	}
+
+	FileHandler file(fname, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	std::iostream& out = file.get_stream();
+	write_header(out, projection_graph, row_start);
+
+	// Second pass - columns, weights of each block are kept
+	// in a temporary file until all the columns are written
+	const std::string weights_name = fname + ".weights.tmp";
+	{
+		FileHandler weights_file(weights_name,
+					std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		std::iostream& weights_out = weights_file.get_stream();
+		std::vector<std::uint32_t> column_block;
+		std::vector<float> weight_block;
+		column_block.reserve(block_size);
+		weight_block.reserve(block_size);
+		auto flush = [&](){
+			write_array(out, column_block);
+			write_array(weights_out, weight_block);
+			column_block.clear();
+			weight_block.clear();
+		};
+		std::fill(last_row.begin(), last_row.end(), -1);
+		for (int i=0; i<n_agents; ++i){
+			project_row(static_cast<std::uint32_t>(i));
+			for (const std::uint32_t j : neighbors){
+				column_block.push_back(j);
+				weight_block.push_back(shared_weight[j]);
+				if (column_block.size() == block_size)
+					flush();
+			}
+		}
+		flush();
+	}
+
+	// Append the weights
+	{
+		FileHandler weights_file(weights_name, std::ios_base::in | std::ios_base::binary);
+		std::iostream& weights_in = weights_file.get_stream();
+		std::vector<char> buffer(block_size*sizeof(float));
+		while (weights_in.read(buffer.data(), buffer.size()) || weights_in.gcount() > 0)
+			out.write(buffer.data(), weights_in.gcount());
+	}
+	std::remove(weights_name.c_str());
+
+	if (!out)
+		throw std::runtime_error("Error writing contact network to " + fname);
+}
+
+// Save the header and row starts
+void ContactNetwork::write_header(std::ostream& out, const std::uint8_t graph_type,
+						const std::vector<std::uint64_t>& row_start) const
+{
+	const std::uint32_t n_rows = static_cast<std::uint32_t>(n_agents);
+	const std::uint64_t n_edges = row_start.back();
+	out.write(network_magic, sizeof(network_magic));
+	out.write(reinterpret_cast<const char*>(&graph_type), sizeof(graph_type));
+	out.write(reinterpret_cast<const char*>(&n_rows), sizeof(n_rows));
+	out.write(reinterpret_cast<const char*>(&n_households), sizeof(n_households));
+	out.write(reinterpret_cast<const char*>(&n_schools), sizeof(n_schools));
+	out.write(reinterpret_cast<const char*>(&n_workplaces), sizeof(n_workplaces));
+	out.write(reinterpret_cast<const char*>(&n_edges), sizeof(n_edges));
+	write_array(out, row_start);
+}
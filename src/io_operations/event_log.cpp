@@ -0,0 +1,147 @@
+#include "../../include/io_operations/event_log.h"
+#include "../../include/tracer.h"
+
+/***************************************************************
+ * class: EventLog
+ *
+ * Collects transition events in per-thread buffers and writes
+ * them to a file asynchronously
+ **************************************************************/
+
+namespace {
+	const char event_magic[8] = {'A','B','M','E','V','N','T','1'};
+}
+
+// Create buffers, write the header, and start the writing thread
+EventLog::EventLog(const std::string name, const double del_t, const int n_slots,
+						const int buffer_events) :
+	file(name, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc), dt(del_t)
+{
+	if (n_slots < 1)
+		throw std::invalid_argument("Event log needs at least one buffer slot");
+	if (buffer_events < 1)
+		throw std::invalid_argument("Event log buffer needs to hold at least one event");
+	buffer_size = static_cast<std::size_t>(buffer_events);
+
+	buffers.resize(n_slots);
+	for (auto& buffer : buffers)
+		buffer.reserve(buffer_size);
+
+	std::iostream &out = file.get_stream();
+	const std::uint32_t rec_size = sizeof(TransitionEvent);
+	out.write(event_magic, sizeof(event_magic));
+	out.write(reinterpret_cast<const char*>(&dt), sizeof(dt));
+	out.write(reinterpret_cast<const char*>(&rec_size), sizeof(rec_size));
+
+	writer = std::thread(&EventLog::write_loop, this);
+}
+
+// Create and store an event
+void EventLog::record(const double time, const int agent_ID, const TransitionType type,
+						const PlaceType place_type, const int place_ID, const int slot)
+{
+	TransitionEvent event;
+	event.step = static_cast<std::uint32_t>(std::lround(time/dt));
+	event.agent_ID = agent_ID;
+	event.type = static_cast<std::uint8_t>(type);
+	event.place_type = static_cast<std::uint8_t>(place_type);
+	event.place_ID = place_ID;
+	record(event, slot);
+}
+
+// Hand over buffer from a slot, replace with a spare one
+void EventLog::submit(const int slot)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	pending.push_back(std::move(buffers[slot]));
+	++in_flight;
+	if (spare.empty()){
+		buffers[slot] = std::vector<TransitionEvent>();
+		buffers[slot].reserve(buffer_size);
+	} else {
+		buffers[slot] = std::move(spare.back());
+		spare.pop_back();
+	}
+	work_ready.notify_one();
+}
+
+// Write all the buffered events and wait until done
+void EventLog::flush()
+{
+	for (int i = 0; i < static_cast<int>(buffers.size()); ++i){
+		if (!buffers[i].empty())
+			submit(i);
+	}
+	std::unique_lock<std::mutex> lock(mtx);
+	work_done.wait(lock, [this]{ return in_flight == 0; });
+	file.get_stream().flush();
+}
+
+// Writing thread loop
+void EventLog::write_loop()
+{
+	std::iostream &out = file.get_stream();
+	std::unique_lock<std::mutex> lock(mtx);
+	while (true){
+		work_ready.wait(lock, [this]{ return stop || !pending.empty(); });
+		if (pending.empty() && stop)
+			break;
+
+		std::vector<TransitionEvent> buffer = std::move(pending.front());
+		pending.pop_front();
+
+		// Write without holding the lock
+		lock.unlock();
+		{
+			ABM_TRACE_SCOPE("event_log_write", "io");
+			out.write(reinterpret_cast<const char*>(buffer.data()),
+						buffer.size()*sizeof(TransitionEvent));
+		}
+		buffer.clear();
+		lock.lock();
+
+		spare.push_back(std::move(buffer));
+		--in_flight;
+		work_done.notify_all();
+	}
+}
+
+// Load all the events from a log file
+std::vector<TransitionEvent> EventLog::read_events(const std::string name)
+{
+	FileHandler file(name, std::ios_base::in | std::ios_base::binary);
+	std::iostream &in = file.get_stream();
+
+	char magic[8];
+	double time_step = 0.0;
+	std::uint32_t rec_size = 0;
+	in.read(magic, sizeof(magic));
+	in.read(reinterpret_cast<char*>(&time_step), sizeof(time_step));
+	in.read(reinterpret_cast<char*>(&rec_size), sizeof(rec_size));
+	if (!in || std::memcmp(magic, event_magic, sizeof(magic)) != 0)
+		throw std::runtime_error("Not a transition event log file");
+	if (rec_size != sizeof(TransitionEvent))
+		throw std::runtime_error("Transition event log has incompatible record size");
+
+	std::vector<TransitionEvent> events;
+	TransitionEvent event;
+	while (in.read(reinterpret_cast<char*>(&event), sizeof(event)))
+		events.push_back(event);
+	if (in.bad())
+		throw std::runtime_error("Error reading transition event log " + name);
+	// Reaching the end sets the failbit
+	in.clear();
+	return events;
+}
+
+// Flush and stop the writing thread
+EventLog::~EventLog()
+{
+	flush();
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stop = true;
+	}
+	work_ready.notify_one();
+	writer.join();
+}
@@ -0,0 +1,91 @@
+#include "../../include/io_operations/input_validation.h"
+
+/***************************************************************
+ * class: InputValidator
+ *
+ * Checks of population input done while parsing it
+ **************************************************************/
+
+// Start checking a line
+bool InputValidator::next_line(const int line_number, const std::vector<std::string>& entries,
+									const std::size_t n_cols)
+{
+	line = line_number;
+	if (entries.size() < n_cols){
+		add_error("expected at least " + std::to_string(n_cols) + " entries, found "
+						+ std::to_string(entries.size()));
+		return false;
+	}
+	return true;
+}
+
+// Convert an entry to an integer, the whole entry has to be used
+int InputValidator::get_int(const std::vector<std::string>& entries, const std::size_t col,
+								const std::string& what)
+{
+	const std::string& entry = entries[col];
+	std::size_t pos = 0;
+	try {
+		const int value = std::stoi(entry, &pos);
+		if (pos == entry.size())
+			return value;
+	} catch (const std::logic_error&) { }
+	add_error(what + " is not an integer: '" + entry + "'");
+	return 0;
+}
+
+// Convert an entry to a double, the whole entry has to be used
+double InputValidator::get_double(const std::vector<std::string>& entries, const std::size_t col,
+								const std::string& what)
+{
+	const std::string& entry = entries[col];
+	std::size_t pos = 0;
+	try {
+		const double value = std::stod(entry, &pos);
+		if (pos == entry.size())
+			return value;
+	} catch (const std::logic_error&) { }
+	add_error(what + " is not a number: '" + entry + "'");
+	return 0.0;
+}
+
+// Convert an entry that has to be 0 or 1
+bool InputValidator::get_flag(const std::vector<std::string>& entries, const std::size_t col,
+								const std::string& what)
+{
+	const std::string& entry = entries[col];
+	if (entry == "1")
+		return true;
+	if (entry != "0")
+		add_error(what + " has to be 0 or 1, found '" + entry + "'");
+	return false;
+}
+
+// Check if an ID is in the range [1, n_max]
+void InputValidator::check_ID(const int ID, const int n_max, const std::string& what)
+{
+	if (ID < 1 || ID > n_max)
+		add_error(what + " " + std::to_string(ID) + " out of range [1, "
+						+ std::to_string(n_max) + "]");
+}
+
+// Record an error on the current line
+void InputValidator::add_error(const std::string& msg)
+{
+	++n_errors;
+	if (messages.size() < max_reported)
+		messages.push_back(fname + ":" + std::to_string(line) + ": " + msg);
+}
+
+// Throw listing all the errors, if any
+void InputValidator::throw_if_invalid() const
+{
+	if (n_errors == 0)
+		return;
+	std::string report = std::to_string(n_errors) + " error(s) in " + fname;
+	for (const auto& msg : messages)
+		report += "\n\t" + msg;
+	if (n_errors > messages.size())
+		report += "\n\t... and " + std::to_string(n_errors - messages.size()) + " more";
+	throw std::invalid_argument(report);
+}
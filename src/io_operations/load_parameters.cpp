@@ -11,7 +11,7 @@
 std::map<std::string, double> LoadParameters::load_parameter_map(const std::string infile)
 {
 	FileHandler file(infile);
-	std::fstream &in = file.get_stream();
+	std::iostream &in = file.get_stream();
 	std::string line;
 
 	std::map<std::string, double> parameters;
@@ -41,6 +41,49 @@ std::map<std::string, double> LoadParameters::load_parameter_map(const std::stri
 		parameters[tag] = std::stod(word);
 		tag.clear();
 	}
+	if (in.bad())
+		throw std::runtime_error("Error reading file " + infile);
+	return parameters;
+}
+
+// Read lists of parameter values from file, store as a map
+std::map<std::string, std::vector<double>> LoadParameters::load_parameter_lists(const std::string infile)
+{
+	FileHandler file(infile);
+	std::iostream &in = file.get_stream();
+	std::string line;
+
+	std::map<std::string, std::vector<double>> parameters;
+
+	std::string tag = {}, word = {};
+
+	while (std::getline(in, line)){
+		
+		std::istringstream data_row(line);
+
+		// Tag, same as for single values
+		if (line.find("//") != std::string::npos){
+			data_row >> word;
+			while (data_row >> word)
+				tag += (word + " ");
+			if (!tag.empty())
+				tag.pop_back();
+			continue;
+		}
+
+		// All the numbers in the line
+		std::vector<double> values;
+		while (data_row >> word)
+			values.push_back(std::stod(word));
+		if (values.empty())
+			continue;
+		if (tag.empty())
+			throw std::invalid_argument("Values without a parameter name in " + infile);
+		parameters[tag] = values;
+		tag.clear();
+	}
+	if (in.bad())
+		throw std::runtime_error("Error reading file " + infile);
 	return parameters;
 }
 
@@ -48,7 +91,7 @@ std::map<std::string, double> LoadParameters::load_parameter_map(const std::stri
 std::map<std::string, double> LoadParameters::load_age_dependent(const std::string infile)
 {
 	FileHandler file(infile);
-	std::fstream &in = file.get_stream();
+	std::iostream &in = file.get_stream();
 	std::string line;
 
 	std::map<std::string, double> age_distribution;
@@ -70,6 +113,8 @@ std::map<std::string, double> LoadParameters::load_age_dependent(const std::stri
 		// Assign
 		age_distribution[tag] = value;
 	}
+	if (in.bad())
+		throw std::runtime_error("Error reading file " + infile);
 
 	return age_distribution;
 }
@@ -0,0 +1,230 @@
+#include "../../include/io_operations/population_generator.h"
+#include "../../include/io_operations/block_writer.h"
+#include "../../include/utils.h"
+#include <thread>
+#include <cstdio>
+
+/***************************************************************
+ * class: PopulationGenerator
+ *
+ * Random synthetic population in the model input format
+ *
+ **************************************************************/
+
+namespace {
+	// Number of places or agents generated with one seed
+	const int chunk_size = 1 << 16;
+	// Separate random streams of each kind of object
+	const unsigned int household_stream = 0;
+	const unsigned int school_stream = 1;
+	const unsigned int workplace_stream = 2;
+	const unsigned int agent_stream = 3;
+
+	// School types and the ages that attend them
+	const std::vector<std::string> school_type_names = {"daycare", "primary", "middle", "high", "college"};
+	const std::vector<int> school_type_min_age = {2, 5, 11, 14, 18};
+	const int max_student_age = 22;
+	// Order in which types are given to schools, more of the younger ones
+	const std::vector<int> school_type_cycle = {1, 0, 2, 1, 3, 0, 1, 4};
+	// Working age
+	const int min_worker_age = 18;
+	const int max_worker_age = 65;
+
+	// Number of chunks for n objects
+	int number_of_chunks(const int n)
+	{
+		return (n + chunk_size - 1)/chunk_size;
+	}
+
+	// Generator of one chunk of one kind of objects
+	std::mt19937 chunk_generator(const unsigned int seed, const unsigned int stream, const int chunk)
+	{
+		std::seed_seq seq{seed, stream, static_cast<unsigned int>(chunk)};
+		return std::mt19937(seq);
+	}
+
+	// Uniform integer ID in [1, n]
+	int random_ID(std::mt19937& gen, const int n)
+	{
+		std::uniform_int_distribution<int> dist(1, n);
+		return dist(gen);
+	}
+}
+
+// Place numbers proportional to the number of agents
+PopulationSettings PopulationSettings::scaled(const int n)
+{
+	PopulationSettings population;
+	population.n_agents = n;
+	population.n_households = std::max(1, static_cast<int>(n/2.6));
+	population.n_schools = std::max(1, n/1000);
+	population.n_workplaces = std::max(1, n/20);
+	return population;
+}
+
+// Check the settings and generate all the places
+PopulationGenerator::PopulationGenerator(const PopulationSettings& population,
+						const unsigned int seed, const unsigned int n_thr) :
+	settings(population), base_seed(seed)
+{
+	if (settings.n_agents < 0 || settings.n_households < 0
+			|| settings.n_schools < 0 || settings.n_workplaces < 0)
+		throw std::invalid_argument("Number of agents and places can't be negative");
+	if (settings.n_agents > 0 && settings.n_households == 0)
+		throw std::invalid_argument("Agents need at least one household");
+	if (settings.n_schools == 0 && (settings.student_probability > 0.0
+			|| (settings.employment_probability > 0.0 && settings.school_employee_probability > 0.0)))
+		throw std::invalid_argument("Students and school employees need at least one school");
+	if (settings.n_workplaces == 0 && settings.employment_probability > 0.0
+			&& settings.school_employee_probability < 1.0)
+		throw std::invalid_argument("Workers need at least one workplace");
+	if (settings.x_min > settings.x_max || settings.y_min > settings.y_max
+			|| settings.age_std < 0.0 || settings.max_age < 0)
+		throw std::invalid_argument("Wrong spatial limits or age distribution");
+	for (const double prob : {settings.student_probability, settings.employment_probability,
+				settings.school_employee_probability, settings.infected_probability})
+		if (prob < 0.0 || prob > 1.0)
+			throw std::invalid_argument("Probabilities need to be in [0, 1]");
+
+	n_threads = n_thr;
+	if (n_threads == 0)
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	household_locations = generate_locations(settings.n_households, household_stream);
+	school_locations = generate_locations(settings.n_schools, school_stream);
+	workplace_locations = generate_locations(settings.n_workplaces, workplace_stream);
+
+	school_types.resize(settings.n_schools);
+	schools_by_type.resize(school_type_names.size());
+	for (int i=0; i<settings.n_schools; ++i){
+		school_types.at(i) = school_type_cycle.at(i % school_type_cycle.size());
+		schools_by_type.at(school_types.at(i)).push_back(i + 1);
+	}
+}
+
+// Random locations of n places
+std::vector<std::string> PopulationGenerator::generate_locations(const int n, const unsigned int stream) const
+{
+	std::vector<std::string> locations(n);
+	parallel_for(0, number_of_chunks(n), n_threads, [&](const int chunk){
+			std::mt19937 gen = chunk_generator(base_seed, stream, chunk);
+			std::uniform_real_distribution<double> x_dist(settings.x_min, settings.x_max);
+			std::uniform_real_distribution<double> y_dist(settings.y_min, settings.y_max);
+			char text[64];
+			const int last = std::min(n, (chunk + 1)*chunk_size);
+			for (int i = chunk*chunk_size; i < last; ++i){
+				const double x = x_dist(gen);
+				const double y = y_dist(gen);
+				std::snprintf(text, sizeof(text), "%.6f %.6f", x, y);
+				locations[i] = text;
+			}
+		});
+	return locations;
+}
+
+// Households as ID, x, y
+void PopulationGenerator::write_households(const std::string& fname) const
+{
+	write_places(fname, household_locations);
+}
+
+// Schools as ID, x, y, and school type
+void PopulationGenerator::write_schools(const std::string& fname) const
+{
+	std::vector<std::string> types;
+	for (const int type : school_types)
+		types.push_back(school_type_names.at(type));
+	write_places(fname, school_locations, types);
+}
+
+// Workplaces as ID, x, y
+void PopulationGenerator::write_workplaces(const std::string& fname) const
+{
+	write_places(fname, workplace_locations);
+}
+
+// Write places as ID and location, with optional extra column
+void PopulationGenerator::write_places(const std::string& fname, const std::vector<std::string>& locations,
+						const std::vector<std::string>& extra) const
+{
+	BlockWriter out(fname);
+	for (std::size_t i = 0; i < locations.size(); ++i){
+		out << static_cast<int>(i + 1) << ' ' << locations[i];
+		if (!extra.empty())
+			out << ' ' << extra.at(i);
+		out << '\n';
+	}
+}
+
+// Generate agents in batches of chunks and write them in order
+void PopulationGenerator::write_agents(const std::string& fname) const
+{
+	BlockWriter out(fname);
+
+	const int n_chunks = number_of_chunks(settings.n_agents);
+	const int batch_size = 4*static_cast<int>(n_threads);
+	std::vector<std::vector<GeneratedAgent>> batch(batch_size);
+	for (int first = 0; first < n_chunks; first += batch_size){
+		const int last = std::min(n_chunks, first + batch_size);
+		parallel_for(first, last, n_threads, [&](const int chunk){
+				generate_agent_chunk(chunk, batch[chunk - first]);
+			});
+		for (int chunk = first; chunk < last; ++chunk){
+			for (const GeneratedAgent& agent : batch[chunk - first]){
+				out << ((agent.school_ID > 0) ? "1 " : "0 ")
+					<< ((agent.work_ID > 0) ? "1 " : "0 ")
+					<< agent.age << ' ' << household_locations[agent.house_ID - 1] << ' '
+					<< agent.house_ID << ' ' << agent.school_ID
+					<< (agent.works_at_school ? " 1 " : " 0 ")
+					<< agent.work_ID << (agent.infected ? " 1\n" : " 0\n");
+			}
+		}
+	}
+}
+
+// Agents of one chunk
+void PopulationGenerator::generate_agent_chunk(const int chunk, std::vector<GeneratedAgent>& out) const
+{
+	out.clear();
+	std::mt19937 gen = chunk_generator(base_seed, agent_stream, chunk);
+	std::normal_distribution<double> age_dist(settings.age_mean, settings.age_std);
+	std::uniform_real_distribution<double> unif(0.0, 1.0);
+
+	const int last = std::min(settings.n_agents, (chunk + 1)*chunk_size);
+	for (int i = chunk*chunk_size; i < last; ++i){
+		const int age = std::min(settings.max_age,
+							std::max(0, static_cast<int>(std::round(age_dist(gen)))));
+		const int house_ID = random_ID(gen, settings.n_households);
+
+		// School of the age group if there is one, any school otherwise
+		int school_ID = 0;
+		if (age >= school_type_min_age.front() && age <= max_student_age
+				&& unif(gen) < settings.student_probability){
+			const int type = static_cast<int>(std::upper_bound(school_type_min_age.begin(),
+								school_type_min_age.end(), age) - school_type_min_age.begin()) - 1;
+			const std::vector<int>& of_type = schools_by_type.at(type);
+			if (of_type.empty())
+				school_ID = random_ID(gen, settings.n_schools);
+			else
+				school_ID = of_type.at(random_ID(gen, static_cast<int>(of_type.size())) - 1);
+		}
+
+		int work_ID = 0;
+		bool works_at_school = false;
+		if (age >= min_worker_age && age <= max_worker_age
+				&& unif(gen) < settings.employment_probability){
+			works_at_school = unif(gen) < settings.school_employee_probability;
+			work_ID = random_ID(gen, works_at_school ? settings.n_schools : settings.n_workplaces);
+		}
+		const bool infected = unif(gen) < settings.infected_probability;
+
+		GeneratedAgent agent;
+		agent.age = age;
+		agent.house_ID = house_ID;
+		agent.school_ID = school_ID;
+		agent.work_ID = work_ID;
+		agent.works_at_school = works_at_school;
+		agent.infected = infected;
+		out.push_back(agent);
+	}
+}
@@ -0,0 +1,189 @@
+#include "../../include/io_operations/population_tiling.h"
+#include "../../include/io_operations/FileHandler.h"
+#include "../../include/io_operations/block_writer.h"
+#include "../../include/io_operations/input_validation.h"
+#include <limits>
+
+/***************************************************************
+ * class: PopulationTiling
+ *
+ * Larger population made of copies of a real one
+ *
+ **************************************************************/
+
+namespace {
+	// Space between tiles, fraction of the tile size
+	const double tile_margin = 0.1;
+
+	// Entries of every non-empty line of a file
+	std::vector<std::vector<std::string>> read_entries(const std::string& fname)
+	{
+		FileHandler file(fname, std::ios_base::in);
+		std::iostream& in = file.get_stream();
+		std::vector<std::vector<std::string>> lines;
+		std::string line, entry;
+		while (std::getline(in, line)){
+			std::istringstream entries(line);
+			std::vector<std::string> parsed;
+			while (entries >> entry)
+				parsed.push_back(entry);
+			if (!parsed.empty())
+				lines.push_back(parsed);
+		}
+		if (in.bad())
+			throw std::runtime_error("Error reading file " + fname);
+		return lines;
+	}
+}
+
+// Read all the files and find the size of a tile
+PopulationTiling::PopulationTiling(const std::string& hfile, const std::string& sfile,
+						const std::string& wfile, const std::string& afile)
+{
+	households = read_places(hfile);
+	schools = read_places(sfile);
+	workplaces = read_places(wfile);
+
+	InputValidator check(afile);
+	int line = 0;
+	for (const auto& entries : read_entries(afile)){
+		if (!check.next_line(++line, entries, 10))
+			continue;
+		TiledAgent agent;
+		agent.student = check.get_flag(entries, 0, "student flag");
+		agent.works = check.get_flag(entries, 1, "works flag");
+		agent.age = check.get_int(entries, 2, "age");
+		agent.x = check.get_double(entries, 3, "x coordinate");
+		agent.y = check.get_double(entries, 4, "y coordinate");
+		agent.house_ID = check.get_int(entries, 5, "household ID");
+		agent.school_ID = check.get_int(entries, 6, "school ID");
+		agent.works_at_school = check.get_flag(entries, 7, "school employee flag");
+		agent.work_ID = check.get_int(entries, 8, "work ID");
+		agent.infected = check.get_flag(entries, 9, "infection status");
+		agents.push_back(agent);
+	}
+	check.throw_if_invalid();
+
+	// Bounding box of everything that has a location
+	double x_min = 0.0, x_max = 0.0, y_min = 0.0, y_max = 0.0;
+	bool first = true;
+	auto extend = [&](const double x, const double y){
+		if (first){
+			x_min = x_max = x;
+			y_min = y_max = y;
+			first = false;
+		}
+		x_min = std::min(x_min, x);
+		x_max = std::max(x_max, x);
+		y_min = std::min(y_min, y);
+		y_max = std::max(y_max, y);
+	};
+	for (const auto& places : {&households, &schools, &workplaces})
+		for (const auto& place : *places)
+			extend(place.x, place.y);
+	for (const auto& agent : agents)
+		extend(agent.x, agent.y);
+
+	width = (x_max - x_min)*(1.0 + tile_margin);
+	height = (y_max - y_min)*(1.0 + tile_margin);
+	if (width <= 0.0)
+		width = 1.0;
+	if (height <= 0.0)
+		height = 1.0;
+}
+
+// Read places with ID, x, y, and possibly more entries
+std::vector<PopulationTiling::TiledPlace> PopulationTiling::read_places(const std::string& fname)
+{
+	InputValidator check(fname);
+	std::vector<TiledPlace> places;
+	int line = 0;
+	for (const auto& entries : read_entries(fname)){
+		if (!check.next_line(++line, entries, 3))
+			continue;
+		const int ID = check.get_int(entries, 0, "place ID");
+		if (ID != static_cast<int>(places.size()) + 1)
+			check.add_error("place IDs not continuous, expected " + std::to_string(places.size() + 1));
+		TiledPlace place;
+		place.x = check.get_double(entries, 1, "x coordinate");
+		place.y = check.get_double(entries, 2, "y coordinate");
+		for (std::size_t i = 3; i < entries.size(); ++i)
+			place.rest += " " + entries.at(i);
+		places.push_back(place);
+	}
+	check.throw_if_invalid();
+	return places;
+}
+
+// Shift of coordinates of a tile on a square grid
+std::pair<double, double> PopulationTiling::get_tile_shift(const int tile, const int n_tiles) const
+{
+	const int n_cols = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n_tiles))));
+	return {(tile % n_cols)*width, (tile / n_cols)*height};
+}
+
+// Write n_tiles copies of the population
+void PopulationTiling::write(const std::string& hfile, const std::string& sfile,
+				const std::string& wfile, const std::string& afile,
+				const int n_tiles, const double commuter_fraction, const unsigned int seed) const
+{
+	if (n_tiles < 1)
+		throw std::invalid_argument("Number of tiles needs to be at least 1");
+	if (commuter_fraction < 0.0 || commuter_fraction > 1.0)
+		throw std::invalid_argument("Fraction of commuters needs to be in [0, 1]");
+	const long long max_ID = static_cast<long long>(n_tiles)
+				*std::max({agents.size(), households.size(), schools.size(), workplaces.size()});
+	if (max_ID > std::numeric_limits<int>::max())
+		throw std::invalid_argument("Too many tiles, IDs would not fit in an int");
+
+	write_places(hfile, households, n_tiles);
+	write_places(sfile, schools, n_tiles);
+	write_places(wfile, workplaces, n_tiles);
+
+	BlockWriter out(afile);
+	const int n_houses = get_number_of_households();
+	const int n_schools = get_number_of_schools();
+	const int n_works = get_number_of_workplaces();
+
+	for (int tile = 0; tile < n_tiles; ++tile){
+		const std::pair<double, double> shift = get_tile_shift(tile, n_tiles);
+		// Same commuters for a tile regardless of the number of tiles after it
+		std::seed_seq seq{seed, static_cast<unsigned int>(tile)};
+		std::mt19937 gen(seq);
+		std::uniform_real_distribution<double> unif(0.0, 1.0);
+		std::uniform_int_distribution<int> other_tile(1, std::max(1, n_tiles - 1));
+
+		for (const auto& agent : agents){
+			int work_ID = 0;
+			if (agent.works){
+				int work_tile = tile;
+				if (!agent.works_at_school && n_tiles > 1 && unif(gen) < commuter_fraction)
+					work_tile = (tile + other_tile(gen)) % n_tiles;
+				work_ID = agent.work_ID + work_tile*(agent.works_at_school ? n_schools : n_works);
+			}
+			out << (agent.student ? "1 " : "0 ") << (agent.works ? "1 " : "0 ") << agent.age << ' ';
+			out.write_fixed(agent.x + shift.first) << ' ';
+			out.write_fixed(agent.y + shift.second) << ' ';
+			out << agent.house_ID + tile*n_houses << ' '
+				<< (agent.student ? agent.school_ID + tile*n_schools : 0)
+				<< (agent.works_at_school ? " 1 " : " 0 ")
+				<< work_ID << (agent.infected ? " 1\n" : " 0\n");
+		}
+	}
+}
+
+// Write places of all tiles with continuous IDs
+void PopulationTiling::write_places(const std::string& fname, const std::vector<TiledPlace>& places,
+						const int n_tiles) const
+{
+	BlockWriter out(fname);
+	int ID = 1;
+	for (int tile = 0; tile < n_tiles; ++tile){
+		const std::pair<double, double> shift = get_tile_shift(tile, n_tiles);
+		for (const auto& place : places){
+			out << ID++ << ' ';
+			out.write_fixed(place.x + shift.first) << ' ';
+			out.write_fixed(place.y + shift.second) << place.rest << '\n';
+		}
+	}
+}
@@ -0,0 +1,123 @@
+#include "../include/parameter_sweep.h"
+
+/*****************************************************
+ * class: ParameterSweep
+ *
+ * Runs a model for many sets of infection parameters
+ * in one process
+ *
+ ******************************************************/
+
+// All combinations of values of each parameter
+std::vector<ParameterSet> ParameterSweep::grid(const std::map<std::string, std::vector<double>>& values)
+{
+	std::vector<ParameterSet> sets = {ParameterSet()};
+	for (const auto& param : values){
+		if (param.second.empty())
+			throw std::invalid_argument("No values for parameter: " + param.first);
+		std::vector<ParameterSet> extended;
+		for (const auto& set : sets){
+			for (const double value : param.second){
+				extended.push_back(set);
+				extended.back()[param.first] = value;
+			}
+		}
+		std::swap(sets, extended);
+	}
+	return sets;
+}
+
+// Parameter sets made of i-th value of every parameter
+std::vector<ParameterSet> ParameterSweep::list(const std::map<std::string, std::vector<double>>& values)
+{
+	if (values.empty())
+		return {};
+	const std::size_t n_sets = values.begin()->second.size();
+	std::vector<ParameterSet> sets(n_sets);
+	for (const auto& param : values){
+		if (param.second.size() != n_sets)
+			throw std::invalid_argument("Wrong number of values for parameter: " + param.first);
+		for (std::size_t i = 0; i < n_sets; ++i)
+			sets[i][param.first] = param.second[i];
+	}
+	return sets;
+}
+
+// Latin hypercube sample of parameter ranges
+std::vector<ParameterSet> ParameterSweep::latin_hypercube(const std::map<std::string,
+						std::vector<double>>& ranges, const int n_sets, const unsigned int seed)
+{
+	if (n_sets < 1)
+		throw std::invalid_argument("Latin hypercube needs at least one parameter set");
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<double> unif(0.0, 1.0);
+	std::vector<ParameterSet> sets(n_sets);
+	std::vector<int> intervals(n_sets);
+	for (const auto& param : ranges){
+		if (param.second.size() != 2 || param.second[0] > param.second[1])
+			throw std::invalid_argument("Range of parameter " + param.first
+						+ " needs to be a minimum and a maximum value");
+		const double pmin = param.second[0], width = param.second[1] - param.second[0];
+		// Each interval used by a different set
+		std::iota(intervals.begin(), intervals.end(), 0);
+		std::shuffle(intervals.begin(), intervals.end(), gen);
+		for (int i=0; i<n_sets; ++i)
+			sets[i][param.first] = pmin + width*(intervals[i] + unif(gen))/n_sets;
+	}
+	return sets;
+}
+
+// Run replicates for every parameter set
+std::vector<std::vector<double>> ParameterSweep::run(const std::vector<ParameterSet>& sets,
+						const int n_replicates,
+						const std::function<std::vector<double>(ABM&, const int, const int)>& replicate,
+						const unsigned int base_seed) const
+{
+	if (n_replicates < 0)
+		throw std::invalid_argument("Number of replicates can't be negative");
+	// Fail before running anything
+	const std::map<std::string, double> base = ensemble.get_population().get_infection_parameters();
+	for (const auto& set : sets)
+		for (const auto& param : set)
+			if (base.find(param.first) == base.end())
+				throw std::invalid_argument("Unknown infection parameter: " + param.first);
+
+	std::function<std::vector<double>(ABM&, const int)> one_run =
+		[&](ABM& abm, const int i){
+			const int set_index = i/n_replicates;
+			abm.set_infection_parameters(sets[set_index]);
+			return replicate(abm, set_index, i%n_replicates);
+		};
+	return ensemble.run(static_cast<int>(sets.size())*n_replicates, one_run, base_seed);
+}
+
+// Save results of all runs in one file
+void ParameterSweep::save_results(const std::string& fname, const std::vector<ParameterSet>& sets,
+						const int n_replicates, const std::vector<std::vector<double>>& results,
+						const std::vector<std::string>& result_names)
+{
+	if (results.size() != sets.size()*static_cast<std::size_t>(n_replicates))
+		throw std::invalid_argument("Number of results does not match the parameter sets");
+
+	FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
+	std::iostream& out = file.get_stream();
+
+	// Column names, parameters are the same in all sets
+	out << "// set, replicate";
+	if (!sets.empty())
+		for (const auto& param : sets.front())
+			out << ", " << param.first;
+	for (const auto& name : result_names)
+		out << ", " << name;
+	out << '\n';
+
+	out.precision(10);
+	for (std::size_t i = 0; i < results.size(); ++i){
+		out << i/n_replicates << " " << i%n_replicates;
+		for (const auto& param : sets[i/n_replicates])
+			out << " " << param.second;
+		for (const double value : results[i])
+			out << " " << value;
+		out << '\n';
+	}
+}
@@ -0,0 +1,172 @@
+#include "../include/perf_counters.h"
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/***************************************************************
+ * class: PerfCounters
+ *
+ * Hardware performance counters of the calling thread
+ **************************************************************/
+
+namespace {
+	const std::size_t n_events = CounterValues::n_events;
+
+	std::atomic<bool> counting{false};
+	std::mutex error_mutex;
+	std::string open_error;
+
+	// Counters of one thread, one group led by the cycle counter
+	struct ThreadCounters {
+		std::array<int, n_events> fds = {{-1, -1, -1, -1}};
+		// Position of each open event in the group read
+		std::array<int, n_events> slots = {{-1, -1, -1, -1}};
+		int n_open = 0;
+		bool tried = false;
+
+		~ThreadCounters()
+		{
+#ifdef __linux__
+			for (const int fd : fds)
+				if (fd >= 0)
+					close(fd);
+#endif
+		}
+	};
+
+	thread_local ThreadCounters thread_counters;
+
+#ifdef __linux__
+	// Linux event configuration of each event
+	std::uint64_t event_config(const std::size_t i)
+	{
+		switch (static_cast<PerfEvent>(i)){
+			case PerfEvent::cycles: return PERF_COUNT_HW_CPU_CYCLES;
+			case PerfEvent::instructions: return PERF_COUNT_HW_INSTRUCTIONS;
+			case PerfEvent::llc_misses: return PERF_COUNT_HW_CACHE_MISSES;
+			case PerfEvent::branch_misses: return PERF_COUNT_HW_BRANCH_MISSES;
+			default: throw std::invalid_argument("Not a hardware event");
+		}
+	}
+
+	int open_event(const std::size_t i, const int group)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = event_config(i);
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+							| PERF_FORMAT_TOTAL_TIME_RUNNING;
+		// User space only, allowed with the default paranoid level
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group, 0));
+	}
+#endif
+
+	// Open counters of the calling thread once, true if cycles work
+	bool open_thread_counters()
+	{
+		ThreadCounters& tc = thread_counters;
+		if (tc.tried)
+			return tc.n_open > 0;
+		tc.tried = true;
+#ifdef __linux__
+		const std::size_t leader = static_cast<std::size_t>(PerfEvent::cycles);
+		tc.fds[leader] = open_event(leader, -1);
+		if (tc.fds[leader] < 0){
+			std::lock_guard<std::mutex> lock(error_mutex);
+			open_error = std::string("perf_event_open failed: ") + std::strerror(errno);
+			return false;
+		}
+		tc.slots[leader] = tc.n_open++;
+		for (std::size_t i = 0; i < n_events; ++i){
+			if (i == leader)
+				continue;
+			tc.fds[i] = open_event(i, tc.fds[leader]);
+			if (tc.fds[i] >= 0)
+				tc.slots[i] = tc.n_open++;
+		}
+		return true;
+#else
+		std::lock_guard<std::mutex> lock(error_mutex);
+		open_error = "Hardware counters are only supported on Linux";
+		return false;
+#endif
+	}
+}
+
+// Start counting in all timed scopes
+bool PerfCounters::enable()
+{
+	if (!open_thread_counters())
+		return false;
+	counting = true;
+	return true;
+}
+
+// Stop counting
+void PerfCounters::disable()
+{
+	counting = false;
+}
+
+// True if counters are read in timed scopes
+bool PerfCounters::is_enabled()
+{
+	return counting.load(std::memory_order_relaxed);
+}
+
+// Why the counters could not be opened
+std::string PerfCounters::get_error()
+{
+	std::lock_guard<std::mutex> lock(error_mutex);
+	return open_error;
+}
+
+// Current counts of the calling thread
+bool PerfCounters::read(CounterValues& counts)
+{
+	counts.values.fill(-1);
+	if (!open_thread_counters())
+		return false;
+#ifdef __linux__
+	const ThreadCounters& tc = thread_counters;
+	// Number of events, time enabled, time running, values
+	std::array<std::uint64_t, 3 + n_events> data = {};
+	const std::size_t expected = (3 + tc.n_open)*sizeof(std::uint64_t);
+	const int leader = tc.fds[static_cast<std::size_t>(PerfEvent::cycles)];
+	if (::read(leader, data.data(), expected) != static_cast<ssize_t>(expected))
+		return false;
+	// Scale if the counters had to share the hardware
+	const std::uint64_t enabled = data[1], running = data[2];
+	const double scale = (running > 0 && running < enabled) ?
+							static_cast<double>(enabled)/running : 1.0;
+	for (std::size_t i = 0; i < n_events; ++i)
+		if (tc.slots[i] >= 0)
+			counts.values[i] = static_cast<std::int64_t>(data[3 + tc.slots[i]]*scale);
+	return true;
+#else
+	return false;
+#endif
+}
+
+// Name of an event, for output
+const char* PerfCounters::event_name(const PerfEvent event)
+{
+	switch (event){
+		case PerfEvent::cycles: return "cycles";
+		case PerfEvent::instructions: return "instructions";
+		case PerfEvent::llc_misses: return "llc_misses";
+		case PerfEvent::branch_misses: return "branch_misses";
+		default: throw std::invalid_argument("Not a hardware event");
+	}
+}
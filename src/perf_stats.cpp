@@ -0,0 +1,138 @@
+#include "../include/perf_stats.h"
+#include <iomanip>
+
+/***************************************************************
+ * class: PerfStats
+ *
+ * Accumulated wall time of simulation phases
+ **************************************************************/
+
+// Add a measured duration and hardware event counts of a phase
+void PerfStats::add(const PerfPhase phase, const std::int64_t ns, const CounterValues& events)
+{
+	const std::size_t ind = index(phase);
+	const std::int64_t step = counts[index(PerfPhase::transmission)];
+	total_ns[ind] += ns;
+	++counts[ind];
+	CounterValues& totals = total_events[ind];
+	for (std::size_t i = 0; i < CounterValues::n_events; ++i){
+		if (events.values[i] < 0)
+			continue;
+		totals.values[i] = std::max(totals.values[i], std::int64_t(0)) + events.values[i];
+	}
+	if (keep_history){
+		PhaseSample sample;
+		sample.step = step;
+		sample.phase = phase;
+		sample.ns = ns;
+		sample.counters = events;
+		history.push_back(sample);
+	}
+}
+
+// Set all times and counts to 0, remove the history
+void PerfStats::reset()
+{
+	total_ns.fill(0);
+	counts.fill(0);
+	total_events.fill(CounterValues());
+	history.clear();
+}
+
+// Name of a phase, for output
+std::string PerfStats::phase_name(const PerfPhase phase)
+{
+	switch (phase){
+		case PerfPhase::read_input: return "read input";
+		case PerfPhase::register_agents: return "register agents";
+		case PerfPhase::transmission: return "transmit infection";
+		case PerfPhase::agent_contributions: return "  agent contributions";
+		case PerfPhase::place_contributions: return "  place contributions";
+		case PerfPhase::state_transitions: return "  state transitions";
+		case PerfPhase::reset_sums: return "  reset sums";
+		case PerfPhase::output: return "output";
+		default: throw std::invalid_argument("Not a phase");
+	}
+}
+
+// Short name of a phase, for traces
+const char* PerfStats::phase_label(const PerfPhase phase)
+{
+	switch (phase){
+		case PerfPhase::read_input: return "read_input";
+		case PerfPhase::register_agents: return "register_agents";
+		case PerfPhase::transmission: return "transmit_infection";
+		case PerfPhase::agent_contributions: return "agent_contributions";
+		case PerfPhase::place_contributions: return "place_contributions";
+		case PerfPhase::state_transitions: return "state_transitions";
+		case PerfPhase::reset_sums: return "reset_sums";
+		case PerfPhase::output: return "output";
+		default: throw std::invalid_argument("Not a phase");
+	}
+}
+
+// Table of total and mean time of each phase
+void PerfStats::print(std::ostream& out) const
+{
+	if (!enabled){
+		out << "Phase timing not available, compile with -DABM_WITH_PERF_STATS\n";
+		return;
+	}
+	const bool with_events = std::any_of(total_events.begin(), total_events.end(),
+			[](const CounterValues& events){ return events[PerfEvent::cycles] >= 0; });
+	const std::ios_base::fmtflags flags = out.flags();
+	const std::streamsize precision = out.precision();
+	out << std::left << std::setw(24) << "phase" << std::right << std::setw(14) << "total [ms]"
+		<< std::setw(10) << "calls" << std::setw(14) << "mean [ms]";
+	if (with_events)
+		out << std::setw(16) << "cycles" << std::setw(8) << "IPC"
+			<< std::setw(14) << "LLC misses" << std::setw(14) << "br. misses";
+	out << "\n";
+	out << std::fixed << std::setprecision(3);
+	for (std::size_t i = 0; i < n_phases; ++i){
+		if (counts[i] == 0)
+			continue;
+		const PerfPhase phase = static_cast<PerfPhase>(i);
+		out << std::left << std::setw(24) << phase_name(phase) << std::right
+			<< std::setw(14) << get_total_ms(phase) << std::setw(10) << counts[i]
+			<< std::setw(14) << get_total_ms(phase)/counts[i];
+		if (with_events){
+			const CounterValues& events = total_events[i];
+			const std::int64_t cycles = events[PerfEvent::cycles];
+			const std::int64_t instructions = events[PerfEvent::instructions];
+			out << std::setw(16) << cycles << std::setw(8) << std::setprecision(2);
+			if (cycles > 0 && instructions >= 0)
+				out << static_cast<double>(instructions)/cycles;
+			else
+				out << "-";
+			out << std::setprecision(3) << std::setw(14) << events[PerfEvent::llc_misses]
+				<< std::setw(14) << events[PerfEvent::branch_misses];
+		}
+		out << "\n";
+	}
+	if (!with_events && PerfCounters::is_enabled())
+		out << "No hardware event counts were collected\n";
+	out.flags(flags);
+	out.precision(precision);
+}
+
+// One line per measurement
+void PerfStats::print_history(std::ostream& out) const
+{
+	out << "step phase ns";
+	for (std::size_t i = 0; i < CounterValues::n_events; ++i)
+		out << " " << PerfCounters::event_name(static_cast<PerfEvent>(i));
+	out << "\n";
+	for (const auto& sample : history){
+		out << sample.step << " " << phase_label(sample.phase) << " " << sample.ns;
+		for (const auto count : sample.counters.values)
+			out << " " << count;
+		out << "\n";
+	}
+}
+
+std::ostream& operator<< (std::ostream& out, const PerfStats& stats)
+{
+	stats.print(out);
+	return out;
+}
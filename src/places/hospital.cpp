@@ -0,0 +1,44 @@
+#include "../../include/places/hospital.h"
+#include "../../include/io_operations/block_writer.h"
+
+/*****************************************************
+ * class: Hospital
+ *
+ * Defines and stores attributes of a single hospital
+ *
+ *****************************************************/
+
+//
+// Infection related computations
+//
+
+// Contribution of patients to patients and employees
+void Hospital::compute_infected_contribution()
+{
+	num_tot = agent_IDs->size() + num_staff;
+
+	if (num_tot == 0)
+		lambda_tot = 0.0;
+	else
+		lambda_tot = lambda_sum/(static_cast<double>(num_tot));
+}
+
+//
+// I/O
+//
+
+// Save information about a Hospital object
+void Hospital::print_basic(std::ostream& where) const
+{
+	Place::print_basic(where);
+	where << " " << beta_patient << " " << beta_tested
+		  << " " << beta_hospitalized << " " << beta_ICU;
+}
+
+// Save information about a Hospital object, buffered
+void Hospital::print_basic(BlockWriter& where) const
+{
+	Place::print_basic(where);
+	where << " " << beta_patient << " " << beta_tested
+		  << " " << beta_hospitalized << " " << beta_ICU;
+}
@@ -1,4 +1,5 @@
 #include "../../include/places/household.h"
+#include "../../include/io_operations/block_writer.h"
 
 /***************************************************** 
  * class: Household
@@ -18,10 +19,17 @@ void Household::print_basic(std::ostream& where) const
 	where << " " << alpha;	
 }
 
+// Save information about a Household object, buffered
+void Household::print_basic(BlockWriter& where) const
+{
+	Place::print_basic(where);
+	where << " " << alpha;	
+}
+
 // Calculates and stores fraction of infected agents if any 
 void Household::compute_infected_contribution()
 {
-	num_tot = agent_IDs.size();
+	num_tot = agent_IDs->size();
 	
 	if (num_tot == 0)
 		lambda_tot = 0.0;
@@ -1,4 +1,5 @@
 #include "../../include/places/place.h"
+#include "../../include/io_operations/block_writer.h"
 
 /***************************************************** 
  * class: Place
@@ -15,7 +16,7 @@
 void Place::register_agent(const int agent_ID, const bool is_infected)
 {
 	// Store ID
-	agent_IDs.push_back(agent_ID);
+	unshared_agent_IDs().push_back(agent_ID);
 	// Update total
 	++num_tot;
 	// Update infected if agent is infected
@@ -31,7 +32,7 @@ void Place::register_agent(const int agent_ID, const bool is_infected)
 // from exposed and symptoamtic agents if any 
 void Place::compute_infected_contribution()
 {
-	num_tot = agent_IDs.size();
+	num_tot = agent_IDs->size();
 	
 	if (num_tot == 0)
 		lambda_tot = 0.0;
@@ -51,6 +52,14 @@ void Place::print_basic(std::ostream& where) const
 		  << ck << " " << beta_j;	
 }
 
+// Save information about a Place object, buffered
+void Place::print_basic(BlockWriter& where) const
+{
+	where << ID << " " << x << " " << y << " "
+		  << num_tot << " " << num_infected << " "
+		  << ck << " " << beta_j;	
+}
+
 //
 // Initialization and update
 //
@@ -59,9 +68,18 @@ void Place::print_basic(std::ostream& where) const
 void Place::remove_agent(const int index)
 {
 	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(agent_IDs.begin(), agent_IDs.end(),
+	std::remove_copy(agent_IDs->begin(), agent_IDs->end(),
 					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, agent_IDs);	
+	// Copies of the place that share the old list keep it
+	agent_IDs = std::make_shared<std::vector<int>>(std::move(new_agent_IDs));
+}
+
+// IDs of agents that can be changed, copied first if shared
+std::vector<int>& Place::unshared_agent_IDs()
+{
+	if (agent_IDs.use_count() > 1)
+		agent_IDs = std::make_shared<std::vector<int>>(*agent_IDs);
+	return *agent_IDs;
 }
 
 //
@@ -0,0 +1,83 @@
+#include "../../include/places/place_activation.h"
+
+/*****************************************************
+ * class: PlaceActivation
+ *
+ * Open or closed state of each place of one type
+ *
+ *****************************************************/
+
+// Open or close a place
+void PlaceActivation::set(const int i, const bool open)
+{
+	if (i < 0 || i >= n_places)
+		throw std::out_of_range("Place index out of range in activation set");
+	const std::uint64_t bit = std::uint64_t(1) << (i & 63);
+	if (open)
+		words[i >> 6] |= bit;
+	else
+		words[i >> 6] &= ~bit;
+}
+
+// Open or close all places
+void PlaceActivation::set_all(const bool open)
+{
+	if (n_places < 0)
+		throw std::invalid_argument("Number of places can't be negative");
+	words.assign((n_places + 63)/64, open ? ~std::uint64_t(0) : 0);
+	// Bits past the last place stay 0 for counting
+	if (open && (n_places & 63))
+		words.back() = (std::uint64_t(1) << (n_places & 63)) - 1;
+}
+
+// Open places first in the ranking
+void PlaceActivation::open_first(const std::vector<int>& ranking, const double fraction)
+{
+	if (static_cast<int>(ranking.size()) != n_places)
+		throw std::invalid_argument("Ranking has to include every place once");
+	if (fraction < 0.0 || fraction > 1.0)
+		throw std::invalid_argument("Fraction of open places has to be between 0 and 1");
+	set_all(false);
+	const int n_open = static_cast<int>(std::lround(fraction*n_places));
+	for (int k = 0; k < n_open; ++k)
+		set(ranking[k], true);
+}
+
+// Random order, Fisher-Yates with the raw Mersenne twister output
+std::vector<int> PlaceActivation::random_ranking(const int n, const unsigned int seed)
+{
+	std::vector<int> ranking(std::max(n, 0));
+	for (int i = 0; i < n; ++i)
+		ranking[i] = i;
+	std::mt19937 gen(seed);
+	for (int i = n - 1; i > 0; --i){
+		// Index from 0 to i, same on every platform
+		const int j = static_cast<int>((static_cast<std::uint64_t>(gen())*(i + 1)) >> 32);
+		std::swap(ranking[i], ranking[j]);
+	}
+	return ranking;
+}
+
+// Number of open places
+int PlaceActivation::count_open() const
+{
+	int n_open = 0;
+	for (const auto word : words){
+		std::uint64_t w = word;
+		// Clear the lowest set bit until none is left
+		for (; w; w &= w - 1)
+			++n_open;
+	}
+	return n_open;
+}
+
+// True if every open place is also open in other
+bool PlaceActivation::is_subset_of(const PlaceActivation& other) const
+{
+	if (other.n_places != n_places)
+		return false;
+	for (std::size_t k = 0; k < words.size(); ++k)
+		if (words[k] & ~other.words[k])
+			return false;
+	return true;
+}
@@ -1,4 +1,5 @@
 #include "../../include/places/school.h"
+#include "../../include/io_operations/block_writer.h"
 
 /***************************************************** 
  * class: School
@@ -18,4 +19,11 @@ void School::print_basic(std::ostream& where) const
 	where << " " << beta_emp << " " << psi_emp << " " << psi_j;
 }
 
+// Save information about a School object, buffered
+void School::print_basic(BlockWriter& where) const
+{
+	Place::print_basic(where);
+	where << " " << beta_emp << " " << psi_emp << " " << psi_j;
+}
+
 
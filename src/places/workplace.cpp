@@ -1,4 +1,5 @@
 #include "../../include/places/workplace.h"
+#include "../../include/io_operations/block_writer.h"
 
 /***************************************************** 
  * class: Workplace
@@ -18,4 +19,11 @@ void Workplace::print_basic(std::ostream& where) const
 	where << " " << psi_j;	
 }
 
+// Save information about a Workplace object, buffered
+void Workplace::print_basic(BlockWriter& where) const
+{
+	Place::print_basic(where);
+	where << " " << psi_j;	
+}
+
 
@@ -68,6 +68,48 @@ void RegularStatesManager::set_recovering_symptomatic(Agent& agent)
 	agent.set_recovering(true);	
 }
 
+// Keep at home or return to all places
+void RegularStatesManager::set_home_isolation(Agent& agent, const bool isolated)
+{
+	agent.set_home_isolated(isolated);
+}
+
+// Admit to a hospital
+void RegularStatesManager::set_hospitalized(Agent& agent, const int hospital_ID)
+{
+	agent.set_hospitalized(true);
+	agent.set_hospital_ID(hospital_ID);
+}
+
+// To or out of ICU
+void RegularStatesManager::set_ICU(Agent& agent, const bool in_ICU)
+{
+	agent.set_in_ICU(in_ICU);
+}
+
+// Release from a hospital
+void RegularStatesManager::set_discharged(Agent& agent)
+{
+	agent.set_hospitalized(false);
+	agent.set_in_ICU(false);
+	agent.set_hospital_ID(0);
+}
+
+// Waiting for testing or done
+void RegularStatesManager::set_tested(Agent& agent, const bool tested)
+{
+	agent.set_tested(tested);
+}
+
+// Positive results, patients are already isolated
+void RegularStatesManager::set_tested_positive(Agent& agent)
+{
+	agent.set_tested(false);
+	agent.set_tested_positive(true);
+	if (agent.infected() && !agent.hospitalized())
+		agent.set_home_isolated(true);
+}
+
 // Set all removed related states
 void RegularStatesManager::set_any_to_removed(Agent& agent)
 {
@@ -85,5 +127,6 @@ void RegularStatesManager::set_any_to_removed(Agent& agent)
 	agent.set_exposed(false);
 	agent.set_recovering_exposed(false);	
 	agent.set_symptomatic(false);
+	agent.set_home_isolated(false);
 
 }
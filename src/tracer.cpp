@@ -0,0 +1,220 @@
+#include "../include/tracer.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdio>
+
+/***************************************************************
+ * class: Tracer
+ *
+ * Timeline of simulation phases in Chrome trace format
+ **************************************************************/
+
+namespace {
+	typedef std::chrono::steady_clock::time_point TimePoint;
+
+	// One recorded event
+	struct TraceEvent {
+		const char* name = nullptr;
+		const char* category = nullptr;
+		TimePoint begin;
+		TimePoint end;
+	};
+
+	// Ring buffer of one thread
+	struct ThreadBuffer {
+		int tid = 0;
+		std::vector<TraceEvent> events;
+		// Next slot to write, total number written
+		std::size_t next = 0;
+		std::size_t n_written = 0;
+		bool in_use = false;
+		// Set by the owning thread while it writes an event
+		std::atomic<bool> writing{false};
+	};
+
+	// State shared by all threads, never destroyed so that
+	// threads and exit handlers can use it at any time
+	struct TracerState {
+		std::atomic<bool> active{false};
+		std::mutex mutex;
+		std::vector<ThreadBuffer*> buffers;
+		std::size_t capacity = 1 << 16;
+		TimePoint epoch = std::chrono::steady_clock::now();
+		std::string exit_file;
+		bool exit_handler = false;
+	};
+
+	TracerState& state()
+	{
+		static TracerState* tracer = new TracerState();
+		return *tracer;
+	}
+
+	// Returns the buffer of a thread for reuse when the thread ends
+	struct BufferHolder {
+		ThreadBuffer* buffer = nullptr;
+		~BufferHolder()
+		{
+			if (buffer == nullptr)
+				return;
+			std::lock_guard<std::mutex> lock(state().mutex);
+			buffer->in_use = false;
+		}
+	};
+
+	thread_local BufferHolder holder;
+
+	// Buffer of the calling thread, a free or a new one
+	ThreadBuffer& thread_buffer()
+	{
+		if (holder.buffer != nullptr)
+			return *holder.buffer;
+		TracerState& tracer = state();
+		std::lock_guard<std::mutex> lock(tracer.mutex);
+		for (auto buffer : tracer.buffers){
+			if (!buffer->in_use){
+				holder.buffer = buffer;
+				break;
+			}
+		}
+		if (holder.buffer == nullptr){
+			holder.buffer = new ThreadBuffer();
+			holder.buffer->tid = static_cast<int>(tracer.buffers.size()) + 1;
+			tracer.buffers.push_back(holder.buffer);
+		}
+		holder.buffer->in_use = true;
+		if (holder.buffer->events.size() != tracer.capacity)
+			holder.buffer->events.assign(tracer.capacity, TraceEvent());
+		return *holder.buffer;
+	}
+
+	// Microseconds since the start of tracing
+	double to_us(const TimePoint& time)
+	{
+		return std::chrono::duration<double, std::micro>(time - state().epoch).count();
+	}
+
+	// Stop recording and wait for events being written,
+	// the caller holds the mutex; returns the previous state
+	bool pause_recording(TracerState& tracer)
+	{
+		const bool was_active = tracer.active.exchange(false);
+		for (auto buffer : tracer.buffers){
+			while (buffer->writing.load())
+				std::this_thread::yield();
+		}
+		return was_active;
+	}
+
+	void save_at_exit()
+	{
+		TracerState& tracer = state();
+		if (!tracer.exit_file.empty())
+			Tracer::save(tracer.exit_file);
+	}
+}
+
+// Start recording events
+void Tracer::start(const std::string& fname, const std::size_t events_per_thread)
+{
+	if (events_per_thread == 0)
+		throw std::invalid_argument("Trace buffers need space for at least one event");
+	TracerState& tracer = state();
+	std::lock_guard<std::mutex> lock(tracer.mutex);
+	// Buffers of running threads are replaced too
+	pause_recording(tracer);
+	tracer.capacity = events_per_thread;
+	for (auto buffer : tracer.buffers){
+		buffer->events.assign(tracer.capacity, TraceEvent());
+		buffer->next = 0;
+		buffer->n_written = 0;
+	}
+	tracer.epoch = std::chrono::steady_clock::now();
+	tracer.exit_file = fname;
+	if (!fname.empty() && !tracer.exit_handler){
+		std::atexit(save_at_exit);
+		tracer.exit_handler = true;
+	}
+	tracer.active = true;
+}
+
+// Stop recording
+void Tracer::stop()
+{
+	state().active = false;
+}
+
+// True while events are recorded
+bool Tracer::is_active()
+{
+	return state().active.load(std::memory_order_relaxed);
+}
+
+// Number of stored events
+std::size_t Tracer::get_number_of_events()
+{
+	TracerState& tracer = state();
+	std::lock_guard<std::mutex> lock(tracer.mutex);
+	const bool was_active = pause_recording(tracer);
+	std::size_t n_events = 0;
+	for (const auto buffer : tracer.buffers)
+		n_events += std::min(buffer->n_written, buffer->events.size());
+	tracer.active = was_active;
+	return n_events;
+}
+
+// Record a complete event of the calling thread
+void Tracer::record(const char* name, const char* category, const TimePoint& begin, const TimePoint& end)
+{
+	ThreadBuffer& buffer = thread_buffer();
+	// Start, save, and counting stop recording before they
+	// touch the buffers, and wait for writing to finish
+	buffer.writing.store(true);
+	if (!state().active.load()){
+		buffer.writing.store(false);
+		return;
+	}
+	TraceEvent& event = buffer.events[buffer.next];
+	event.name = name;
+	event.category = category;
+	event.begin = begin;
+	event.end = end;
+	buffer.next = (buffer.next + 1) % buffer.events.size();
+	++buffer.n_written;
+	buffer.writing.store(false);
+}
+
+// Save events as Chrome trace-event JSON
+void Tracer::save(const std::string& fname)
+{
+	TracerState& tracer = state();
+	std::lock_guard<std::mutex> lock(tracer.mutex);
+	std::FILE* out = std::fopen(fname.c_str(), "w");
+	if (out == nullptr)
+		throw std::runtime_error("Can't open trace file " + fname);
+	const bool was_active = pause_recording(tracer);
+
+	std::fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+	bool first = true;
+	for (const auto buffer : tracer.buffers){
+		if (buffer->n_written == 0)
+			continue;
+		std::fprintf(out, "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+					"\"args\": {\"name\": \"thread %d\"}}", first ? "" : ",", buffer->tid, buffer->tid);
+		first = false;
+		// Oldest first
+		const std::size_t capacity = buffer->events.size();
+		const std::size_t n_events = std::min(buffer->n_written, capacity);
+		const std::size_t oldest = (buffer->n_written > capacity) ? buffer->next : 0;
+		for (std::size_t i = 0; i < n_events; ++i){
+			const TraceEvent& event = buffer->events[(oldest + i) % capacity];
+			std::fprintf(out, ",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, "
+						"\"ts\": %.3f, \"dur\": %.3f}", event.name, event.category, buffer->tid,
+						to_us(event.begin), to_us(event.end) - to_us(event.begin));
+		}
+	}
+	std::fprintf(out, "\n]}\n");
+	std::fclose(out);
+	tracer.active = was_active;
+}
@@ -0,0 +1,94 @@
+#include "../../include/transitions/hospital_transitions.h"
+
+/*****************************************************
+ * class: HospitalTransitions
+ *
+ * Treatment of symptomatic agents in hospitals and ICU
+ *
+ ******************************************************/
+
+// Durations of treatment
+void HospitalTransitions::set_parameters(const std::map<std::string, double>& infection_parameters)
+{
+	time_in_hospital = infection_parameters.at("time in hospital");
+	time_in_ICU = infection_parameters.at("time in ICU");
+	time_after_ICU = infection_parameters.at("time in hospital after ICU");
+	time_before_death_ICU = infection_parameters.at("time before death to ICU");
+	is_enabled = true;
+}
+
+// Decide the treatment at the onset of symptoms
+void HospitalTransitions::schedule_treatment(Agent& agent, const double time, Infection& infection)
+{
+	if (!infection.will_be_hospitalized(agent.get_age()))
+		return;
+
+	const int agent_ID = agent.get_ID();
+	const double admission = time + infection.time_to_hospitalization();
+	if (agent.dying()){
+		// Not admitted if dies before
+		const double death = agent.get_time_of_death();
+		if (admission >= death)
+			return;
+		schedule(admission, agent_ID, HospitalEventType::admitted);
+		schedule(std::max(admission, death - time_before_death_ICU), agent_ID,
+					HospitalEventType::to_ICU);
+		schedule(death, agent_ID, HospitalEventType::discharged);
+	} else {
+		double discharge = admission + time_in_hospital;
+		schedule(admission, agent_ID, HospitalEventType::admitted);
+		if (infection.will_need_ICU(agent.get_age())){
+			schedule(admission, agent_ID, HospitalEventType::to_ICU);
+			schedule(admission + time_in_ICU, agent_ID, HospitalEventType::from_ICU);
+			discharge = admission + time_in_ICU + time_after_ICU;
+		}
+		// Removed at the discharge the earliest, at the same time
+		if (agent.get_recovery_time() < discharge){
+			agent.set_recovery_duration(discharge - time);
+			agent.set_recovery_time(time);
+			discharge = agent.get_recovery_time();
+		}
+		schedule(discharge, agent_ID, HospitalEventType::discharged);
+	}
+}
+
+// Apply the events that are due
+void HospitalTransitions::process_events(const double time, std::vector<Agent>& agents,
+					std::vector<Hospital>& hospitals, Infection& infection)
+{
+	while (!events.empty() && events.top().time <= time){
+		const HospitalEvent event = events.top();
+		events.pop();
+		Agent& agent = agents[event.agent_ID-1];
+		switch (event.type){
+			case HospitalEventType::admitted: {
+				const int hospital_ID = infection.get_random_hospital_ID(
+											static_cast<int>(hospitals.size()));
+				hospitals[hospital_ID-1].add_agent(event.agent_ID);
+				states_manager.set_hospitalized(agent, hospital_ID);
+				break;
+			}
+			case HospitalEventType::to_ICU:
+				states_manager.set_ICU(agent, true);
+				break;
+			case HospitalEventType::from_ICU:
+				states_manager.set_ICU(agent, false);
+				break;
+			case HospitalEventType::discharged:
+				hospitals[agent.get_hospital_ID()-1].remove_agent(event.agent_ID);
+				states_manager.set_discharged(agent);
+				break;
+		}
+	}
+}
+
+// Add an event to the queue
+void HospitalTransitions::schedule(const double time, const int agent_ID, const HospitalEventType type)
+{
+	HospitalEvent event;
+	event.time = time;
+	event.order = n_scheduled++;
+	event.agent_ID = agent_ID;
+	event.type = type;
+	events.push(event);
+}
@@ -6,6 +6,9 @@
  * Functionality for computing of transitioning 
  * between different agents states for a most general
  * case of agent 
+ *
+ * Relies on the ABM loaders for valid place IDs
+ * of agents, places are indexed directly 
  * 
  ******************************************************/
 
@@ -25,6 +28,12 @@ int RegularTransitions::susceptible_transitions(Agent& agent, const double time,
 		// Infectiousness, latency, and possibility of never developing 
 		// symptoms 
 		recovery_and_incubation(agent, infection, time, infection_parameters);
+		if (event_log != nullptr){
+			std::pair<PlaceType, int> place = attribute_infection(agent, lambda_tot,
+							households, schools, workplaces);
+			event_log->record(time, agent.get_ID(), TransitionType::infected, 
+							place.first, place.second);
+		}
 	}
 	return got_infected;	
 }
@@ -37,31 +46,31 @@ double RegularTransitions::compute_susceptible_lambda(const Agent& agent, const
 	double lambda_tot = 0.0;
 
 	// Regular susceptible agent
-	const Household& house = households.at(agent.get_household_ID()-1);
+	const Household& house = households[agent.get_household_ID()-1];
 	if (agent.student() && agent.works()){
-		const School& school = schools.at(agent.get_school_ID()-1);
+		const School& school = schools[agent.get_school_ID()-1];
         if (agent.school_employee()){
-            const School& workSch = schools.at(agent.get_work_ID()-1);
+            const School& workSch = schools[agent.get_work_ID()-1];
             lambda_tot = house.get_infected_contribution()+
                          workSch.get_infected_contribution()+
                          school.get_infected_contribution();
         } else {
-            const Workplace& workplace = workplaces.at(agent.get_work_ID()-1);
+            const Workplace& workplace = workplaces[agent.get_work_ID()-1];
             lambda_tot = house.get_infected_contribution()+
                          workplace.get_infected_contribution()+
                          school.get_infected_contribution();
         }
 	} else if (agent.student()){
-		const School& school = schools.at(agent.get_school_ID()-1);
+		const School& school = schools[agent.get_school_ID()-1];
 		lambda_tot = house.get_infected_contribution()+ 
 						school.get_infected_contribution();
 	} else if (agent.works()){
         if (agent.school_employee()){
-            const School& school = schools.at(agent.get_work_ID()-1);
+            const School& school = schools[agent.get_work_ID()-1];
             lambda_tot = house.get_infected_contribution()+
                          school.get_infected_contribution();
         } else {
-            const Workplace& workplace = workplaces.at(agent.get_work_ID()-1);
+            const Workplace& workplace = workplaces[agent.get_work_ID()-1];
             lambda_tot = house.get_infected_contribution()+
                          workplace.get_infected_contribution();
         }
@@ -72,6 +81,48 @@ double RegularTransitions::compute_susceptible_lambda(const Agent& agent, const
 	return lambda_tot;
 }
 
+// Sample place of infection proportionally to its contribution to lambda
+std::pair<PlaceType, int> RegularTransitions::attribute_infection(const Agent& agent, 
+					const double lambda_tot, const std::vector<Household>& households, 
+					const std::vector<School>& schools, const std::vector<Workplace>& workplaces)
+{
+	// Candidate places with their contributions, same as in compute_susceptible_lambda;
+	// at most household, school, and work
+	std::array<std::pair<PlaceType, int>, 3> places;
+	std::array<double, 3> lambdas;
+	int n_places = 0;
+
+	const int house_ID = agent.get_household_ID();
+	places[n_places] = std::make_pair(PlaceType::household, house_ID);
+	lambdas[n_places++] = households[house_ID-1].get_infected_contribution();
+	if (agent.student()){
+		places[n_places] = std::make_pair(PlaceType::school, agent.get_school_ID());
+		lambdas[n_places++] = schools[agent.get_school_ID()-1].get_infected_contribution();
+	}
+	if (agent.works()){
+		if (agent.school_employee()){
+			places[n_places] = std::make_pair(PlaceType::school, agent.get_work_ID());
+			lambdas[n_places++] = schools[agent.get_work_ID()-1].get_infected_contribution();
+		} else {
+			places[n_places] = std::make_pair(PlaceType::workplace, agent.get_work_ID());
+			lambdas[n_places++] = workplaces[agent.get_work_ID()-1].get_infected_contribution();
+		}
+	}
+
+	double threshold = rng.get_random(0.0, lambda_tot);
+	for (int i = 0; i < n_places; ++i){
+		threshold -= lambdas[i];
+		if (threshold < 0.0)
+			return places[i];
+	}
+	// Round-off or lambda of 0 - last place with a contribution
+	for (int i = n_places; i-- > 0; ){
+		if (lambdas[i] > 0.0)
+			return places[i];
+	}
+	return places[0];
+}
+
 // Compute and set agent properties related to recovery without symptoms and incubation
 //void RegularTransitions::recovery_and_incubation_with_never_sy(Agent& agent, Infection& infection, const double time,
 //				const std::map<std::string, double>& infection_parameters)
@@ -144,9 +195,15 @@ int RegularTransitions::exposed_transitions(Agent& agent, Infection& infection,
 		if (agent.recovering_exposed()){
 			states_manager.set_exposed_never_symptomatic_to_removed(agent);
 			agent_recovered = 1;
+			if (event_log != nullptr)
+				event_log->record(time, agent.get_ID(), TransitionType::recovered_exposed);
 		} else {
 			// Transition to symptomatic
 			states_manager.set_exposed_to_symptomatic(agent);
+			if (isolate_symptomatic)
+				states_manager.set_home_isolation(agent, true);
+			if (event_log != nullptr)
+				event_log->record(time, agent.get_ID(), TransitionType::symptomatic);
 			// Removal settings
 			int agent_age = agent.get_age();
 			if (infection.will_die(agent_age)){
@@ -189,7 +246,10 @@ std::vector<int> RegularTransitions::check_agent_removal(Agent& agent, const dou
 		if (agent.get_time_of_death() <= time){
 			removed.at(1) = 1;
 			remove_agent_from_all_places(agent, households, schools, workplaces);
+			add_dead_agent_to_all_places(agent, households, schools, workplaces);
 			states_manager.set_any_to_removed(agent);
+			if (event_log != nullptr)
+				event_log->record(time, agent.get_ID(), TransitionType::died);
 		}
 	}
 	// If recovering
@@ -197,6 +257,8 @@ std::vector<int> RegularTransitions::check_agent_removal(Agent& agent, const dou
 		if (agent.get_recovery_time() <= time){
 			removed.at(0) = 1;
 			states_manager.set_any_to_removed(agent);
+			if (event_log != nullptr)
+				event_log->record(time, agent.get_ID(), TransitionType::recovered);
 		}
 	}
 	return removed;
@@ -212,34 +274,57 @@ void RegularTransitions::remove_agent_from_all_places(const Agent& agent,
 
 	int hs_ID = agent.get_household_ID();
 	if (hs_ID > 0){
-		households.at(hs_ID-1).remove_agent(agent_ID);
+		households[hs_ID-1].remove_agent(agent_ID);
 	} else {
 		throw std::runtime_error("Regular symptomatic agent does not have a valid household ID");
 	}
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
+		schools[agent.get_school_ID()-1].remove_agent(agent_ID);
 	}
 	if (agent.works()){
         if (agent.school_employee()){
-            schools.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+            schools[agent.get_work_ID()-1].remove_agent(agent_ID);
         } else {
-            workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+            workplaces[agent.get_work_ID()-1].remove_agent(agent_ID);
         }
     }
 }
 
+// Record agent's death in all places they belong to
+void RegularTransitions::add_dead_agent_to_all_places(const Agent& agent,
+					std::vector<Household>& households, std::vector<School>& schools,
+					std::vector<Workplace>& workplaces)
+{
+	// Memberships are taken from agent properties, also
+	// if the agent was already removed from some places
+	int agent_ID = agent.get_ID();
+	households[agent.get_household_ID()-1].add_dead_agent(agent_ID);
+	if (agent.student())
+		schools[agent.get_school_ID()-1].add_dead_agent(agent_ID);
+	if (agent.works()){
+		// School employees that are also students of that school
+		// are recorded only once
+		if (agent.school_employee()){
+			if (!(agent.student() && agent.get_school_ID() == agent.get_work_ID()))
+				schools[agent.get_work_ID()-1].add_dead_agent(agent_ID);
+		} else {
+			workplaces[agent.get_work_ID()-1].add_dead_agent(agent_ID);
+		}
+	}
+}
+
 // Add to all from places where they are registered
 void RegularTransitions::add_to_all_workplaces_and_schools(const Agent& agent,
 							std::vector<School>& schools, std::vector<Workplace>& workplaces)
 {
 	int agent_ID = agent.get_ID();
 	if (agent.student())
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		schools[agent.get_school_ID()-1].add_agent(agent_ID);
 	if (agent.works()){
         if (agent.school_employee()){
-            schools.at(agent.get_work_ID()-1).add_agent(agent_ID);
+            schools[agent.get_work_ID()-1].add_agent(agent_ID);
         } else {
-            workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
+            workplaces[agent.get_work_ID()-1].add_agent(agent_ID);
         }
 	}
 }
@@ -250,12 +335,12 @@ void RegularTransitions::remove_from_all_workplaces_and_schools(const Agent& age
 {
 	int agent_ID = agent.get_ID();
 	if (agent.student())
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
+		schools[agent.get_school_ID()-1].remove_agent(agent_ID);
 	if (agent.works()){
         if (agent.school_employee()){
-            schools.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+            schools[agent.get_work_ID()-1].remove_agent(agent_ID);
         } else {
-            workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+            workplaces[agent.get_work_ID()-1].remove_agent(agent_ID);
         }
     }
 }
@@ -270,13 +355,13 @@ void RegularTransitions::add_agent_to_all_places(const Agent& agent,
 	int agent_ID = agent.get_ID();
 		
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		schools[agent.get_school_ID()-1].add_agent(agent_ID);
     }
 	if (agent.works()){
         if (agent.school_employee()){
-            schools.at(agent.get_work_ID()-1).add_agent(agent_ID);
+            schools[agent.get_work_ID()-1].add_agent(agent_ID);
         } else {
-            workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
+            workplaces[agent.get_work_ID()-1].add_agent(agent_ID);
         }
     }
 }
@@ -0,0 +1,118 @@
+#include "../../include/transitions/testing_transitions.h"
+
+/*****************************************************
+ * class: TestingTransitions
+ *
+ * Testing of infected agents and isolation of the
+ * positive ones
+ *
+ ******************************************************/
+
+// Delays of testing
+void TestingTransitions::set_parameters(const std::map<std::string, double>& infection_parameters)
+{
+	time_to_test = infection_parameters.at("time from decision to test");
+	time_to_results = infection_parameters.at("time from test to results");
+	start_time = infection_parameters.at("start testing");
+	is_enabled = true;
+}
+
+// Apply the events that are due, then test in order of priority 
+void TestingTransitions::process_events(const double time, std::vector<Agent>& agents, 
+						Infection& infection)
+{
+	// Tests of a new day
+	const long long day = static_cast<long long>(std::floor(time));
+	if (day != current_day){
+		current_day = day;
+		n_tested_today = 0;
+	}
+	const std::size_t n_available = static_cast<std::size_t>(capacity - n_tested_today);
+
+	while (!events.empty() && events.top().time <= time){
+		const TestingEvent event = events.top();
+		events.pop();
+		Agent& agent = agents[event.agent_ID-1];
+		switch (event.type){
+			case TestingEventType::decided:
+				if (agent.removed())
+					states_manager.set_tested(agent, false);
+				else
+					schedule(event.time + time_to_test, event.agent_ID, 
+								TestingEventType::tested, event.symptomatic);
+				break;
+			case TestingEventType::tested:
+				if (agent.removed()){
+					states_manager.set_tested(agent, false);
+					break;
+				}
+				// Bounded, the lowest priority is not tested
+				waiting.insert(event);
+				if (waiting.size() > n_available + static_cast<std::size_t>(max_waiting)){
+					const auto last = std::prev(waiting.end());
+					states_manager.set_tested(agents[last->agent_ID-1], false);
+					waiting.erase(last);
+					++n_not_tested;
+				}
+				break;
+			case TestingEventType::results:
+				// Results of agents that died since the test don't count
+				if (event.positive && !agent.get_dead()){
+					states_manager.set_tested_positive(agent);
+					++n_positive;
+				} else {
+					states_manager.set_tested(agent, false);
+				}
+				break;
+		}
+	}
+
+	while (!waiting.empty() && n_tested_today < capacity){
+		// Agents removed while waiting don't use up tests
+		Agent& agent = agents[waiting.begin()->agent_ID-1];
+		if (agent.removed())
+			states_manager.set_tested(agent, false);
+		else
+			test(*waiting.begin(), time, agents, infection);
+		waiting.erase(waiting.begin());
+	}
+}
+
+// Decide at this time or later 
+void TestingTransitions::decide(Agent& agent, const double time, Infection& infection, 
+									const bool symptomatic)
+{
+	if (time < start_time || agent.tested() || agent.tested_positive())
+		return;
+	if (!infection.will_get_tested(symptomatic))
+		return;
+	states_manager.set_tested(agent, true);
+	schedule(time, agent.get_ID(), TestingEventType::decided, symptomatic);
+}
+
+// Outcome depends on the state at the time of the test
+void TestingTransitions::test(const TestingEvent& request, const double time, 
+								std::vector<Agent>& agents, Infection& infection)
+{
+	const Agent& agent = agents[request.agent_ID-1];
+	const bool positive = agent.infected() ? !infection.false_negative_test() 
+											: infection.false_positive_test();
+	schedule(time + time_to_results, request.agent_ID, TestingEventType::results,
+				request.symptomatic, positive);
+	++n_tested_today;
+	++n_tested;
+}
+
+// Add an event to the queue
+void TestingTransitions::schedule(const double time, const int agent_ID, const TestingEventType type,
+									const bool symptomatic, const bool positive)
+{
+	TestingEvent event;
+	event.time = time;
+	event.order = n_scheduled++;
+	event.agent_ID = agent_ID;
+	event.type = type;
+	event.symptomatic = symptomatic;
+	event.positive = positive;
+	events.push(event);
+}
@@ -24,6 +24,9 @@ int Transitions::susceptible_transitions(Agent& agent, const double time,
 
     got_infected = static_cast<int>(got_infected_reg);
 
+	if (got_infected_reg && testing_tr.enabled())
+		testing_tr.schedule_exposed(agent, infection);
+
     return got_infected;
 
 }
@@ -38,6 +41,12 @@ int Transitions::exposed_transitions(Agent& agent, Infection& infection, const d
     int agent_recovered = regular_tr.exposed_transitions(agent, infection, time, dt,
                 households, schools, workplaces, infection_parameters);
 
+	// Onset of symptoms in this step
+	if (hospital_tr.enabled() && agent.symptomatic())
+		hospital_tr.schedule_treatment(agent, time, infection);
+	if (testing_tr.enabled() && agent.symptomatic())
+		testing_tr.schedule_symptomatic(agent, time, infection);
+
 	return agent_recovered;
 }
 
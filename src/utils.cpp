@@ -1,4 +1,8 @@
 #include "../include/utils.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
 
 // Convert a string to all lowercase
 std::string str_to_lower(std::string s) 
@@ -7,3 +11,40 @@ std::string str_to_lower(std::string s)
                   [](unsigned char c){ return std::tolower(c); } );
     return s;
 }
+
+// Call task for indices [first, last) on up to n_threads threads
+void parallel_for(const int first, const int last, const unsigned int n_threads,
+					const std::function<void(const int)>& task)
+{
+	// Next index to start, set to last on error
+	std::atomic<int> next(first);
+	std::exception_ptr error;
+	std::mutex error_mutex;
+
+	auto worker = [&](){
+		int i = 0;
+		while ((i = next++) < last){
+			try {
+				task(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!error)
+					error = std::current_exception();
+				next = last;
+			}
+		}
+	};
+
+	const unsigned int n_workers = std::min(std::max(n_threads, 1u),
+						static_cast<unsigned int>(std::max(last - first, 1)));
+	std::vector<std::thread> workers;
+	for (unsigned int t = 1; t < n_workers; ++t)
+		workers.emplace_back(worker);
+	// This thread works too
+	worker();
+	for (auto& thread : workers)
+		thread.join();
+
+	if (error)
+		std::rethrow_exception(error);
+}
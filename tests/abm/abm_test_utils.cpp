@@ -0,0 +1,67 @@
+#include "abm_tests.h"
+
+/***************************************************************
+ * Populations and agent changes for ABM tests
+ **************************************************************/
+
+// Writes agents with random households, schools, and workplaces
+void write_random_agents(const std::string& fname, const int n_agents, const int n_houses,
+							const int n_schools, const int n_works, const unsigned int seed,
+							const bool infected, const bool random_ages)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<int> house_dist(1, n_houses);
+	std::uniform_int_distribution<int> school_dist(1, n_schools);
+	std::uniform_int_distribution<int> work_dist(1, n_works);
+	std::uniform_int_distribution<int> age_dist(5, 90);
+	std::uniform_int_distribution<int> flag_dist(0, 1);
+	std::uniform_int_distribution<int> infected_dist(0, 4);
+
+	std::ofstream out(fname);
+	for (int i=0; i<n_agents; ++i){
+		const int student = flag_dist(gen), works = flag_dist(gen);
+		const int worksSch = works ? flag_dist(gen) : 0;
+		const int school_ID = student ? school_dist(gen) : 0;
+		const int work_ID = works ? (worksSch ? school_dist(gen) : work_dist(gen)) : 0;
+		const int age = random_ages ? age_dist(gen) : 30;
+		const int house_ID = house_dist(gen);
+		out << student << " " << works << " " << age << " 0.0 0.0 "
+			<< house_ID << " " << school_ID << " " << worksSch << " "
+			<< work_ID << " " << (infected && infected_dist(gen) == 0) << "\n";
+	}
+}
+
+// Model with the contacts test places and the agents from fin
+ABM load_random_abm(const std::string& fin, const unsigned int seed,
+						const std::string& pfname, std::map<std::string, std::string> dfiles)
+{
+	const std::string data_dir("test_data/contacts_input_data/");
+	dfiles["mortality"] = data_dir + "age_dist_mortality.txt";
+	ABM abm(0.25, pfname, dfiles);
+	if (seed != 0)
+		abm.set_seed(seed);
+	abm.create_households(data_dir + "NR_households.txt");
+	abm.create_schools(data_dir + "NR_schools.txt");
+	abm.create_workplaces(data_dir + "NR_workplaces.txt");
+	abm.create_agents(fin);
+	std::remove(fin.c_str());
+	return abm;
+}
+
+// Makes agents symptomatic and dying with the time of death in the past
+void kill_agents(ABM& abm, const std::vector<int>& indices)
+{
+	std::vector<Agent>& agents = abm.get_vector_of_agents_non_const();
+	for (const int i : indices){
+		Agent& agent = agents.at(i);
+		agent.set_infected(true);
+		agent.set_exposed(false);
+		agent.set_recovering_exposed(false);
+		agent.set_symptomatic(true);
+		agent.set_recovering(false);
+		agent.set_dying(true);
+		agent.set_time_to_death(0.0);
+		agent.set_death_time(0.0);
+	}
+	abm.compute_state_transitions();
+}
@@ -5,4 +5,48 @@
 #include "../../include/utils.h"
 #include "../common/test_utils.h"
 
+/***************************************************************
+ * Populations and agent changes for ABM tests
+ **************************************************************/
+
+/**
+ * \brief Write agents with randomly assigned places
+ * \details Agents go to school and work with probability 0.5,
+ * 		in the create_agents format; IDs of places don't exceed
+ * 		the numbers in test_data/contacts_input_data
+ * @param fname - output file name
+ * @param n_agents - number of agents
+ * @param n_houses - number of households to choose from
+ * @param n_schools - number of schools to choose from
+ * @param n_works - number of workplaces to choose from
+ * @param seed - seed of the population
+ * @param infected - if true, one in five agents is initially infected
+ * @param random_ages - ages from 5 to 90 if true, otherwise all 30
+ */
+void write_random_agents(const std::string& fname, const int n_agents, const int n_houses,
+							const int n_schools, const int n_works, const unsigned int seed,
+							const bool infected = false, const bool random_ages = true);
+
+/**
+ * \brief Model with the test places and agents from a file
+ * \details Time step 0.25 days, places and mortality from
+ * 		test_data/contacts_input_data; the agents file is
+ * 		removed after loading
+ * @param fin - agents file
+ * @param seed - seed of the model before agents are created, 0 to keep it random
+ * @param pfname - infection parameters file
+ * @param dfiles - age-dependent distributions in addition to mortality
+ */
+ABM load_random_abm(const std::string& fin, const unsigned int seed = 0,
+		const std::string& pfname = "test_data/contacts_input_data/infection_parameters.txt",
+		std::map<std::string, std::string> dfiles = {});
+
+/**
+ * \brief Agents with given indices die in the death transition of the model
+ * \details Calls the state transitions of the model at its current time
+ * @param abm - model
+ * @param indices - indices of agents that are not removed
+ */
+void kill_agents(ABM& abm, const std::vector<int>& indices);
+
 #endif
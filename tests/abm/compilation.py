@@ -10,23 +10,47 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+thr = '-pthread'
+lib = '-lz'
 # Common source files
 src_files = path + 'abm.cpp' 
 src_files += ' ' + path + 'agent.cpp' 
 src_files += ' ' + path + 'infection.cpp'
 src_files += ' ' + path + 'contributions.cpp'
+src_files += ' ' + path + 'intervention_schedule.cpp'
+src_files += ' ' + path + 'interactions.cpp'
+src_files += ' ' + path + 'perf_stats.cpp'
+src_files += ' ' + path + 'tracer.cpp'
+src_files += ' ' + path + 'perf_counters.cpp'
+src_files += ' ' + path + 'ensemble.cpp'
+src_files += ' ' + path + 'parameter_sweep.cpp'
+src_files += ' ' + path + 'fork_runner.cpp'
+src_files += ' ' + path + 'equivalence.cpp'
 src_files += ' ' + path + 'transitions/transitions.cpp'
 src_files += ' ' + path + 'transitions/regular_transitions.cpp'
+src_files += ' ' + path + 'transitions/hospital_transitions.cpp'
+src_files += ' ' + path + 'transitions/testing_transitions.cpp'
 src_files += ' ' + path + 'states_manager/states_manager.cpp'
 src_files += ' ' + path + 'states_manager/regular_states_manager.cpp'
 src_files += ' ' + path + 'utils.cpp'
 src_files += ' ' + path + 'places/place.cpp'
 src_files += ' ' + path + 'places/household.cpp'
 src_files += ' ' + path + 'places/workplace.cpp'
+src_files += ' ' + path + 'places/hospital.cpp'
 src_files += ' ' + path + 'places/school.cpp'
+src_files += ' ' + path + 'places/place_activation.cpp'
 src_files += ' ' + path + 'io_operations/FileHandler.cpp'
+src_files += ' ' + path + 'io_operations/compressed_stream.cpp'
+src_files += ' ' + path + 'io_operations/input_validation.cpp'
+src_files += ' ' + path + 'io_operations/contact_network.cpp'
+src_files += ' ' + path + 'io_operations/block_writer.cpp'
+src_files += ' ' + path + 'io_operations/population_generator.cpp'
+src_files += ' ' + path + 'io_operations/population_tiling.cpp'
 src_files += ' ' + path + 'io_operations/load_parameters.cpp'
+src_files += ' ' + path + 'io_operations/agent_snapshots.cpp'
+src_files += ' ' + path + 'io_operations/event_log.cpp'
 tst_files = '../common/test_utils.cpp'
+tst_files += ' abm_test_utils.cpp'
 # Directory with files for testing
 data_dir = './test_data/'
 
@@ -51,7 +75,7 @@ for file_rm in const_files:
 exe_name = 'con_test'
 # Files needed only for this build
 spec_files = 'construction_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
 subprocess.call([compile_com], shell=True)
 
 # Test 2
@@ -60,7 +84,7 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'trans_inf_test'
 # Files needed only for this build
 spec_files = 'infection_transmission.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
 subprocess.call([compile_com], shell=True)
 
 #Test 3
@@ -69,5 +93,86 @@ subprocess.call([compile_com], shell=True)
 exe_name = "contact_test"
 #Files needed only for this build
 spec_files = "contacts_test.cpp"
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 4
+#Replicates run with Ensemble
+#Name of the executable
+exe_name = "ensemble_test"
+#Files needed only for this build
+spec_files = "ensemble_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 5
+#Parameter changes and sweeps
+#Name of the executable
+exe_name = "sweep_test"
+#Files needed only for this build
+spec_files = "parameter_sweep_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 6
+#Replicates run in child processes
+#Name of the executable
+exe_name = "fork_test"
+#Files needed only for this build
+spec_files = "fork_runner_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 7
+#Synthetic population generator and tiling
+#Name of the executable
+exe_name = "generator_test"
+#Files needed only for this build
+spec_files = "population_generator_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 8
+#Timing and tracing of simulation phases
+#Name of the executable
+exe_name = "perf_stats_test"
+#Files needed only for this build
+spec_files = "perf_stats_test.cpp"
+compile_com = ' '.join([cx, std, opt, '-DABM_WITH_PERF_STATS', thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 9
+#Statistical equivalence of simulation engines
+#Name of the executable
+exe_name = "equivalence_test"
+#Files needed only for this build
+spec_files = "equivalence_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 10
+#Schedules of interventions
+#Name of the executable
+exe_name = "intervention_test"
+#Files needed only for this build
+spec_files = "intervention_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 11
+#Hospitals and hospital treatment
+#Name of the executable
+exe_name = "hospital_test"
+#Files needed only for this build
+spec_files = "hospital_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
+subprocess.call([compile_com], shell=True)
+
+#Test 12
+#Testing of agents
+#Name of the executable
+exe_name = "testing_test"
+#Files needed only for this build
+spec_files = "testing_test.cpp"
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
 subprocess.call([compile_com], shell=True)
\ No newline at end of file
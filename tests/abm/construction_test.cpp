@@ -12,6 +12,7 @@ bool create_schools_test();
 bool wrong_school_type_test();
 bool create_workplaces_test();
 bool create_agents_test();
+bool invalid_input_test();
 bool create_infection_model_test(const std::string = {}, const std::string = {});
 
 // Supporting functions
@@ -43,6 +44,7 @@ int main()
 	test_pass(wrong_school_type_test(), "Wrong school type detection");
 	test_pass(create_workplaces_test(), "Workplace creation");
 	test_pass(create_agents_test(), "Agent creation");
+	test_pass(invalid_input_test(), "Population input validation");
 
 	std::string outfile_1 = "test_data/output_infection_parameters.txt";	
 	std::string outfile_2 = "test_data/output_age_distributions.txt";
@@ -236,6 +238,55 @@ bool create_agents_test()
 	return true;
 }
 
+// Checks if all the errors in the population files are reported
+bool invalid_input_test()
+{
+	double dt = 2.0;
+	std::string pfname("test_data/sample_infection_parameters.txt");
+	std::string dmort_name("test_data/age_dist_mortality.txt");
+	std::map<std::string, std::string> dfiles = 
+		{ {"mortality", dmort_name} };
+
+	// Non-continuous IDs and a malformed coordinate
+	ABM abm_houses(dt, pfname, dfiles);
+	std::string hfile("test_data/invalid_input/houses_invalid.txt");
+	try {
+		abm_houses.create_households(hfile);
+		return false;
+	} catch (const std::invalid_argument& e) {
+		std::string msg(e.what());
+		if (msg.find("2 error(s)") != 0 || msg.find(hfile + ":2:") == std::string::npos
+				|| msg.find(hfile + ":3:") == std::string::npos)
+			return false;
+	}
+	// Nothing stored
+	if (!abm_houses.get_vector_of_households().empty())
+		return false;
+
+	// Agents with wrong place IDs, flags, age, and number of entries
+	ABM abm(dt, pfname, dfiles);
+	abm.create_households("test_data/houses_test.txt");
+	abm.create_schools("test_data/schools_test.txt");
+	abm.create_workplaces("test_data/workplaces_test.txt");
+	std::string fin("test_data/invalid_input/agents_invalid.txt");
+	try {
+		abm.create_agents(fin);
+		return false;
+	} catch (const std::invalid_argument& e) {
+		std::string msg(e.what());
+		if (msg.find("8 error(s)") != 0)
+			return false;
+		// First line is correct, all the others have errors
+		if (msg.find(fin + ":1:") != std::string::npos)
+			return false;
+		for (int i=2; i<=7; ++i){
+			if (msg.find(fin + ":" + std::to_string(i) + ":") == std::string::npos)
+				return false;
+		}
+	}
+	return abm.get_vector_of_agents().empty();
+}
+
 /// \brief Demonstrates loading of COVID parameters and distributions
 /// \details This doesn't really test, testing is done in specific 
 ///		objects that use the loaded paramters 
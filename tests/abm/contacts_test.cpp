@@ -7,35 +7,213 @@
  *
  ******************************************************/
 
-void test_contacts();
-//May implement for better formalize
-//bool compare_files();
+bool test_contacts();
+bool random_population_test();
+bool contact_network_test();
+
+// Supporting functions
+ABM create_contacts_abm(const std::string);
+std::vector<int> reference_contacts(const std::vector<Agent>&, const int);
+bool check_last_interactions(std::vector<Agent>&);
+bool read_network(const std::string&, const std::uint8_t, std::vector<std::uint64_t>&,
+                    std::vector<std::uint32_t>&, std::vector<float>&);
 
 int main(){
-    // Very nice test!
-    test_contacts();
+    test_pass(test_contacts(), "Agent contacts collection");
+    test_pass(random_population_test(), "Agent contacts in a random population");
+    test_pass(contact_network_test(), "Contact network export");
 }
 
 // Output:
 // "dead_interactions.txt" - File containing the number of interactions between agents for all agents
 // "interactions.txt" - File containing the number of dead interactions between agents for all agents
-// Use "diff" to compare with correct output files
-void test_contacts()
+// Values of every step are compared to a direct count over all pairs of agents
+bool test_contacts()
 {
-    // Time in days, space in km
-    double dt = 0.25;
     // Max number of steps to simulate
     int tmax = 10;
 
-
     // Input files
 //	std::string fin("input_data/NR_agents.txt");
     std::string fin("test_data/contacts_input_data/contacts.txt");
+    ABM abm = create_contacts_abm(fin);
+
+    std::vector<Agent>& agents = abm.get_vector_of_agents_non_const();
+
+    for (int ti = 0; ti<=tmax; ++ti){
+
+        //Get the number of interactions for each agent
+        if (ti == 2){
+            kill_agents(abm, {0});
+        }
+        if (ti == 3){
+            kill_agents(abm, {3});
+        }
+        if (ti == 4){
+            kill_agents(abm, {9});
+        }
+
+        abm.collect_all_interactions();
+        abm.collect_dead_interactions();
+        if (!check_last_interactions(agents))
+            return false;
+    }
+
+    // Output interactions
+    abm.output_interactions("interactions.txt");
+
+    //Output dead interactions
+    abm.output_dead_interactions("dead_interactions.txt");
+    return true;
+}
+
+/**
+ * \brief Many agents in few places with all combinations of
+ *		students, workers, and school employees, agents die
+ *		as time progresses
+ */
+bool random_population_test()
+{
+    const std::string fin("test_data/contacts_input_data/random_agents.txt");
+    const int n_agents = 600;
+    write_random_agents(fin, n_agents, 150, 5, 8, 2718, false, false);
+
+    ABM abm = create_contacts_abm(fin);
+    std::remove(fin.c_str());
+    std::vector<Agent>& agents = abm.get_vector_of_agents_non_const();
+    std::mt19937 gen(2718);
+    std::uniform_int_distribution<int> agent_dist(0, n_agents-1);
+
+    for (int ti = 0; ti<5; ++ti){
+        std::vector<int> dying;
+        for (int i=0; i<40; ++i){
+            const int index = agent_dist(gen);
+            if (!agents.at(index).get_dead())
+                dying.push_back(index);
+        }
+        kill_agents(abm, dying);
+
+        abm.collect_all_interactions();
+        abm.collect_dead_interactions();
+        if (!check_last_interactions(agents))
+            return false;
+
+        // Totals over living agents
+        std::pair<long long, long long> totals = abm.count_total_interactions();
+        long long n_alive = 0, n_dead = 0;
+        for (auto& agent : agents){
+            if (agent.get_dead())
+                continue;
+            n_alive += agent.get_all_interactions().back();
+            n_dead += agent.get_dead_interactions().back();
+        }
+        if (totals.first != n_alive || totals.second != n_dead)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Agent-place and agent-agent graphs saved in CSR form
+ * \details Weights are powers of 2 so that the weight of
+ *		an edge identifies the places shared by two agents
+ */
+bool contact_network_test()
+{
+    const std::string fin("test_data/contacts_input_data/contacts.txt");
+    const std::string bip_name("test_data/contacts_input_data/network_bipartite.bin");
+    const std::string prj_name("test_data/contacts_input_data/network_projection.bin");
+    ABM abm = create_contacts_abm(fin);
+    const std::vector<Agent>& agents = abm.get_vector_of_agents();
+    const int n_agents = static_cast<int>(agents.size());
+    const int n_houses = static_cast<int>(abm.get_vector_of_households().size());
+    const int n_schools = static_cast<int>(abm.get_vector_of_schools().size());
+
+    ContactWeights weights;
+    weights.household = 1.0f;
+    weights.school = 2.0f;
+    weights.workplace = 4.0f;
+
+    // Small blocks so that the projection is written in parts
+    ContactNetwork network(n_agents, abm.get_vector_of_households(),
+                            abm.get_vector_of_schools(), abm.get_vector_of_workplaces());
+    network.write_bipartite(bip_name, weights);
+    network.write_projection(prj_name, weights, 7);
+
+    std::vector<std::uint64_t> row_start;
+    std::vector<std::uint32_t> columns;
+    std::vector<float> edge_weights;
+
+    // Places of each agent, numbered as in the file
+    std::vector<std::vector<std::pair<std::uint32_t, float>>> places(n_agents);
+    for (int i=0; i<n_agents; ++i){
+        const Agent& agent = agents.at(i);
+        places.at(i).push_back({agent.get_household_ID() - 1, weights.household});
+        if (agent.student())
+            places.at(i).push_back({n_houses + agent.get_school_ID() - 1, weights.school});
+        if (agent.works()){
+            if (agent.school_employee())
+                places.at(i).push_back({n_houses + agent.get_work_ID() - 1, weights.school});
+            else
+                places.at(i).push_back({n_houses + n_schools + agent.get_work_ID() - 1, weights.workplace});
+        }
+        std::sort(places.at(i).begin(), places.at(i).end());
+        places.at(i).erase(std::unique(places.at(i).begin(), places.at(i).end()), places.at(i).end());
+    }
+
+    if (!read_network(bip_name, 0, row_start, columns, edge_weights))
+        return false;
+    for (int i=0; i<n_agents; ++i){
+        if (row_start.at(i + 1) - row_start.at(i) != places.at(i).size())
+            return false;
+        for (std::size_t k = 0; k < places.at(i).size(); ++k){
+            if (columns.at(row_start.at(i) + k) != places.at(i).at(k).first)
+                return false;
+            if (!float_equality<double>(edge_weights.at(row_start.at(i) + k), places.at(i).at(k).second, 1e-5))
+                return false;
+        }
+    }
+
+    if (!read_network(prj_name, 1, row_start, columns, edge_weights))
+        return false;
+    for (int i=0; i<n_agents; ++i){
+        // Expected neighbors and weights of the shared places
+        std::vector<std::pair<std::uint32_t, float>> expected;
+        for (int j=0; j<n_agents; ++j){
+            if (j == i)
+                continue;
+            float shared = 0.0f;
+            for (const auto& place : places.at(i))
+                if (std::find(places.at(j).begin(), places.at(j).end(), place) != places.at(j).end())
+                    shared += place.second;
+            if (shared > 0.0f)
+                expected.push_back({static_cast<std::uint32_t>(j), shared});
+        }
+        if (row_start.at(i + 1) - row_start.at(i) != expected.size())
+            return false;
+        for (std::size_t k = 0; k < expected.size(); ++k){
+            if (columns.at(row_start.at(i) + k) != expected.at(k).first)
+                return false;
+            if (!float_equality<double>(edge_weights.at(row_start.at(i) + k), expected.at(k).second, 1e-5))
+                return false;
+        }
+    }
+
+    std::remove(bip_name.c_str());
+    std::remove(prj_name.c_str());
+    return true;
+}
+
+/// ABM with places from the contacts test data and agents from fin
+ABM create_contacts_abm(const std::string fin)
+{
+    // Time in days, space in km
+    double dt = 0.25;
+
     std::string hfile("test_data/contacts_input_data/NR_households.txt");
     std::string sfile("test_data/contacts_input_data/NR_schools.txt");
     std::string wfile("test_data/contacts_input_data/NR_workplaces.txt");
 
-
     // File with infection parameters
     std::string pfname("test_data/contacts_input_data/infection_parameters.txt");
     // Files with age-dependent distributions;
@@ -53,31 +231,80 @@ void test_contacts()
 
     // Then the agents
     abm.create_agents(fin);
+    return abm;
+}
 
-    std::vector<Agent>& agents = abm.get_vector_of_agents_non_const();
+/// Living and dead contacts of agent i counted over all other agents
+std::vector<int> reference_contacts(const std::vector<Agent>& agents, const int i)
+{
+    // Places as type and ID, schools of students and employees are the same
+    auto places = [](const Agent& agent){
+        std::vector<std::pair<int, int>> memberships = {{1, agent.get_household_ID()}};
+        if (agent.student())
+            memberships.push_back({2, agent.get_school_ID()});
+        if (agent.works())
+            memberships.push_back({agent.school_employee() ? 2 : 3, agent.get_work_ID()});
+        return memberships;
+    };
 
-    for (int ti = 0; ti<=tmax; ++ti){
+    std::vector<int> stats = {0, 0};
+    const std::vector<std::pair<int, int>> own = places(agents.at(i));
+    for (int j=0; j<static_cast<int>(agents.size()); ++j){
+        if (j == i)
+            continue;
+        const std::vector<std::pair<int, int>> other = places(agents.at(j));
+        bool shared = false;
+        for (const auto& place : own)
+            shared = shared || (std::find(other.begin(), other.end(), place) != other.end());
+        if (shared)
+            ++stats.at(agents.at(j).get_dead() ? 1 : 0);
+    }
+    return stats;
+}
 
-        //Get the number of interactions for each agent
-        if (ti == 2){
-            agents.at(0).set_dead(true);
-        }
-        if (ti == 3){
-            agents.at(3).set_dead(true);
-        }
-        if (ti == 4){
-            agents.at(9).set_dead(true);
+/// Compare the most recently collected interactions to the reference
+bool check_last_interactions(std::vector<Agent>& agents)
+{
+    for (int i=0; i<static_cast<int>(agents.size()); ++i){
+        Agent& agent = agents.at(i);
+        const std::vector<int>& interactions = agent.get_all_interactions();
+        const std::vector<int>& dead_interactions = agent.get_dead_interactions();
+        if (agent.get_dead()){
+            if (interactions.back() != -1 || dead_interactions.back() != -1)
+                return false;
+            continue;
         }
-
-        abm.collect_all_interactions();
-        abm.collect_dead_interactions();
+        std::vector<int> expected = reference_contacts(agents, i);
+        if (interactions.back() != expected.at(0) || dead_interactions.back() != expected.at(1))
+            return false;
     }
-
-    // Output interactions
-    abm.output_interactions("interactions.txt");
-
-    //Output dead interactions
-    abm.output_dead_interactions("dead_interactions.txt");
+    return true;
 }
 
+/// Load a network saved in CSR form, false if the header is wrong
+bool read_network(const std::string& fname, const std::uint8_t graph_type,
+                    std::vector<std::uint64_t>& row_start, std::vector<std::uint32_t>& columns,
+                    std::vector<float>& weights)
+{
+    std::ifstream in(fname, std::ios_base::binary);
+    char magic[8] = {};
+    std::uint8_t type = 0;
+    std::uint32_t n_rows = 0, n_places[3] = {0, 0, 0};
+    std::uint64_t n_edges = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&type), sizeof(type));
+    in.read(reinterpret_cast<char*>(&n_rows), sizeof(n_rows));
+    in.read(reinterpret_cast<char*>(n_places), sizeof(n_places));
+    in.read(reinterpret_cast<char*>(&n_edges), sizeof(n_edges));
+    if (std::string(magic, sizeof(magic)) != "ABMCSR01" || type != graph_type)
+        return false;
 
+    row_start.resize(n_rows + 1);
+    columns.resize(n_edges);
+    weights.resize(n_edges);
+    in.read(reinterpret_cast<char*>(row_start.data()), row_start.size()*sizeof(std::uint64_t));
+    in.read(reinterpret_cast<char*>(columns.data()), columns.size()*sizeof(std::uint32_t));
+    in.read(reinterpret_cast<char*>(weights.data()), weights.size()*sizeof(float));
+    // Nothing should be left
+    return in && in.peek() == std::char_traits<char>::eof() && row_start.back() == n_edges;
+}
@@ -0,0 +1,192 @@
+#include "abm_tests.h"
+#include "../../include/ensemble.h"
+
+/*****************************************************
+ *
+ * Test suite for running replicates with Ensemble
+ *
+ ******************************************************/
+
+bool ensemble_reproducibility_test();
+bool ensemble_independence_test();
+bool ensemble_exception_test();
+bool ensemble_shared_data_test();
+
+// Supporting functions
+ABM create_ensemble_abm();
+std::vector<int> simulate_replicate(ABM&, const int);
+
+int main()
+{
+	test_pass(ensemble_reproducibility_test(), "Ensemble replicates reproducibility");
+	test_pass(ensemble_independence_test(), "Ensemble replicates independence");
+	test_pass(ensemble_exception_test(), "Ensemble error handling");
+	test_pass(ensemble_shared_data_test(), "Ensemble replicates share population data");
+}
+
+/// Same results for the same seed with any number of threads
+bool ensemble_reproducibility_test()
+{
+	const ABM abm = create_ensemble_abm();
+	const int n_rep = 6;
+	const unsigned int seed = 11;
+
+	Ensemble serial(abm, 1);
+	Ensemble parallel(abm, 4);
+	if (serial.get_number_of_threads() != 1 || parallel.get_number_of_threads() != 4)
+		return false;
+
+	std::vector<std::vector<int>> res_serial = serial.run<std::vector<int>>(n_rep, simulate_replicate, seed);
+	std::vector<std::vector<int>> res_parallel = parallel.run<std::vector<int>>(n_rep, simulate_replicate, seed);
+	std::vector<std::vector<int>> res_repeat = parallel.run<std::vector<int>>(n_rep, simulate_replicate, seed);
+	if (res_serial.size() != n_rep)
+		return false;
+	if (res_serial != res_parallel || res_serial != res_repeat)
+		return false;
+
+	// Same replicate run directly
+	ABM copy(abm);
+	copy.set_seed(Ensemble::replicate_seed(seed, 2));
+	if (simulate_replicate(copy, 2) != res_serial.at(2))
+		return false;
+	return true;
+}
+
+/// Replicates differ and don't change the population they start from
+bool ensemble_independence_test()
+{
+	const ABM abm = create_ensemble_abm();
+	Ensemble ensemble(abm, 3);
+	std::vector<std::vector<int>> results = ensemble.run<std::vector<int>>(6, simulate_replicate, 5);
+
+	// Every replicate was infected
+	for (const auto& res : results)
+		if (res.front() == 0)
+			return false;
+
+	// Not all the same
+	bool all_same = true;
+	for (const auto& res : results)
+		all_same = all_same && (res == results.front());
+	if (all_same)
+		return false;
+
+	// Different base seed, different results
+	if (ensemble.run<std::vector<int>>(6, simulate_replicate, 6) == results)
+		return false;
+
+	// Nobody infected in the shared population
+	const ABM& population = ensemble.get_population();
+	if (population.get_num_infected() != 0 || population.get_total_infected() != 0)
+		return false;
+	for (const auto& agent : population.get_vector_of_agents())
+		if (agent.infected() || agent.removed())
+			return false;
+	return true;
+}
+
+/// Exceptions of replicates are passed to the caller
+bool ensemble_exception_test()
+{
+	const ABM abm = create_ensemble_abm();
+	Ensemble ensemble(abm, 4);
+
+	// Replicate number is passed correctly
+	std::function<int(ABM&, const int)> number = [](ABM&, const int i){ return i; };
+	std::vector<int> numbers = ensemble.run(20, number);
+	for (int i=0; i<20; ++i)
+		if (numbers.at(i) != i)
+			return false;
+
+	// Failed replicate
+	std::function<int(ABM&, const int)> failing = [](ABM&, const int i){
+			if (i == 3)
+				throw std::runtime_error("Replicate failed");
+			return i;
+		};
+	bool verbose = false;
+	const std::runtime_error failed("Replicate failed");
+	if (!exception_test(verbose, &failed, &Ensemble::run<int>, ensemble, 10, failing, 0))
+		return false;
+
+	// Wrong input
+	const std::invalid_argument invarg("Wrong number of replicates");
+	if (!exception_test(verbose, &invarg, &Ensemble::run<int>, ensemble, -1, number, 0))
+		return false;
+
+	// No replicates
+	if (!ensemble.run(0, number).empty())
+		return false;
+	return true;
+}
+
+/// Places lists and parameters are shared until a replicate changes them
+bool ensemble_shared_data_test()
+{
+	const ABM abm = create_ensemble_abm();
+	const std::vector<int> dying = {0, 1, 2};
+	const int house_ID = abm.get_vector_of_agents().at(dying.front()).get_household_ID();
+	const std::vector<int> members = abm.get_vector_of_households().at(house_ID-1).get_agent_IDs();
+	const std::map<std::string, double> parameters = abm.get_infection_parameters();
+
+	// Copy shares the lists of the original
+	ABM copy(abm);
+	const std::vector<Household>& houses = abm.get_vector_of_households();
+	const std::vector<Household>& copied_houses = copy.get_vector_of_households();
+	for (std::size_t i=0; i<houses.size(); ++i)
+		if (&houses.at(i).get_agent_IDs() != &copied_houses.at(i).get_agent_IDs())
+			return false;
+
+	// Only the changed list is copied
+	kill_agents(copy, dying);
+	if (&houses.at(house_ID-1).get_agent_IDs() == &copied_houses.at(house_ID-1).get_agent_IDs())
+		return false;
+	if (houses.at(house_ID-1).get_agent_IDs() != members)
+		return false;
+	if (copied_houses.at(house_ID-1).get_agent_IDs().size() >= members.size())
+		return false;
+
+	// Replicates that change members and parameters
+	Ensemble ensemble(abm, 4);
+	std::function<int(ABM&, const int)> changing = [&dying](ABM& replicate, const int i){
+			replicate.set_infection_parameters({{"household transmission rate", 1.0 + i}});
+			kill_agents(replicate, dying);
+			return replicate.get_total_dead();
+		};
+	for (const auto& n_dead : ensemble.run(8, changing))
+		if (n_dead != static_cast<int>(dying.size()))
+			return false;
+
+	// Population of the ensemble is unchanged
+	const ABM& population = ensemble.get_population();
+	if (population.get_vector_of_households().at(house_ID-1).get_agent_IDs() != members)
+		return false;
+	if (population.get_infection_parameters() != parameters)
+		return false;
+	for (const auto& index : dying)
+		if (population.get_vector_of_agents().at(index).removed())
+			return false;
+	return true;
+}
+
+/// Random population without infected agents, places from the contacts test data
+ABM create_ensemble_abm()
+{
+	const std::string fin("test_data/ensemble_agents.txt");
+	write_random_agents(fin, 400, 120, 5, 8, 314);
+	return load_random_abm(fin);
+}
+
+/// Infect few agents and simulate, returns number infected in time
+std::vector<int> simulate_replicate(ABM& abm, const int)
+{
+	const int tmax = 40;
+	abm.infect_random_agents(10);
+	std::vector<int> infected(tmax + 1);
+	for (int ti = 0; ti <= tmax; ++ti){
+		infected.at(ti) = abm.get_num_infected();
+		abm.transmit_infection();
+	}
+	infected.push_back(abm.get_total_infected());
+	return infected;
+}
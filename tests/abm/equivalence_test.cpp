@@ -0,0 +1,167 @@
+#include "abm_tests.h"
+#include "../../include/equivalence.h"
+
+/*****************************************************
+ *
+ * Test suite for statistical comparison of engines
+ *
+ ******************************************************/
+
+bool two_sample_tests_test();
+bool equivalence_same_engine_test();
+bool equivalence_different_engine_test();
+bool equivalence_exception_test();
+
+// Supporting functions
+ABM create_equivalence_abm();
+std::vector<double> normal_sample(const int, const double, const unsigned int);
+
+int main()
+{
+	test_pass(two_sample_tests_test(), "Kolmogorov-Smirnov and Anderson-Darling tests");
+	test_pass(equivalence_same_engine_test(), "Equivalence of an engine with itself");
+	test_pass(equivalence_different_engine_test(), "Detection of a different engine");
+	test_pass(equivalence_exception_test(), "Equivalence test error handling");
+}
+
+/// Known statistics, and p-values of equal and shifted distributions
+bool two_sample_tests_test()
+{
+	const double tol = 1e-5;
+
+	// Values computed by hand
+	TwoSampleResult ks = ks_test({4, 2, 3, 1}, {3, 4, 5, 6});
+	if (!float_equality<double>(ks.statistic, 0.5, tol))
+		return false;
+	if (!float_equality<double>(ks.p_value, 0.534, 1e-2))
+		return false;
+	TwoSampleResult ad = anderson_darling_test({1, 2}, {3, 4});
+	if (!float_equality<double>(ad.statistic, 19.0/11.0, tol))
+		return false;
+
+	// All values the same
+	ks = ks_test({1, 1, 1}, {1, 1});
+	ad = anderson_darling_test({1, 1, 1}, {1, 1});
+	if (ks.statistic != 0.0 || ks.p_value != 1.0 || ad.statistic != 0.0 || ad.p_value != 1.0)
+		return false;
+
+	// Same and shifted normal distributions
+	const std::vector<double> x = normal_sample(200, 0.0, 1);
+	const std::vector<double> y = normal_sample(200, 0.0, 2);
+	const std::vector<double> z = normal_sample(200, 1.0, 3);
+	if (ks_test(x, y).p_value < 0.05 || anderson_darling_test(x, y).p_value < 0.05)
+		return false;
+	if (ks_test(x, z).p_value > 1e-6 || anderson_darling_test(x, z).p_value > 1e-6)
+		return false;
+	// Symmetric in the samples
+	if (!float_equality<double>(ks_test(x, z).statistic, ks_test(z, x).statistic, tol))
+		return false;
+	if (!float_equality<double>(anderson_darling_test(x, z).statistic,
+							anderson_darling_test(z, x).statistic, tol))
+		return false;
+
+	// Wrong input
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong samples");
+	if (!exception_test(verbose, &invarg, ks_test, std::vector<double>{}, std::vector<double>{1.0}))
+		return false;
+	if (!exception_test(verbose, &invarg, anderson_darling_test, std::vector<double>{1.0},
+							std::vector<double>{1.0, 2.0}))
+		return false;
+	return true;
+}
+
+/// Reference engine with independent seeds passes
+bool equivalence_same_engine_test()
+{
+	const ABM abm = create_equivalence_abm();
+	EquivalenceTest test(abm, 10, 30, 60, 0.01);
+	const StepFunction reference = EquivalenceTest::reference_engine();
+
+	const std::vector<EpidemicCurve> curves = test.simulate(reference, 7);
+	if (curves.size() != 60)
+		return false;
+	for (const auto& curve : curves){
+		// Random picks may repeat
+		const int n_initial = curve.infected.front();
+		if (curve.infected.size() != 31 || n_initial < 1 || n_initial > 10)
+			return false;
+		if (curve.final_size < n_initial || curve.peak_infected < n_initial)
+			return false;
+		if (curve.infected.at(curve.peak_step) != curve.peak_infected)
+			return false;
+	}
+
+	const std::vector<EquivalenceResult> results = test.compare(reference, reference);
+	if (results.empty() || !EquivalenceTest::all_passed(results)){
+		EquivalenceTest::print(std::cout, results);
+		return false;
+	}
+	for (const auto& res : results)
+		if (res.threshold != results.front().threshold || res.threshold*results.size() > 0.01 + 1e-12)
+			return false;
+	return true;
+}
+
+/// An engine that runs two steps at a time fails
+bool equivalence_different_engine_test()
+{
+	const ABM abm = create_equivalence_abm();
+	EquivalenceTest test(abm, 10, 30, 60, 0.01);
+	test.set_step_stride(5);
+	const StepFunction twice = [](ABM& model){ model.transmit_infection(); model.transmit_infection(); };
+
+	const std::vector<EquivalenceResult> results = test.compare(EquivalenceTest::reference_engine(), twice);
+	if (EquivalenceTest::all_passed(results))
+		return false;
+
+	// Table lists only failures by default
+	std::ostringstream all, failed;
+	EquivalenceTest::print(all, results, true);
+	EquivalenceTest::print(failed, results);
+	if (failed.str().size() >= all.str().size())
+		return false;
+	return true;
+}
+
+/// Wrong settings
+bool equivalence_exception_test()
+{
+	const ABM abm = create_equivalence_abm();
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong settings");
+	auto create = [&abm](const int n_initial, const int n_steps, const int n_rep, const double alpha){
+			EquivalenceTest test(abm, n_initial, n_steps, n_rep, alpha); };
+	if (!exception_test(verbose, &invarg, create, -1, 10, 10, 0.01))
+		return false;
+	if (!exception_test(verbose, &invarg, create, 1, 0, 10, 0.01))
+		return false;
+	if (!exception_test(verbose, &invarg, create, 1, 10, 1, 0.01))
+		return false;
+	if (!exception_test(verbose, &invarg, create, 1, 10, 10, 1.0))
+		return false;
+
+	EquivalenceTest test(abm, 1, 10, 10);
+	if (!exception_test(verbose, &invarg, &EquivalenceTest::set_step_stride, test, 0))
+		return false;
+	return true;
+}
+
+/// Random population without infected agents, places from the contacts test data
+ABM create_equivalence_abm()
+{
+	const std::string fin("test_data/equivalence_agents.txt");
+	write_random_agents(fin, 400, 120, 5, 8, 271);
+	return load_random_abm(fin);
+}
+
+/// Normally distributed sample
+std::vector<double> normal_sample(const int n, const double mean, const unsigned int seed)
+{
+	std::mt19937 gen(seed);
+	std::normal_distribution<double> dist(mean, 1.0);
+	std::vector<double> sample(n);
+	for (auto& x : sample)
+		x = dist(gen);
+	return sample;
+}
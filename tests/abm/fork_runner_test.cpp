@@ -0,0 +1,128 @@
+#include "abm_tests.h"
+#include "../../include/fork_runner.h"
+#include "../../include/ensemble.h"
+
+/*****************************************************
+ *
+ * Test suite for running replicates in child processes
+ *
+ ******************************************************/
+
+bool fork_runner_results_test();
+bool fork_runner_failures_test();
+
+// Supporting functions
+ABM create_fork_abm();
+std::vector<double> simulate_fork_replicate(ABM&, const int);
+
+int main()
+{
+	test_pass(fork_runner_results_test(), "Replicates in child processes");
+	test_pass(fork_runner_failures_test(), "Failed replicates in child processes");
+}
+
+/// Same results as in threads, population of the parent unchanged
+bool fork_runner_results_test()
+{
+	ABM abm = create_fork_abm();
+	const int n_rep = 5;
+	const unsigned int seed = 21;
+
+	ForkRunner runner(abm, 3);
+	if (runner.get_number_of_processes() != 3)
+		return false;
+	std::vector<std::vector<double>> results = runner.run(n_rep, simulate_fork_replicate, seed);
+
+	Ensemble ensemble(abm, 2);
+	std::function<std::vector<double>(ABM&, const int)> replicate = simulate_fork_replicate;
+	if (ensemble.run(n_rep, replicate, seed) != results)
+		return false;
+
+	// Nothing changed in the parent
+	if (abm.get_total_infected() != 0 || abm.get_num_infected() != 0)
+		return false;
+	for (const auto& agent : abm.get_vector_of_agents())
+		if (agent.infected() || agent.removed())
+			return false;
+
+	// Results larger than the pipe buffer
+	std::function<std::vector<double>(ABM&, const int)> large =
+		[](ABM&, const int rep){ return std::vector<double>(200000, rep + 0.5); };
+	std::vector<std::vector<double>> large_results = runner.run(4, large);
+	for (int i=0; i<4; ++i)
+		if (large_results.at(i) != std::vector<double>(200000, i + 0.5))
+			return false;
+	return true;
+}
+
+/// Exceptions and crashes affect only their replicate
+bool fork_runner_failures_test()
+{
+	ABM abm = create_fork_abm();
+	ForkRunner runner(abm, 2);
+
+	std::function<std::vector<double>(ABM&, const int)> failing =
+		[](ABM&, const int rep){
+			if (rep == 1)
+				throw std::runtime_error("Replicate failed");
+			if (rep == 3)
+				std::abort();
+			return std::vector<double>{static_cast<double>(rep)};
+		};
+
+	std::vector<std::string> errors;
+	std::vector<std::vector<double>> results = runner.run(5, failing, 0, &errors);
+	if (errors.size() != 5 || results.size() != 5)
+		return false;
+	for (const int rep : {0, 2, 4})
+		if (!errors.at(rep).empty() || results.at(rep) != std::vector<double>{static_cast<double>(rep)})
+			return false;
+	if (errors.at(1) != "exception: Replicate failed" || !results.at(1).empty())
+		return false;
+	if (errors.at(3).find("signal") == std::string::npos || !results.at(3).empty())
+		return false;
+
+	// Without the error list
+	bool verbose = false;
+	const std::runtime_error failed("Replicates failed");
+	if (!exception_test(verbose, &failed, &ForkRunner::run, runner, 5, failing, 0, nullptr))
+		return false;
+	const std::invalid_argument invarg("Wrong number of replicates");
+	if (!exception_test(verbose, &invarg, &ForkRunner::run, runner, -1, failing, 0, nullptr))
+		return false;
+
+	// Memory limit
+	ForkRunner limited(abm, 2, std::size_t(1) << 30);
+	std::function<std::vector<double>(ABM&, const int)> greedy =
+		[](ABM&, const int rep){
+			std::vector<double> values(rep == 0 ? 10 : std::size_t(1) << 28, 1.0);
+			return std::vector<double>{values.back()};
+		};
+	results = limited.run(2, greedy, 0, &errors);
+	if (!errors.at(0).empty() || results.at(0) != std::vector<double>{1.0})
+		return false;
+	if (errors.at(1).empty() || !results.at(1).empty())
+		return false;
+	return true;
+}
+
+/// Random population without infected agents, places from the contacts test data
+ABM create_fork_abm()
+{
+	const std::string fin("test_data/fork_agents.txt");
+	write_random_agents(fin, 300, 100, 5, 8, 1414);
+	return load_random_abm(fin);
+}
+
+/// Infect few agents and simulate, returns number infected in time
+std::vector<double> simulate_fork_replicate(ABM& abm, const int)
+{
+	abm.infect_random_agents(10);
+	std::vector<double> infected;
+	for (int ti = 0; ti <= 40; ++ti){
+		infected.push_back(abm.get_num_infected());
+		abm.transmit_infection();
+	}
+	infected.push_back(abm.get_total_infected());
+	return infected;
+}
@@ -0,0 +1,301 @@
+#include "abm_tests.h"
+
+/*****************************************************
+ *
+ * Test suite for hospitals and hospital treatment
+ *
+ ******************************************************/
+
+bool hospital_creation_test();
+bool hospital_flow_test();
+bool hospital_contributions_test();
+bool no_hospitals_test();
+bool hospital_snapshots_test();
+
+// Supporting functions
+ABM create_hospital_abm(const bool with_hospitals, const bool hospital_distributions = true);
+bool check_hospital_states(const ABM& abm);
+
+// Temporary input
+const std::string hospitals_file("test_data/hospitals_staff.txt");
+const std::string hosp_dist_file("test_data/high_hospitalization.txt");
+
+int main()
+{
+	test_pass(hospital_creation_test(), "Creation of hospitals");
+	test_pass(hospital_flow_test(), "Admission, ICU, and discharge of agents");
+	test_pass(hospital_contributions_test(), "Contributions of hospitalized agents");
+	test_pass(no_hospitals_test(), "Model without hospitals");
+	test_pass(hospital_snapshots_test(), "Treatment and testing in agent snapshots");
+}
+
+/// Hospitals from a file, with and without employees
+bool hospital_creation_test()
+{
+	const ABM abm = create_hospital_abm(true);
+	const std::vector<Hospital>& hospitals = abm.get_vector_of_hospitals();
+	if (hospitals.size() != 2)
+		return false;
+	if (hospitals.at(0).get_staff_workplace_ID() != 0 || hospitals.at(1).get_staff_workplace_ID() != 5)
+		return false;
+
+	// Rates from the infection parameters
+	const std::map<std::string, double> parameters = abm.get_infection_parameters();
+	std::stringstream buff;
+	buff << hospitals.at(1);
+	int ID = 0, n_tot = 0, n_inf = 0;
+	double x = 0.0, y = 0.0, ck = 0.0, beta_emp = 0.0, beta_pt = 0.0;
+	double beta_tst = 0.0, beta_hsp = 0.0, beta_icu = 0.0;
+	buff >> ID >> x >> y >> n_tot >> n_inf >> ck >> beta_emp >> beta_pt >> beta_tst >> beta_hsp >> beta_icu;
+	if (ID != 2 || !float_equality<double>(x, 35.6, 1e-5) || !float_equality<double>(y, 11.0, 1e-5))
+		return false;
+	if (!float_equality<double>(beta_emp, parameters.at("healthcare employees transmission rate"), 1e-5)
+			|| !float_equality<double>(beta_hsp, parameters.at("hospitalized transmission rate"), 1e-5)
+			|| !float_equality<double>(beta_icu, parameters.at("hospitalized ICU transmission rate"), 1e-5))
+		return false;
+
+	// Overrides reach the hospitals
+	ABM changed(abm);
+	changed.set_infection_parameters({{"hospitalized transmission rate", 1.5}});
+	std::stringstream changed_buff;
+	changed_buff << changed.get_vector_of_hospitals().at(0);
+	for (int i = 0; i < 10; ++i)
+		changed_buff >> beta_hsp;
+	if (!float_equality<double>(beta_hsp, 1.5, 1e-5))
+		return false;
+
+	// Wrong input
+	bool verbose = true;
+	const std::invalid_argument inv_arg("");
+	ABM without_distributions = create_hospital_abm(false, false);
+	if (!exception_test(verbose, &inv_arg, &ABM::create_hospitals, without_distributions, hospitals_file))
+		return false;
+	const std::string wrong_file("test_data/hospitals_wrong_staff.txt");
+	{
+		std::ofstream out(wrong_file);
+		out << "1 0.0 0.0 1000\n";
+	}
+	ABM wrong = create_hospital_abm(false);
+	const bool wrong_throws = exception_test(verbose, &inv_arg, &ABM::create_hospitals, wrong, wrong_file);
+	std::remove(wrong_file.c_str());
+	if (!wrong_throws || !wrong.get_vector_of_hospitals().empty())
+		return false;
+	// No hospitals to send agents to
+	const std::string empty_file("test_data/hospitals_empty.txt");
+	std::ofstream(empty_file).close();
+	ABM empty = create_hospital_abm(false);
+	const bool empty_throws = exception_test(verbose, &inv_arg, &ABM::create_hospitals, empty, empty_file);
+	std::remove(empty_file.c_str());
+	if (!empty_throws || !empty.get_vector_of_hospitals().empty())
+		return false;
+	return true;
+}
+
+/// Agents go through hospitals and leave them when removed
+bool hospital_flow_test()
+{
+	ABM abm = create_hospital_abm(true);
+	int max_hospitalized = 0, max_ICU = 0;
+	for (int i = 0; i < 600; ++i){
+		abm.transmit_infection();
+		if (!check_hospital_states(abm))
+			return false;
+		max_hospitalized = std::max(max_hospitalized, abm.get_num_hospitalized());
+		max_ICU = std::max(max_ICU, abm.get_num_ICU());
+	}
+	if (max_hospitalized == 0 || max_ICU == 0)
+		return false;
+
+	// Treated agents are removed by now
+	if (abm.get_num_infected() - abm.get_num_removed() == 0 && abm.get_num_hospitalized() != 0)
+		return false;
+	return true;
+}
+
+/// Hospitalized agents contribute only to their hospitals, employees are exposed
+bool hospital_contributions_test()
+{
+	ABM abm = create_hospital_abm(true);
+	while (abm.get_num_hospitalized() < 5){
+		abm.transmit_infection();
+		if (abm.get_num_infected() - abm.get_num_removed() == 0)
+			return false;
+	}
+	ABM without_staff(abm), at_home(abm);
+	int n_hospitalized = 0;
+	for (auto& agent : at_home.get_vector_of_agents_non_const()){
+		if (agent.hospitalized()){
+			agent.set_hospitalized(false);
+			++n_hospitalized;
+		}
+	}
+	abm.compute_place_contributions();
+	at_home.compute_place_contributions();
+
+	// Patients are counted only in hospitals
+	auto count_infected = [](const std::vector<Household>& places){
+		int n_infected = 0;
+		for (const auto& place : places)
+			n_infected += place.get_total_infected();
+		return n_infected; };
+	int n_hospitals = 0;
+	for (const auto& hospital : abm.get_vector_of_hospitals())
+		n_hospitals += hospital.get_total_infected();
+	if (n_hospitals != n_hospitalized)
+		return false;
+	if (count_infected(at_home.get_vector_of_households())
+			!= count_infected(abm.get_vector_of_households()) + n_hospitalized)
+		return false;
+
+	// Contributions of patients
+	const std::map<std::string, double> parameters = abm.get_infection_parameters();
+	const std::vector<Hospital>& hospitals = abm.get_vector_of_hospitals();
+	const std::vector<Workplace>& works = abm.get_vector_of_workplaces();
+	std::vector<double> sums(hospitals.size(), 0.0);
+	for (const auto& agent : abm.get_vector_of_agents()){
+		if (!agent.hospitalized())
+			continue;
+		const double beta = agent.in_ICU() ? parameters.at("hospitalized ICU transmission rate")
+								: parameters.at("hospitalized transmission rate");
+		sums.at(agent.get_hospital_ID()-1) += agent.get_inf_variability_factor()
+								*parameters.at("severity correction")*beta;
+	}
+	for (std::size_t i = 0; i < hospitals.size(); ++i){
+		const int n_staff = i == 1 ? static_cast<int>(works.at(4).get_agent_IDs().size()) : 0;
+		if (hospitals.at(i).get_number_of_staff() != n_staff)
+			return false;
+		const double n_tot = hospitals.at(i).get_agent_IDs().size() + n_staff;
+		if (!float_equality<double>(sums.at(i)/n_tot, hospitals.at(i).get_infected_contribution(), 1e-10))
+			return false;
+	}
+
+	// Employees are exposed to patients of the second hospital
+	if (hospitals.at(1).get_infected_contribution() <= 0.0)
+		return false;
+	without_staff.compute_agent_contributions();
+	without_staff.get_vector_of_workplaces_non_const().at(4).compute_infected_contribution();
+	const double own = without_staff.get_vector_of_workplaces().at(4).get_infected_contribution();
+	if (!float_equality<double>(own + hospitals.at(1).get_infected_contribution(),
+					works.at(4).get_infected_contribution(), 1e-10))
+		return false;
+	return true;
+}
+
+/// Without hospitals nothing changes, also with the distributions loaded
+bool no_hospitals_test()
+{
+	ABM with_distributions = create_hospital_abm(false);
+	ABM without_distributions = create_hospital_abm(false, false);
+	for (int i = 0; i < 200; ++i){
+		with_distributions.transmit_infection();
+		without_distributions.transmit_infection();
+		if (with_distributions.get_num_infected() != without_distributions.get_num_infected()
+				|| with_distributions.get_num_removed() != without_distributions.get_num_removed())
+			return false;
+	}
+	return with_distributions.get_num_hospitalized() == 0;
+}
+
+/// Snapshots carry hospitalization, ICU, isolation, and testing of each agent
+bool hospital_snapshots_test()
+{
+	ABM abm = create_hospital_abm(true);
+	abm.set_symptomatic_home_isolation(true);
+	abm.set_testing(100000, 0);
+	const std::string fname("test_data/hospital_states.bin");
+	const std::vector<Agent>& agents = abm.get_vector_of_agents();
+	const int n_steps = 200;
+
+	// Expected flags of each agent at each step
+	auto flag = [](const bool is_set, const AgentStateFlag val)
+		{ return is_set ? static_cast<std::uint8_t>(val) : std::uint8_t(0); };
+	std::vector<std::vector<std::uint8_t>> expected(n_steps);
+	{
+		AgentSnapshotWriter writer(fname, agents.size());
+		for (int i = 0; i < n_steps; ++i){
+			abm.save_agent_states(writer);
+			for (const auto& agent : agents){
+				expected.at(i).push_back(flag(agent.hospitalized(), AgentStateFlag::hospitalized)
+							| flag(agent.in_ICU(), AgentStateFlag::ICU)
+							| flag(agent.home_isolated(), AgentStateFlag::home_isolated)
+							| flag(agent.tested_positive(), AgentStateFlag::tested_positive));
+			}
+			abm.transmit_infection();
+		}
+	}
+
+	// Flags of every agent match, each flag appears at some point
+	std::vector<std::vector<std::uint8_t>> saved;
+	{
+		AgentSnapshotReader reader(fname);
+		for (int i = 0; i < reader.get_number_of_steps(); ++i)
+			saved.push_back(reader.read_step(i));
+	}
+	std::remove(fname.c_str());
+	if (saved.size() != expected.size())
+		return false;
+	std::uint8_t all_flags = 0;
+	for (int i = 0; i < n_steps; ++i){
+		for (std::size_t j = 0; j < agents.size(); ++j){
+			const std::uint8_t flags = saved.at(i).at(j) & ~agent_state_code_mask;
+			if (flags != expected.at(i).at(j))
+				return false;
+			all_flags |= flags;
+		}
+	}
+	return all_flags == static_cast<std::uint8_t>(~agent_state_code_mask);
+}
+
+/// Model with randomly assigned agents, hospitalization of half of the symptomatic
+ABM create_hospital_abm(const bool with_hospitals, const bool hospital_distributions)
+{
+	const std::string fin("test_data/hospital_agents.txt");
+	write_random_agents(fin, 3000, 1000, 20, 60, 171, true);
+	{
+		std::ofstream hospitals_out(hospitals_file);
+		hospitals_out << "1 7089.0 345.678\n2 35.6 11.0 5\n";
+		std::ofstream dist_out(hosp_dist_file);
+		dist_out << "0-100\t0.5\n";
+	}
+
+	std::map<std::string, std::string> dfiles;
+	if (hospital_distributions){
+		dfiles["hospitalization"] = hosp_dist_file;
+		dfiles["ICU"] = "test_data/contacts_input_data/age_dist_hosp_ICU.txt";
+	}
+	// Same initially infected in all models
+	ABM abm = load_random_abm(fin, 2021,
+			"test_data/contacts_input_data/infection_parameters.txt", dfiles);
+	if (with_hospitals)
+		abm.create_hospitals(hospitals_file);
+	std::remove(hospitals_file.c_str());
+	std::remove(hosp_dist_file.c_str());
+	return abm;
+}
+
+/// True if hospitalized agents are symptomatic and registered in their hospitals
+bool check_hospital_states(const ABM& abm)
+{
+	const std::vector<Hospital>& hospitals = abm.get_vector_of_hospitals();
+	int n_patients = 0;
+	for (const auto& hospital : hospitals)
+		n_patients += hospital.get_agent_IDs().size();
+	if (n_patients != abm.get_num_hospitalized())
+		return false;
+
+	for (const auto& agent : abm.get_vector_of_agents()){
+		if (agent.in_ICU() && !agent.hospitalized())
+			return false;
+		if (!agent.hospitalized()){
+			if (agent.get_hospital_ID() != 0)
+				return false;
+			continue;
+		}
+		if (!agent.symptomatic() || agent.removed())
+			return false;
+		const std::vector<int>& patients = hospitals.at(agent.get_hospital_ID()-1).get_agent_IDs();
+		if (std::find(patients.begin(), patients.end(), agent.get_ID()) == patients.end())
+			return false;
+	}
+	return true;
+}
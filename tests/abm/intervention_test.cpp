@@ -0,0 +1,393 @@
+#include "abm_tests.h"
+
+/*****************************************************
+ *
+ * Test suite for schedules of interventions
+ *
+ ******************************************************/
+
+bool schedule_from_parameters_test();
+bool schedule_compile_test();
+bool intervention_contributions_test();
+bool intervention_phase_test();
+bool intervention_exception_test();
+bool home_isolation_contributions_test();
+bool home_isolation_transitions_test();
+
+// Supporting functions
+ABM create_intervention_abm();
+bool same_contributions(const std::vector<School>&, const std::vector<School>&, const double);
+bool same_contributions(const std::vector<Workplace>&, const std::vector<Workplace>&, const double);
+
+int main()
+{
+	test_pass(schedule_from_parameters_test(), "Intervention schedule from infection parameters");
+	test_pass(schedule_compile_test(), "Compiled intervention schedule");
+	test_pass(intervention_contributions_test(), "Place contributions with interventions");
+	test_pass(intervention_phase_test(), "Phases of interventions in time");
+	test_pass(intervention_exception_test(), "Intervention schedule error handling");
+	test_pass(home_isolation_contributions_test(), "Contributions of agents isolated at home");
+	test_pass(home_isolation_transitions_test(), "Home isolation of symptomatic agents");
+}
+
+/// New Rochelle timeline from the input file
+bool schedule_from_parameters_test()
+{
+	const ABM abm = create_intervention_abm();
+	const InterventionSchedule schedule = 
+			InterventionSchedule::from_parameters(abm.get_infection_parameters());
+	const std::vector<InterventionPhase>& phases = schedule.get_phases();
+	if (phases.size() != 5)
+		return false;
+
+	const std::vector<std::string> names = {"school closure", "lockdown", 
+			"reopening phase 1", "reopening phase 2", "reopening phase 3"};
+	const std::vector<double> times = {20.0, 29.0, 94.0, 108.0, 122.0};
+	const std::vector<double> work = {1.0, 0.3, 0.45, 0.511, 0.567};
+	for (std::size_t i = 0; i < phases.size(); ++i){
+		if (phases.at(i).name != names.at(i) || phases.at(i).time != times.at(i))
+			return false;
+		// Schools stay closed, rates of open places don't change
+		if (phases.at(i).school_open != 0.0 || phases.at(i).workplace_open != work.at(i))
+			return false;
+		if (phases.at(i).school_factor != 1.0 || phases.at(i).workplace_factor != 1.0)
+			return false;
+	}
+
+	// Lockdown before schools close
+	std::map<std::string, double> parameters = abm.get_infection_parameters();
+	parameters.at("lockdown") = 10.0;
+	const std::vector<InterventionPhase> early = 
+			InterventionSchedule::from_parameters(parameters).get_phases();
+	if (early.at(0).name != "lockdown" || early.at(0).school_open != 1.0 
+			|| early.at(0).workplace_open != 0.3)
+		return false;
+	if (early.at(1).name != "school closure" || early.at(1).school_open != 0.0 
+			|| early.at(1).workplace_open != 0.3)
+		return false;
+
+	// Nested sets of open workplaces
+	InterventionSchedule schedule_NR = InterventionSchedule::from_parameters(abm.get_infection_parameters());
+	const int n_works = static_cast<int>(abm.get_vector_of_workplaces().size());
+	schedule_NR.compile(0.25, static_cast<int>(abm.get_vector_of_schools().size()), n_works);
+	for (int i = 0; i < schedule_NR.get_number_of_phases(); ++i){
+		if (schedule_NR.get_open_schools(i).count_open() != 0)
+			return false;
+		if (schedule_NR.get_open_workplaces(i).count_open() != static_cast<int>(std::lround(work.at(i)*n_works)))
+			return false;
+		// Lockdown closes some of the open ones, reopening opens more
+		if (i == 1 && !schedule_NR.get_open_workplaces(i).is_subset_of(schedule_NR.get_open_workplaces(i-1)))
+			return false;
+		if (i > 1 && !schedule_NR.get_open_workplaces(i-1).is_subset_of(schedule_NR.get_open_workplaces(i)))
+			return false;
+	}
+	return true;
+}
+
+/// Start steps and factors of each place
+bool schedule_compile_test()
+{
+	InterventionSchedule schedule;
+	// Added out of order
+	schedule.add_phase("second", 2.1, 0.5, 0.25);
+	schedule.add_phase("first", 1.0, 0.0, 1.0);
+	schedule.add_phase("also second", 2.1, 1.0, 1.0, 0.0, 0.5);
+	schedule.compile(0.25, 3, 4);
+
+	if (schedule.get_number_of_phases() != 3)
+		return false;
+	if (schedule.get_phases().at(0).name != "first" || schedule.get_phases().at(1).name != "second"
+			|| schedule.get_phases().at(2).name != "also second")
+		return false;
+	// Starts at a step and between steps
+	if (schedule.get_start_step(0) != 4 || schedule.get_start_step(1) != 9 || schedule.get_start_step(2) != 9)
+		return false;
+	if (schedule.get_school_factors(1) != std::vector<double>(3, 0.5))
+		return false;
+	if (schedule.get_workplace_factors(1) != std::vector<double>(4, 0.25))
+		return false;
+	if (schedule.get_open_schools(1).count_open() != 3 || schedule.get_open_workplaces(1).count_open() != 4)
+		return false;
+	if (schedule.get_open_schools(2).count_open() != 0 || schedule.get_open_workplaces(2).count_open() != 2)
+		return false;
+
+	// Same places for the same seed, different for another
+	InterventionSchedule copy(schedule), other(schedule);
+	copy.compile(0.25, 3, 100);
+	other.set_seed(7);
+	other.compile(0.25, 3, 100);
+	InterventionSchedule again(copy);
+	again.compile(0.25, 3, 100);
+	bool same = true, same_other = true;
+	for (int i = 0; i < 100; ++i){
+		same = same && (copy.get_open_workplaces(2).is_open(i) == again.get_open_workplaces(2).is_open(i));
+		same_other = same_other && (copy.get_open_workplaces(2).is_open(i) == other.get_open_workplaces(2).is_open(i));
+	}
+	if (!same || same_other)
+		return false;
+
+	std::ostringstream out;
+	schedule.print(out);
+	const std::string table = out.str();
+	if (std::count(table.begin(), table.end(), '\n') != 3)
+		return false;
+	return true;
+}
+
+/// Factors multiply school and workplace contributions only
+bool intervention_contributions_test()
+{
+	const double tol = 1e-10;
+	ABM reference = create_intervention_abm();
+	// Until agents are infectious
+	for (int i = 0; i < 30; ++i)
+		reference.transmit_infection();
+	ABM closed(reference), reduced(reference);
+
+	ABM half_open(reference);
+	InterventionSchedule closure, reduction, half;
+	closure.add_phase("closure", 0.0, 0.0, 0.0);
+	reduction.add_phase("reduction", 0.0, 0.5, 0.25);
+	half.add_phase("half open", 0.0, 1.0, 2.0, 0.0, 0.5);
+	closed.set_intervention_schedule(closure);
+	reduced.set_intervention_schedule(reduction);
+	half_open.set_intervention_schedule(half);
+
+	reference.compute_place_contributions();
+	closed.compute_place_contributions();
+	reduced.compute_place_contributions();
+	half_open.compute_place_contributions();
+	if (closed.get_intervention_phase() != 0 || reduced.get_intervention_phase() != 0)
+		return false;
+
+	// Some infected in each place type
+	auto total = [](const std::vector<Workplace>& places){
+		double sum = 0.0;
+		for (const auto& place : places)
+			sum += place.get_infected_contribution();
+		return sum; };
+	if (total(reference.get_vector_of_workplaces()) <= 0.0)
+		return false;
+
+	// Households are not affected
+	const std::vector<Household>& houses = reference.get_vector_of_households();
+	const std::vector<Household>& closed_houses = closed.get_vector_of_households();
+	for (std::size_t i = 0; i < houses.size(); ++i)
+		if (!float_equality<double>(houses.at(i).get_infected_contribution(), 
+						closed_houses.at(i).get_infected_contribution(), tol))
+			return false;
+
+	if (!same_contributions(reference.get_vector_of_schools(), closed.get_vector_of_schools(), 0.0))
+		return false;
+	if (!same_contributions(reference.get_vector_of_workplaces(), closed.get_vector_of_workplaces(), 0.0))
+		return false;
+	if (!same_contributions(reference.get_vector_of_schools(), reduced.get_vector_of_schools(), 0.5))
+		return false;
+	if (!same_contributions(reference.get_vector_of_workplaces(), reduced.get_vector_of_workplaces(), 0.25))
+		return false;
+
+	// Closed places contribute nothing, open ones with their factor
+	if (!same_contributions(reference.get_vector_of_schools(), half_open.get_vector_of_schools(), 0.0))
+		return false;
+	const PlaceActivation& open_works = half_open.get_intervention_schedule().get_open_workplaces(0);
+	const std::vector<Workplace>& works = reference.get_vector_of_workplaces();
+	const std::vector<Workplace>& half_works = half_open.get_vector_of_workplaces();
+	if (open_works.count_open() != static_cast<int>(std::lround(0.5*works.size())))
+		return false;
+	for (std::size_t i = 0; i < works.size(); ++i){
+		const double expected = open_works.is_open(i) ? 2.0*works.at(i).get_infected_contribution() : 0.0;
+		if (!float_equality<double>(expected, half_works.at(i).get_infected_contribution(), tol))
+			return false;
+	}
+
+	// Without a schedule, same as the reference again
+	reduced.clear_intervention_schedule();
+	reduced.reset_place_sums();
+	reduced.compute_place_contributions();
+	if (!same_contributions(reference.get_vector_of_workplaces(), reduced.get_vector_of_workplaces(), 1.0))
+		return false;
+	return true;
+}
+
+/// Phases start at the right step, schedules set later apply right away
+bool intervention_phase_test()
+{
+	ABM abm = create_intervention_abm();
+	InterventionSchedule schedule;
+	schedule.add_phase("first", 0.5, 0.0, 1.0);
+	schedule.add_phase("second", 1.1, 1.0, 0.0);
+	abm.set_intervention_schedule(schedule);
+
+	// dt = 0.25, phases start at steps 2 and 5
+	const std::vector<int> expected = {-1, -1, 0, 0, 0, 1, 1};
+	for (const int phase : expected){
+		abm.transmit_infection();
+		if (abm.get_intervention_phase() != phase)
+			return false;
+	}
+
+	// Set after both started
+	ABM later = create_intervention_abm();
+	for (int i = 0; i < 6; ++i)
+		later.transmit_infection();
+	later.set_intervention_schedule(schedule);
+	if (later.get_intervention_phase() != -1)
+		return false;
+	later.compute_place_contributions();
+	if (later.get_intervention_phase() != 1)
+		return false;
+	return true;
+}
+
+/// Isolated agents contribute only to their households, with the isolated rate
+bool home_isolation_contributions_test()
+{
+	const double tol = 1e-10;
+	ABM reference = create_intervention_abm();
+	// Until agents are infectious
+	for (int i = 0; i < 30; ++i)
+		reference.transmit_infection();
+	ABM isolated(reference);
+	for (auto& agent : isolated.get_vector_of_agents_non_const())
+		if (agent.infected())
+			agent.set_home_isolated(true);
+	if (isolated.get_num_home_isolated() == 0)
+		return false;
+
+	reference.compute_place_contributions();
+	isolated.compute_place_contributions();
+
+	// Only the transmission rate changes in households
+	const std::map<std::string, double> parameters = reference.get_infection_parameters();
+	const double ratio = parameters.at("transmission rate of home isolated")
+							/parameters.at("household transmission rate");
+	const std::vector<Household>& houses = reference.get_vector_of_households();
+	const std::vector<Household>& isolated_houses = isolated.get_vector_of_households();
+	for (std::size_t i = 0; i < houses.size(); ++i)
+		if (!float_equality<double>(ratio*houses.at(i).get_infected_contribution(), 
+						isolated_houses.at(i).get_infected_contribution(), tol))
+			return false;
+	if (!same_contributions(reference.get_vector_of_schools(), isolated.get_vector_of_schools(), 0.0))
+		return false;
+	if (!same_contributions(reference.get_vector_of_workplaces(), isolated.get_vector_of_workplaces(), 0.0))
+		return false;
+
+	// Memberships don't change
+	const std::vector<Workplace>& works = reference.get_vector_of_workplaces();
+	const std::vector<Workplace>& isolated_works = isolated.get_vector_of_workplaces();
+	for (std::size_t i = 0; i < works.size(); ++i)
+		if (works.at(i).get_agent_IDs() != isolated_works.at(i).get_agent_IDs())
+			return false;
+	const std::vector<School>& schools = reference.get_vector_of_schools();
+	const std::vector<School>& isolated_schools = isolated.get_vector_of_schools();
+	for (std::size_t i = 0; i < schools.size(); ++i)
+		if (schools.at(i).get_agent_IDs() != isolated_schools.at(i).get_agent_IDs())
+			return false;
+	return true;
+}
+
+/// Agents isolate when they become symptomatic and stop when removed
+bool home_isolation_transitions_test()
+{
+	ABM not_isolating = create_intervention_abm();
+	ABM isolating(not_isolating);
+	isolating.set_symptomatic_home_isolation(true);
+
+	bool any_isolated = false;
+	for (int i = 0; i < 200; ++i){
+		not_isolating.transmit_infection();
+		isolating.transmit_infection();
+		if (not_isolating.get_num_home_isolated() != 0)
+			return false;
+		for (const auto& agent : isolating.get_vector_of_agents()){
+			if (!agent.home_isolated())
+				continue;
+			any_isolated = true;
+			if (!agent.symptomatic() || agent.removed())
+				return false;
+		}
+	}
+	if (!any_isolated)
+		return false;
+
+	// No new ones after it is turned off, the isolated ones recover or die
+	isolating.set_symptomatic_home_isolation(false);
+	const int n_isolated = isolating.get_num_home_isolated();
+	for (int i = 0; i < 400; ++i)
+		isolating.transmit_infection();
+	if (isolating.get_num_home_isolated() > n_isolated)
+		return false;
+	return true;
+}
+
+/// Wrong input
+bool intervention_exception_test()
+{
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong intervention");
+	InterventionSchedule schedule;
+	if (!exception_test(verbose, &invarg, &InterventionSchedule::add_phase, schedule, "early", -1.0, 1.0, 1.0, 1.0, 1.0))
+		return false;
+	if (!exception_test(verbose, &invarg, &InterventionSchedule::add_phase, schedule, "negative", 1.0, -0.1, 1.0, 1.0, 1.0))
+		return false;
+	if (!exception_test(verbose, &invarg, &InterventionSchedule::add_phase, schedule, "fraction", 1.0, 1.0, 1.0, 1.0, 1.1))
+		return false;
+	if (!exception_test(verbose, &invarg, &InterventionSchedule::compile, schedule, 0.0, 1, 1))
+		return false;
+
+	const ABM abm = create_intervention_abm();
+	std::map<std::string, double> parameters = abm.get_infection_parameters();
+	parameters.erase("reopening phase 2");
+	if (!exception_test(verbose, &invarg, InterventionSchedule::from_parameters, parameters))
+		return false;
+	parameters = abm.get_infection_parameters();
+	parameters.at("fraction of ld businesses") = 1.5;
+	if (!exception_test(verbose, &invarg, InterventionSchedule::from_parameters, parameters))
+		return false;
+
+	// Places created after the schedule
+	const double dt = 0.25;
+	std::string pfname("test_data/contacts_input_data/infection_parameters.txt");
+	std::map<std::string, std::string> dfiles =
+			{ {"mortality", "test_data/contacts_input_data/age_dist_mortality.txt"} };
+	ABM early(dt, pfname, dfiles);
+	schedule.add_phase("closure", 0.0, 0.0, 0.0);
+	early.set_intervention_schedule(schedule);
+	early.create_households("test_data/contacts_input_data/NR_households.txt");
+	early.create_schools("test_data/contacts_input_data/NR_schools.txt");
+	early.create_workplaces("test_data/contacts_input_data/NR_workplaces.txt");
+	const std::runtime_error not_compiled("Schedule set too early");
+	if (!exception_test(verbose, &not_compiled, &ABM::compute_place_contributions, early))
+		return false;
+	return true;
+}
+
+/// Random population with infected agents, places from the contacts test data
+ABM create_intervention_abm()
+{
+	const std::string fin("test_data/intervention_agents.txt");
+	write_random_agents(fin, 3000, 1000, 20, 60, 161, true);
+	return load_random_abm(fin);
+}
+
+/// True if contributions of the places are factor times the reference ones
+bool same_contributions(const std::vector<School>& reference, const std::vector<School>& places, 
+							const double factor)
+{
+	for (std::size_t i = 0; i < places.size(); ++i)
+		if (!float_equality<double>(factor*reference.at(i).get_infected_contribution(), 
+						places.at(i).get_infected_contribution(), 1e-10))
+			return false;
+	return true;
+}
+
+/// True if contributions of the places are factor times the reference ones
+bool same_contributions(const std::vector<Workplace>& reference, const std::vector<Workplace>& places, 
+							const double factor)
+{
+	for (std::size_t i = 0; i < places.size(); ++i)
+		if (!float_equality<double>(factor*reference.at(i).get_infected_contribution(), 
+						places.at(i).get_infected_contribution(), 1e-10))
+			return false;
+	return true;
+}
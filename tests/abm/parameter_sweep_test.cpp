@@ -0,0 +1,247 @@
+#include "abm_tests.h"
+#include "../../include/parameter_sweep.h"
+
+/*****************************************************
+ *
+ * Test suite for parameter changes and sweeps
+ *
+ ******************************************************/
+
+bool parameter_override_test();
+bool parameter_sets_test();
+bool sweep_run_test();
+
+// Supporting functions
+ABM create_sweep_abm(const std::string&);
+void write_changed_parameters(const std::string&, const std::string&, const ParameterSet&);
+std::string print_all_places(const ABM&);
+std::vector<double> simulate_sweep_run(ABM&, const int, const int);
+
+const std::string data_dir("test_data/contacts_input_data/");
+
+int main()
+{
+	test_pass(parameter_override_test(), "Infection parameters changes");
+	test_pass(parameter_sets_test(), "Parameter sets of a sweep");
+	test_pass(sweep_run_test(), "Parameter sweep runs");
+}
+
+/// Changed parameters give the same model as loading them from a file
+bool parameter_override_test()
+{
+	const std::string pfname(data_dir + "infection_parameters.txt");
+	const std::string changed_name(data_dir + "changed_infection_parameters.txt");
+	const ParameterSet changes = {{"household transmission rate", 0.42},
+			{"household scaling parameter", 0.65}, {"severity correction", 1.5},
+			{"college absenteeism correction", 0.3}, {"school employee transmission rate", 0.5},
+			{"work absenteeism correction", 0.2}, {"fraction exposed never symptomatic", 0.25},
+			{"recovery time", 12.0}};
+	write_changed_parameters(pfname, changed_name, changes);
+
+	ABM abm = create_sweep_abm(pfname);
+	ABM expected = create_sweep_abm(changed_name);
+	std::remove(changed_name.c_str());
+
+	if (print_all_places(abm) == print_all_places(expected))
+		return false;
+	abm.set_infection_parameters(changes);
+	if (print_all_places(abm) != print_all_places(expected))
+		return false;
+	if (abm.get_infection_parameters() != expected.get_infection_parameters())
+		return false;
+
+	// Only the places that depend on the parameter
+	ABM house_only = create_sweep_abm(pfname);
+	house_only.set_infection_parameters({{"household transmission rate", 0.42}});
+	std::ostringstream houses, houses_exp, schools, schools_exp;
+	for (const auto& house : house_only.get_vector_of_households())
+		house.print_basic(houses);
+	for (const auto& school : house_only.get_vector_of_schools())
+		school.print_basic(schools);
+	ABM base = create_sweep_abm(pfname);
+	for (const auto& house : base.get_vector_of_households())
+		house.print_basic(houses_exp);
+	for (const auto& school : base.get_vector_of_schools())
+		school.print_basic(schools_exp);
+	if (houses.str() == houses_exp.str() || schools.str() != schools_exp.str())
+		return false;
+
+	// Unknown names, nothing changes
+	bool verbose = false;
+	const std::invalid_argument invarg("Unknown parameter");
+	const ParameterSet wrong = {{"household transmission rate", 0.1}, {"no such parameter", 1.0}};
+	if (!exception_test(verbose, &invarg, &ABM::set_infection_parameters, base, wrong))
+		return false;
+	if (base.get_infection_parameters().at("household transmission rate") != 0.69)
+		return false;
+	return true;
+}
+
+/// Grid, list, and Latin hypercube
+bool parameter_sets_test()
+{
+	// Specification from a file
+	const std::string spec_name(data_dir + "sweep_spec.txt");
+	{
+		std::ofstream out(spec_name);
+		out << "// household transmission rate\n0.5 0.6 0.7\n\n"
+			<< "// fraction exposed never symptomatic\n0.2 0.4\n";
+	}
+	LoadParameters ldparam;
+	std::map<std::string, std::vector<double>> spec = ldparam.load_parameter_lists(spec_name);
+	std::remove(spec_name.c_str());
+	if (spec.size() != 2 || spec.at("household transmission rate") != std::vector<double>({0.5, 0.6, 0.7}))
+		return false;
+
+	std::vector<ParameterSet> grid = ParameterSweep::grid(spec);
+	if (grid.size() != 6)
+		return false;
+	for (const double beta : {0.5, 0.6, 0.7})
+		for (const double frac : {0.2, 0.4})
+			if (std::find(grid.begin(), grid.end(), ParameterSet({{"household transmission rate", beta},
+						{"fraction exposed never symptomatic", frac}})) == grid.end())
+				return false;
+
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong specification");
+	if (!exception_test(verbose, &invarg, &ParameterSweep::list, spec))
+		return false;
+	spec.at("household transmission rate").pop_back();
+	std::vector<ParameterSet> list = ParameterSweep::list(spec);
+	if (list.size() != 2 || list.at(1).at("household transmission rate") != 0.6
+			|| list.at(1).at("fraction exposed never symptomatic") != 0.4)
+		return false;
+
+	// Every interval of every parameter sampled once
+	const int n_sets = 20;
+	std::map<std::string, std::vector<double>> ranges = {{"household transmission rate", {0.5, 1.0}},
+			{"school transmission rate", {1.0, 3.0}}};
+	std::vector<ParameterSet> lhs = ParameterSweep::latin_hypercube(ranges, n_sets, 7);
+	if (lhs.size() != n_sets)
+		return false;
+	for (const auto& range : ranges){
+		std::vector<int> hits(n_sets, 0);
+		for (const auto& set : lhs){
+			const double value = set.at(range.first);
+			if (value < range.second.at(0) || value > range.second.at(1))
+				return false;
+			const double width = (range.second.at(1) - range.second.at(0))/n_sets;
+			++hits.at(std::min(n_sets - 1, static_cast<int>((value - range.second.at(0))/width)));
+		}
+		if (std::count(hits.begin(), hits.end(), 1) != n_sets)
+			return false;
+	}
+	if (ParameterSweep::latin_hypercube(ranges, n_sets, 7) != lhs)
+		return false;
+	ranges.at("school transmission rate").push_back(4.0);
+	if (!exception_test(verbose, &invarg, &ParameterSweep::latin_hypercube, ranges, n_sets, 7))
+		return false;
+	return true;
+}
+
+/// Runs see their parameters, results are reproducible and saved in one file
+bool sweep_run_test()
+{
+	const ABM abm = create_sweep_abm(data_dir + "infection_parameters.txt");
+	const std::vector<ParameterSet> sets = ParameterSweep::grid({{"household transmission rate", {0.0, 2.0}},
+				{"school transmission rate", {0.0, 3.0}}});
+	const int n_rep = 3;
+
+	ParameterSweep serial(abm, 1), parallel(abm, 4);
+	std::vector<std::vector<double>> results = parallel.run(sets, n_rep, simulate_sweep_run, 3);
+	if (results.size() != sets.size()*n_rep)
+		return false;
+	if (serial.run(sets, n_rep, simulate_sweep_run, 3) != results)
+		return false;
+
+	// Each run reports its parameters first
+	for (std::size_t i = 0; i < results.size(); ++i){
+		const ParameterSet& set = sets.at(i/n_rep);
+		if (results.at(i).at(0) != set.at("household transmission rate")
+				|| results.at(i).at(1) != set.at("school transmission rate"))
+			return false;
+		if (results.at(i).at(2) != static_cast<double>(i%n_rep))
+			return false;
+	}
+
+	// Less spread without transmission in households and schools
+	if (results.front().at(3) > results.back().at(3))
+		return false;
+
+	// Wrong names are found before running
+	bool verbose = false;
+	const std::invalid_argument invarg("Unknown parameter");
+	const std::vector<ParameterSet> wrong = {{{"no such parameter", 1.0}}};
+	std::function<std::vector<double>(ABM&, const int, const int)> fail =
+		[](ABM&, const int, const int) -> std::vector<double> {
+			throw std::runtime_error("Should not run");
+		};
+	if (!exception_test(verbose, &invarg, &ParameterSweep::run, parallel, wrong, 1, fail, 0))
+		return false;
+
+	// One line per run after the column names
+	const std::string fname(data_dir + "sweep_results.txt");
+	ParameterSweep::save_results(fname, sets, n_rep, results, {"beta_h", "beta_s", "replicate", "infected"});
+	std::ifstream in(fname);
+	std::string line;
+	std::getline(in, line);
+	if (line != "// set, replicate, household transmission rate, school transmission rate, "
+				"beta_h, beta_s, replicate, infected")
+		return false;
+	int n_lines = 0;
+	while (std::getline(in, line)){
+		std::istringstream row(line);
+		int set = -1, rep = -1;
+		row >> set >> rep;
+		if (set != n_lines/n_rep || rep != n_lines%n_rep)
+			return false;
+		++n_lines;
+	}
+	std::remove(fname.c_str());
+	return n_lines == static_cast<int>(results.size());
+}
+
+/// Random population without infected agents, places from the contacts test data
+ABM create_sweep_abm(const std::string& pfname)
+{
+	const std::string fin(data_dir + "sweep_agents.txt");
+	write_random_agents(fin, 300, 100, 5, 8, 1618);
+	return load_random_abm(fin, 0, pfname);
+}
+
+/// Copy of a parameter file with some values changed
+void write_changed_parameters(const std::string& fin, const std::string& fout, const ParameterSet& changes)
+{
+	LoadParameters ldparam;
+	std::map<std::string, double> parameters = ldparam.load_parameter_map(fin);
+	for (const auto& change : changes)
+		parameters.at(change.first) = change.second;
+	std::ofstream out(fout);
+	out.precision(17);
+	for (const auto& param : parameters)
+		out << "// " << param.first << "\n" << param.second << "\n";
+}
+
+/// Basic information of all places as a string
+std::string print_all_places(const ABM& abm)
+{
+	std::ostringstream out;
+	for (const auto& house : abm.get_vector_of_households())
+		house.print_basic(out);
+	for (const auto& school : abm.get_vector_of_schools())
+		school.print_basic(out);
+	for (const auto& work : abm.get_vector_of_workplaces())
+		work.print_basic(out);
+	return out.str();
+}
+
+/// Parameters seen by the run, replicate, and total infected
+std::vector<double> simulate_sweep_run(ABM& abm, const int, const int rep)
+{
+	const std::map<std::string, double> parameters = abm.get_infection_parameters();
+	abm.infect_random_agents(10);
+	for (int ti = 0; ti < 40; ++ti)
+		abm.transmit_infection();
+	return {parameters.at("household transmission rate"), parameters.at("school transmission rate"),
+				static_cast<double>(rep), static_cast<double>(abm.get_total_infected())};
+}
@@ -0,0 +1,283 @@
+#include "abm_tests.h"
+#include <thread>
+#include <atomic>
+
+/*****************************************************
+ *
+ * Test suite for timing, hardware counters, and tracing
+ * of simulation phases
+ *
+ * Needs to be compiled with -DABM_WITH_PERF_STATS
+ *
+ ******************************************************/
+
+bool perf_stats_test();
+bool scoped_timer_test();
+bool tracer_test();
+bool tracer_restart_test();
+bool phase_history_test();
+bool perf_counters_test();
+
+const std::string data_dir("test_data/contacts_input_data/");
+
+int main()
+{
+	test_pass(scoped_timer_test(), "Scoped timers");
+	test_pass(perf_stats_test(), "Phase times collected by ABM");
+	test_pass(tracer_test(), "Trace of simulation phases");
+	test_pass(tracer_restart_test(), "Tracer restarts while threads record");
+	test_pass(phase_history_test(), "History of phase measurements");
+	test_pass(perf_counters_test(), "Hardware performance counters");
+}
+
+/// Timers add their lifetime to a phase
+bool scoped_timer_test()
+{
+	if (!PerfStats::enabled)
+		return false;
+	PerfStats stats;
+	for (int i=0; i<3; ++i){
+		ABM_PERF_SCOPE(stats, PerfPhase::output);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	if (stats.get_count(PerfPhase::output) != 3 || stats.get_total_ms(PerfPhase::output) < 6.0)
+		return false;
+	if (stats.get_count(PerfPhase::transmission) != 0)
+		return false;
+
+	// Only measured phases are printed
+	std::ostringstream table;
+	table << stats;
+	if (table.str().find("output") == std::string::npos
+			|| table.str().find("transmit infection") != std::string::npos)
+		return false;
+
+	stats.reset();
+	return stats.get_count(PerfPhase::output) == 0 && stats.get_total_ms(PerfPhase::output) == 0.0;
+}
+
+/// Every phase is counted as many times as it runs
+bool perf_stats_test()
+{
+	std::map<std::string, std::string> dfiles = {{"mortality", data_dir + "age_dist_mortality.txt"}};
+	ABM abm(0.25, data_dir + "infection_parameters.txt", dfiles);
+	abm.create_households(data_dir + "NR_households.txt");
+	abm.create_schools(data_dir + "NR_schools.txt");
+	abm.create_workplaces(data_dir + "NR_workplaces.txt");
+
+	const PerfStats& stats = abm.get_perf_stats();
+	if (stats.get_count(PerfPhase::read_input) != 3 || stats.get_count(PerfPhase::register_agents) != 0)
+		return false;
+
+	const int n_steps = 10;
+	for (int ti = 0; ti < n_steps; ++ti)
+		abm.transmit_infection();
+	for (const PerfPhase phase : {PerfPhase::transmission, PerfPhase::agent_contributions,
+				PerfPhase::place_contributions, PerfPhase::state_transitions, PerfPhase::reset_sums})
+		if (stats.get_count(phase) != n_steps)
+			return false;
+	// Parts take less time than the whole step
+	if (stats.get_total_ms(PerfPhase::place_contributions) + stats.get_total_ms(PerfPhase::reset_sums)
+			> stats.get_total_ms(PerfPhase::transmission))
+		return false;
+
+	const std::string fname(data_dir + "perf_households.txt");
+	abm.print_households(fname);
+	std::remove(fname.c_str());
+	if (stats.get_count(PerfPhase::output) != 1)
+		return false;
+
+	abm.reset_perf_stats();
+	return stats.get_count(PerfPhase::transmission) == 0 && stats.get_count(PerfPhase::read_input) == 0;
+}
+
+/// Events of all threads are saved, the newest when buffers are full
+bool tracer_test()
+{
+	const std::string fname(data_dir + "trace.json");
+	if (Tracer::is_active())
+		return false;
+
+	// Nothing recorded when not active
+	{
+		ABM_TRACE_SCOPE("inactive", "test");
+	}
+	Tracer::start("", 4);
+	if (!Tracer::is_active() || Tracer::get_number_of_events() != 0)
+		return false;
+
+	// Two threads, one with more events than its buffer holds
+	{
+		ABM_TRACE_SCOPE("main", "test");
+	}
+	std::thread worker([](){
+			for (int i=0; i<10; ++i){
+				ABM_TRACE_SCOPE(i < 6 ? "old" : "new", "test");
+			}
+		});
+	worker.join();
+	Tracer::stop();
+	{
+		ABM_TRACE_SCOPE("stopped", "test");
+	}
+	if (Tracer::get_number_of_events() != 5)
+		return false;
+
+	Tracer::save(fname);
+	std::ifstream in(fname);
+	std::stringstream content;
+	content << in.rdbuf();
+	std::remove(fname.c_str());
+	const std::string trace = content.str();
+
+	auto count = [&trace](const std::string& what){
+		int n = 0;
+		for (std::size_t pos = trace.find(what); pos != std::string::npos; pos = trace.find(what, pos + 1))
+			++n;
+		return n;
+	};
+	if (trace.find("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [") != 0)
+		return false;
+	if (count("\"ph\": \"X\"") != 5 || count("\"ph\": \"M\"") != 2)
+		return false;
+	if (count("\"name\": \"new\"") != 4 || count("\"name\": \"old\"") != 0
+			|| count("\"name\": \"main\"") != 1 || count("inactive") + count("stopped") != 0)
+		return false;
+
+	// Phases of the model are traced too
+	std::map<std::string, std::string> dfiles = {{"mortality", data_dir + "age_dist_mortality.txt"}};
+	ABM abm(0.25, data_dir + "infection_parameters.txt", dfiles);
+	Tracer::start();
+	abm.create_households(data_dir + "NR_households.txt");
+	abm.transmit_infection();
+	Tracer::stop();
+	// Read, step, and its four parts
+	return Tracer::get_number_of_events() == 6;
+}
+
+/// Starting, counting, and saving don't disturb threads that keep recording
+bool tracer_restart_test()
+{
+	const std::string fname(data_dir + "trace_restart.json");
+	std::atomic<bool> done{false};
+	Tracer::start("", 8);
+	std::thread worker([&done](){
+			while (!done){
+				ABM_TRACE_SCOPE("worker", "test");
+			}
+		});
+
+	bool correct = true;
+	for (int i=0; i<200; ++i){
+		// Buffers of different sizes are replaced under the worker
+		Tracer::start("", 1 + i%16);
+		// Only the worker records
+		if (!Tracer::is_active() || Tracer::get_number_of_events() > static_cast<std::size_t>(1 + i%16))
+			correct = false;
+		if (i%20 == 0)
+			Tracer::save(fname);
+	}
+	// Still recording after the last restart
+	bool recorded = false;
+	for (int i=0; i<1000000 && !recorded; ++i){
+		recorded = Tracer::get_number_of_events() > 0;
+		std::this_thread::yield();
+	}
+	done = true;
+	worker.join();
+	Tracer::stop();
+	std::remove(fname.c_str());
+	return correct && recorded;
+}
+
+/// Each measurement is kept with its step
+bool phase_history_test()
+{
+	std::map<std::string, std::string> dfiles = {{"mortality", data_dir + "age_dist_mortality.txt"}};
+	ABM abm(0.25, data_dir + "infection_parameters.txt", dfiles);
+	abm.create_households(data_dir + "NR_households.txt");
+	if (!abm.get_perf_stats().get_history().empty())
+		return false;
+
+	abm.record_perf_history(true);
+	const int n_steps = 3;
+	for (int ti = 0; ti < n_steps; ++ti)
+		abm.transmit_infection();
+	const std::vector<PhaseSample>& history = abm.get_perf_stats().get_history();
+	// Step and its four parts
+	if (history.size() != 5*n_steps)
+		return false;
+	for (std::size_t i = 0; i < history.size(); ++i){
+		if (history.at(i).step != static_cast<std::int64_t>(i/5) || history.at(i).ns < 0)
+			return false;
+		// Step ends after its parts
+		if ((i%5 == 4) != (history.at(i).phase == PerfPhase::transmission))
+			return false;
+	}
+
+	std::ostringstream out;
+	abm.get_perf_stats().print_history(out);
+	std::istringstream lines(out.str());
+	std::string line;
+	std::getline(lines, line);
+	if (line != "step phase ns cycles instructions llc_misses branch_misses")
+		return false;
+	std::getline(lines, line);
+	std::istringstream first(line);
+	std::string step, phase;
+	first >> step >> phase;
+	if (step != "0" || phase != "agent_contributions")
+		return false;
+
+	abm.reset_perf_stats();
+	return abm.get_perf_stats().get_history().empty();
+}
+
+/// Counts are summed per phase if available, tolerated if not
+bool perf_counters_test()
+{
+	// Summation, events missing in any measurement stay missing
+	PerfStats stats;
+	CounterValues events;
+	events[PerfEvent::cycles] = 1000;
+	events[PerfEvent::instructions] = 2500;
+	stats.add(PerfPhase::state_transitions, 100, events);
+	stats.add(PerfPhase::state_transitions, 100, events);
+	stats.add(PerfPhase::state_transitions, 100);
+	const CounterValues& totals = stats.get_counters(PerfPhase::state_transitions);
+	if (totals[PerfEvent::cycles] != 2000 || totals[PerfEvent::instructions] != 5000
+			|| totals[PerfEvent::llc_misses] != -1 || totals[PerfEvent::branch_misses] != -1)
+		return false;
+	if (stats.get_counters(PerfPhase::output)[PerfEvent::cycles] != -1)
+		return false;
+	std::ostringstream table;
+	table << stats;
+	if (table.str().find("IPC") == std::string::npos || table.str().find("2.50") == std::string::npos)
+		return false;
+	stats.reset();
+	if (stats.get_counters(PerfPhase::state_transitions)[PerfEvent::cycles] != -1)
+		return false;
+
+	// Counters of the system, usually missing in containers
+	const bool available = PerfCounters::enable();
+	if (!available){
+		if (PerfCounters::is_enabled() || PerfCounters::get_error().empty())
+			return false;
+		CounterValues current;
+		if (PerfCounters::read(current) || current[PerfEvent::cycles] != -1)
+			return false;
+	}
+	{
+		ABM_PERF_SCOPE(stats, PerfPhase::output);
+		volatile double sum = 0.0;
+		for (int i = 0; i < 100000; ++i)
+			sum += std::sqrt(static_cast<double>(i));
+	}
+	PerfCounters::disable();
+	const CounterValues& counted = stats.get_counters(PerfPhase::output);
+	if (stats.get_count(PerfPhase::output) != 1)
+		return false;
+	if (available)
+		return counted[PerfEvent::cycles] > 0 && counted[PerfEvent::instructions] > 100000;
+	return counted[PerfEvent::cycles] == -1;
+}
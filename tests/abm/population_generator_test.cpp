@@ -0,0 +1,285 @@
+#include "abm_tests.h"
+#include "../../include/io_operations/population_generator.h"
+#include "../../include/io_operations/population_tiling.h"
+
+/*****************************************************
+ *
+ * Test suite for the synthetic population generator
+ *  and population tiling
+ *
+ ******************************************************/
+
+bool generated_files_test();
+bool generated_population_test();
+bool generator_settings_test();
+bool population_tiling_test();
+
+// Supporting functions
+PopulationSettings test_settings();
+void write_population(const PopulationGenerator&, const std::string&, const std::string&);
+std::string read_whole_file(const std::string&);
+void remove_population(const std::string&, const std::string&);
+ABM load_population(const std::string&, const std::string&);
+
+const std::string data_dir("test_data/contacts_input_data/");
+
+int main()
+{
+	test_pass(generated_files_test(), "Generated files reproducibility");
+	test_pass(generated_population_test(), "Generated population loading");
+	test_pass(generator_settings_test(), "Generator settings checks");
+	test_pass(population_tiling_test(), "Population tiling");
+}
+
+/// Output depends on the seed but not on the number of threads
+bool generated_files_test()
+{
+	const std::vector<std::string> kinds = {"households", "schools", "workplaces", "agents"};
+	const PopulationSettings settings = test_settings();
+
+	write_population(PopulationGenerator(settings, 11, 1), "serial", ".txt");
+	write_population(PopulationGenerator(settings, 11, 4), "parallel", ".txt");
+	write_population(PopulationGenerator(settings, 12, 4), "other_seed", ".txt");
+
+	bool correct = true;
+	for (const auto& kind : kinds){
+		const std::string serial = read_whole_file(data_dir + "serial_" + kind + ".txt");
+		if (serial.empty() || serial != read_whole_file(data_dir + "parallel_" + kind + ".txt"))
+			correct = false;
+		if (serial == read_whole_file(data_dir + "other_seed_" + kind + ".txt"))
+			correct = false;
+	}
+	std::istringstream agents(read_whole_file(data_dir + "serial_agents.txt"));
+	const int n_lines = static_cast<int>(std::count(std::istreambuf_iterator<char>(agents),
+								std::istreambuf_iterator<char>(), '\n'));
+	if (n_lines != settings.n_agents)
+		correct = false;
+
+	remove_population("serial", ".txt");
+	remove_population("parallel", ".txt");
+	remove_population("other_seed", ".txt");
+	return correct;
+}
+
+/// Files are valid model input, students go to schools for their age
+bool generated_population_test()
+{
+	const PopulationSettings settings = test_settings();
+	PopulationGenerator generator(settings, 5, 3);
+	write_population(generator, "gen", ".txt");
+	write_population(generator, "gen", ".txt.gz");
+	ABM abm = load_population("gen", ".txt");
+	ABM compressed = load_population("gen", ".txt.gz");
+	remove_population("gen", ".txt");
+	remove_population("gen", ".txt.gz");
+
+	const std::vector<Agent>& agents = abm.get_vector_of_agents();
+	if (agents.size() != static_cast<std::size_t>(settings.n_agents)
+			|| abm.get_vector_of_households().size() != static_cast<std::size_t>(settings.n_households)
+			|| abm.get_vector_of_schools().size() != static_cast<std::size_t>(settings.n_schools)
+			|| abm.get_vector_of_workplaces().size() != static_cast<std::size_t>(settings.n_workplaces))
+		return false;
+	if (compressed.get_vector_of_agents().size() != agents.size())
+		return false;
+
+	const std::map<std::string, std::vector<int>> ages = {{"daycare", {2, 4}}, {"primary", {5, 10}},
+				{"middle", {11, 13}}, {"high", {14, 17}}, {"college", {18, 22}}};
+	int n_students = 0, n_workers = 0, n_infected = 0;
+	for (std::size_t i = 0; i < agents.size(); ++i){
+		const Agent& agent = agents.at(i);
+		const Agent& other = compressed.get_vector_of_agents().at(i);
+		if (agent.get_age() != other.get_age() || agent.get_household_ID() != other.get_household_ID()
+				|| agent.get_school_ID() != other.get_school_ID() || agent.get_work_ID() != other.get_work_ID())
+			return false;
+		if (agent.get_age() < 0 || agent.get_age() > settings.max_age)
+			return false;
+		if (agent.student()){
+			++n_students;
+			const std::string& type = abm.get_vector_of_schools().at(agent.get_school_ID() - 1).get_type();
+			if (agent.get_age() < ages.at(type).at(0) || agent.get_age() > ages.at(type).at(1))
+				return false;
+		}
+		if (agent.works()){
+			++n_workers;
+			if (agent.get_age() < 18 || agent.get_age() > 65)
+				return false;
+		}
+		if (agent.infected())
+			++n_infected;
+	}
+
+	// Roughly the expected fractions
+	if (n_students < 0.1*settings.n_agents || n_workers < 0.3*settings.n_agents)
+		return false;
+	if (n_infected < 0.5*settings.infected_probability*settings.n_agents
+			|| n_infected > 1.5*settings.infected_probability*settings.n_agents)
+		return false;
+	return true;
+}
+
+/// Inconsistent settings are rejected
+bool generator_settings_test()
+{
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong settings");
+	auto create = [](const PopulationSettings& settings){ PopulationGenerator gen(settings, 0, 1); };
+
+	PopulationSettings no_houses = test_settings();
+	no_houses.n_households = 0;
+	PopulationSettings no_schools = test_settings();
+	no_schools.n_schools = 0;
+	PopulationSettings wrong_prob = test_settings();
+	wrong_prob.employment_probability = 1.2;
+	PopulationSettings negative = test_settings();
+	negative.n_agents = -10;
+	for (const auto& settings : {no_houses, no_schools, wrong_prob, negative})
+		if (!exception_test(verbose, &invarg, create, settings))
+			return false;
+
+	// No students or school employees, no schools needed
+	no_schools.student_probability = 0.0;
+	no_schools.school_employee_probability = 0.0;
+	PopulationGenerator generator(no_schools, 0, 2);
+	if (generator.get_number_of_threads() != 2)
+		return false;
+	return true;
+}
+
+/// Tiles are copies with offset IDs, some workers commute to other tiles
+bool population_tiling_test()
+{
+	PopulationSettings settings = test_settings();
+	settings.n_agents = 5000;
+	settings.n_households = 2000;
+	settings.n_schools = 10;
+	settings.n_workplaces = 200;
+	write_population(PopulationGenerator(settings, 3, 2), "single", ".txt");
+
+	const std::string in = data_dir + "single_";
+	PopulationTiling tiling(in + "households.txt", in + "schools.txt", in + "workplaces.txt", in + "agents.txt");
+	if (tiling.get_number_of_agents() != settings.n_agents
+			|| tiling.get_number_of_workplaces() != settings.n_workplaces)
+		return false;
+
+	const int n_tiles = 3;
+	const double commuters = 0.2;
+	const std::string out = data_dir + "tiled_";
+	tiling.write(out + "households.txt", out + "schools.txt", out + "workplaces.txt",
+					out + "agents.txt", n_tiles, commuters, 4);
+	ABM single = load_population("single", ".txt");
+	ABM tiled = load_population("tiled", ".txt");
+
+	// Reproducible
+	const std::string agents_text = read_whole_file(out + "agents.txt");
+	tiling.write(out + "households.txt", out + "schools.txt", out + "workplaces.txt",
+					out + "agents.txt", n_tiles, commuters, 4);
+	bool correct = (agents_text == read_whole_file(out + "agents.txt"));
+
+	// Invalid input
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong tiling");
+	if (!exception_test(verbose, &invarg, &PopulationTiling::write, tiling, out + "households.txt",
+				out + "schools.txt", out + "workplaces.txt", out + "agents.txt", 0, 0.0, 0))
+		correct = false;
+	std::ofstream(out + "agents.txt") << "0 1 45 0.0 0.0 1 0 x 3 0\n";
+	if (!exception_test(verbose, &invarg, [&](){ PopulationTiling wrong(in + "households.txt",
+				in + "schools.txt", in + "workplaces.txt", out + "agents.txt"); }))
+		correct = false;
+	remove_population("single", ".txt");
+	remove_population("tiled", ".txt");
+	if (!correct)
+		return false;
+
+	const std::vector<Agent>& original = single.get_vector_of_agents();
+	const std::vector<Agent>& agents = tiled.get_vector_of_agents();
+	if (agents.size() != n_tiles*original.size()
+			|| tiled.get_vector_of_households().size() != n_tiles*single.get_vector_of_households().size()
+			|| tiled.get_vector_of_schools().size() != n_tiles*single.get_vector_of_schools().size())
+		return false;
+
+	int n_workers = 0, n_commuters = 0;
+	for (std::size_t i = 0; i < agents.size(); ++i){
+		const int tile = static_cast<int>(i/original.size());
+		const Agent& agent = agents.at(i);
+		const Agent& copy_of = original.at(i%original.size());
+		const std::pair<double, double> shift = tiling.get_tile_shift(tile, n_tiles);
+		if (agent.get_age() != copy_of.get_age() || agent.student() != copy_of.student()
+				|| agent.works() != copy_of.works())
+			return false;
+		if (!float_equality<double>(agent.get_x_location(), copy_of.get_x_location() + shift.first, 1e-7)
+				|| !float_equality<double>(agent.get_y_location(), copy_of.get_y_location() + shift.second, 1e-7))
+			return false;
+		if (agent.get_household_ID() != copy_of.get_household_ID() + tile*settings.n_households)
+			return false;
+		if (agent.student() && agent.get_school_ID() != copy_of.get_school_ID() + tile*settings.n_schools)
+			return false;
+		if (!agent.works() || agent.school_employee()){
+			if (agent.school_employee() && agent.get_work_ID() != copy_of.get_work_ID() + tile*settings.n_schools)
+				return false;
+			continue;
+		}
+		// Same workplace, possibly in another tile
+		++n_workers;
+		const int local = agent.get_work_ID() - copy_of.get_work_ID();
+		if (local % settings.n_workplaces != 0)
+			return false;
+		if (local/settings.n_workplaces != tile)
+			++n_commuters;
+	}
+	if (std::abs(static_cast<double>(n_commuters)/n_workers - commuters) > 0.03)
+		return false;
+
+	// Tiles don't overlap
+	if (tiling.get_tile_shift(1, n_tiles).first <= 0.1 || tiling.get_tile_shift(2, n_tiles).second <= 0.1)
+		return false;
+	return true;
+}
+
+/// Population with a few chunks of agents
+PopulationSettings test_settings()
+{
+	PopulationSettings settings = PopulationSettings::scaled(150000);
+	settings.x_min = 40.9;
+	settings.x_max = 41.0;
+	settings.y_min = -73.8;
+	settings.y_max = -73.7;
+	settings.infected_probability = 0.01;
+	return settings;
+}
+
+/// Write all the files of a population
+void write_population(const PopulationGenerator& generator, const std::string& name, const std::string& ext)
+{
+	generator.write_households(data_dir + name + "_households" + ext);
+	generator.write_schools(data_dir + name + "_schools" + ext);
+	generator.write_workplaces(data_dir + name + "_workplaces" + ext);
+	generator.write_agents(data_dir + name + "_agents" + ext);
+}
+
+/// Content of a file as a string
+std::string read_whole_file(const std::string& fname)
+{
+	std::ifstream in(fname);
+	std::ostringstream content;
+	content << in.rdbuf();
+	return content.str();
+}
+
+/// Remove all the files of a population
+void remove_population(const std::string& name, const std::string& ext)
+{
+	for (const std::string kind : {"households", "schools", "workplaces", "agents"})
+		std::remove((data_dir + name + "_" + kind + ext).c_str());
+}
+
+/// Model with the generated population and the contacts test parameters
+ABM load_population(const std::string& name, const std::string& ext)
+{
+	std::map<std::string, std::string> dfiles = {{"mortality", data_dir + "age_dist_mortality.txt"}};
+	ABM abm(0.25, data_dir + "infection_parameters.txt", dfiles);
+	abm.create_households(data_dir + name + "_households" + ext);
+	abm.create_schools(data_dir + name + "_schools" + ext);
+	abm.create_workplaces(data_dir + name + "_workplaces" + ext);
+	abm.create_agents(data_dir + name + "_agents" + ext);
+	return abm;
+}
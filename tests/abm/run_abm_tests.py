@@ -25,3 +25,39 @@ subprocess.call(['./trans_inf_test'], shell=True)
 # Test suite 3
 ut.msg('ABM interface - contacts collection test', CYAN)
 subprocess.call(['./contact_test'], shell=True)
+
+# Test suite 4
+ut.msg('ABM interface - ensemble of replicates test', CYAN)
+subprocess.call(['./ensemble_test'], shell=True)
+
+# Test suite 5
+ut.msg('ABM interface - parameter sweep test', CYAN)
+subprocess.call(['./sweep_test'], shell=True)
+
+# Test suite 6
+ut.msg('ABM interface - replicates in child processes test', CYAN)
+subprocess.call(['./fork_test'], shell=True)
+
+# Test suite 7
+ut.msg('ABM interface - synthetic population generator and tiling test', CYAN)
+subprocess.call(['./generator_test'], shell=True)
+
+# Test suite 8
+ut.msg('ABM interface - timing and tracing of simulation phases test', CYAN)
+subprocess.call(['./perf_stats_test'], shell=True)
+
+# Test suite 9
+ut.msg('ABM interface - statistical equivalence of simulation engines test', CYAN)
+subprocess.call(['./equivalence_test'], shell=True)
+
+# Test suite 10
+ut.msg('ABM interface - schedules of interventions test', CYAN)
+subprocess.call(['./intervention_test'], shell=True)
+
+# Test suite 11
+ut.msg('ABM interface - hospitals and hospital treatment test', CYAN)
+subprocess.call(['./hospital_test'], shell=True)
+
+# Test suite 12
+ut.msg('ABM interface - testing of agents test', CYAN)
+subprocess.call(['./testing_test'], shell=True)
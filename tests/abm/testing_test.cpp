@@ -0,0 +1,200 @@
+#include "abm_tests.h"
+
+/*****************************************************
+ *
+ * Test suite for testing of agents and isolation
+ * of the positive ones
+ *
+ ******************************************************/
+
+bool testing_flow_test();
+bool testing_capacity_test();
+bool testing_results_test();
+bool testing_input_test();
+bool no_testing_test();
+bool testing_removed_test();
+
+// Supporting functions
+ABM create_testing_abm();
+
+int main()
+{
+	test_pass(testing_flow_test(), "Decisions, tests, and results");
+	test_pass(testing_capacity_test(), "Daily capacity of tests");
+	test_pass(testing_results_test(), "False negative and false positive results");
+	test_pass(testing_input_test(), "Wrong testing input");
+	test_pass(no_testing_test(), "Model without testing");
+	test_pass(testing_removed_test(), "Agents that die before testing");
+}
+
+/// Agents are tested from the start of testing and the positive ones isolate
+bool testing_flow_test()
+{
+	ABM abm = create_testing_abm();
+	abm.set_testing(100000, 0);
+	const std::map<std::string, double> parameters = abm.get_infection_parameters();
+	const double first_test = parameters.at("start testing")
+								+ parameters.at("time from decision to test");
+	const double dt = 0.25;
+
+	for (int i = 0; i < 240; ++i){
+		abm.transmit_infection();
+		if (i*dt < first_test && abm.get_num_tested() != 0)
+			return false;
+		// Enough tests for everyone
+		if (abm.get_num_waiting_for_test() != 0 || abm.get_num_not_tested() != 0)
+			return false;
+		for (const auto& agent : abm.get_vector_of_agents()){
+			if (agent.home_isolated() && (!agent.tested_positive() || !agent.infected()))
+				return false;
+			if (agent.tested() && agent.tested_positive())
+				return false;
+		}
+	}
+	if (abm.get_num_tested() == 0 || abm.get_num_tested_positive() == 0)
+		return false;
+	if (abm.get_num_tested_positive() > abm.get_num_tested())
+		return false;
+	return true;
+}
+
+/// No more tests in a day than the capacity, bounded number of waiting agents
+bool testing_capacity_test()
+{
+	const int tests_per_day = 5, max_waiting = 10;
+	ABM abm = create_testing_abm();
+	abm.set_testing(tests_per_day, max_waiting);
+	const double dt = 0.25;
+
+	int n_tested_before = 0;
+	long long day = -1;
+	for (int i = 0; i < 240; ++i){
+		const long long step_day = static_cast<long long>(std::floor(i*dt));
+		if (step_day != day){
+			day = step_day;
+			n_tested_before = abm.get_num_tested();
+		}
+		abm.transmit_infection();
+		if (abm.get_num_tested() - n_tested_before > tests_per_day)
+			return false;
+		if (abm.get_num_waiting_for_test() > max_waiting)
+			return false;
+	}
+	// More agents decided to get tested than the tests allowed
+	if (abm.get_num_not_tested() == 0 || abm.get_num_tested() == 0)
+		return false;
+	return true;
+}
+
+/// Outcomes follow the fractions of wrong results, also when changed after the start
+bool testing_results_test()
+{
+	ABM all_negative = create_testing_abm();
+	all_negative.set_testing(100000, 0);
+	all_negative.set_infection_parameters({{"fraction false negative", 1.0},
+											{"fraction false positive", 0.0}});
+	ABM exact = create_testing_abm();
+	exact.set_infection_parameters({{"fraction false negative", 0.0},
+									{"fraction false positive", 0.0}});
+	exact.set_testing(100000, 0);
+	for (int i = 0; i < 240; ++i){
+		all_negative.transmit_infection();
+		exact.transmit_infection();
+	}
+
+	if (all_negative.get_num_tested() == 0 || all_negative.get_num_tested_positive() != 0
+			|| all_negative.get_num_home_isolated() != 0)
+		return false;
+
+	// Without wrong results, each positive agent counted once
+	if (exact.get_num_tested_positive() == 0)
+		return false;
+	int n_positive = 0;
+	for (const auto& agent : exact.get_vector_of_agents()){
+		if (agent.tested_positive())
+			++n_positive;
+	}
+	if (n_positive != exact.get_num_tested_positive())
+		return false;
+	return true;
+}
+
+/// Exceptions for wrong capacity
+bool testing_input_test()
+{
+	bool verbose = true;
+	const std::invalid_argument inv_arg("");
+	ABM abm = create_testing_abm();
+	if (!exception_test(verbose, &inv_arg, &ABM::set_testing, abm, 0, 10))
+		return false;
+	if (!exception_test(verbose, &inv_arg, &ABM::set_testing, abm, 10, -1))
+		return false;
+	return true;
+}
+
+/// Nothing changes before testing starts
+bool no_testing_test()
+{
+	ABM reference = create_testing_abm();
+	ABM not_started = create_testing_abm();
+	not_started.set_infection_parameters({{"start testing", 1000.0}});
+	not_started.set_testing(100000, 0);
+	for (int i = 0; i < 200; ++i){
+		reference.transmit_infection();
+		not_started.transmit_infection();
+		if (reference.get_num_infected() != not_started.get_num_infected()
+				|| reference.get_num_removed() != not_started.get_num_removed())
+			return false;
+	}
+	return not_started.get_num_tested() == 0 && reference.get_num_tested() == 0;
+}
+
+/// Agents that die while waiting use no tests and don't count as positive
+bool testing_removed_test()
+{
+	ABM abm = create_testing_abm();
+	abm.set_testing(2, 100000);
+	const std::map<std::string, double> parameters = abm.get_infection_parameters();
+	const double time_to_test = parameters.at("time from decision to test");
+	const double dt = 0.25;
+
+	// Run until many agents wait
+	int step = 0;
+	for (; step < 240 && abm.get_num_waiting_for_test() < 20; ++step)
+		abm.transmit_infection();
+	if (abm.get_num_waiting_for_test() < 20)
+		return false;
+
+	// All the agents waiting for a test or results
+	std::vector<int> testing;
+	const std::vector<Agent>& agents = abm.get_vector_of_agents();
+	for (std::size_t i = 0; i < agents.size(); ++i){
+		if (agents[i].tested() && !agents[i].removed())
+			testing.push_back(static_cast<int>(i));
+	}
+	kill_agents(abm, testing);
+
+	// Agents that decide from now on can't be tested yet
+	const int n_tested = abm.get_num_tested(), n_positive = abm.get_num_tested_positive();
+	for (int i = 0; (i + 1)*dt < time_to_test; ++i){
+		abm.transmit_infection();
+		if (abm.get_num_tested() != n_tested || abm.get_num_tested_positive() != n_positive)
+			return false;
+	}
+	if (abm.get_num_waiting_for_test() != 0)
+		return false;
+	for (const int i : testing){
+		if (agents[i].tested_positive())
+			return false;
+	}
+	return true;
+}
+
+/// Model with randomly assigned agents
+ABM create_testing_abm()
+{
+	const std::string fin("test_data/testing_agents.txt");
+	write_random_agents(fin, 3000, 1000, 20, 60, 347, true);
+	// Same initially infected in all models
+	return load_random_abm(fin, 2021);
+}
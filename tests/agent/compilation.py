@@ -10,10 +10,13 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+thr = '-pthread'
+lib = '-lz'
 # Common source files
 src_files = path + 'agent.cpp' 
 src_files += ' ' + path + 'utils.cpp'
 src_files += ' ' + path + 'io_operations/FileHandler.cpp'
+src_files += ' ' + path + 'io_operations/compressed_stream.cpp'
 tst_files = '../common/test_utils.cpp'
 
 #
@@ -26,7 +29,7 @@ tst_files = '../common/test_utils.cpp'
 exe_name = 'agent_test'
 # Files needed only for this build
 spec_files = 'agent_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
 subprocess.call([compile_com], shell=True)
 
 # Test 2
@@ -35,7 +38,7 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'agent_states_test'
 # Files needed only for this build
 spec_files = 'agent_states_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
 subprocess.call([compile_com], shell=True)
 
 
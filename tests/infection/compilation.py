@@ -10,6 +10,8 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+thr = '-pthread'
+lib = '-lz'
 # Common source files
 src_files = path + 'infection.cpp' 
 src_files += ' ' + path + 'agent.cpp'
@@ -17,6 +19,10 @@ src_files += ' ' + path + 'places/place.cpp'
 src_files += ' ' + path + 'places/household.cpp'
 src_files += ' ' + path + 'utils.cpp'
 src_files += ' ' + path + 'io_operations/FileHandler.cpp'
+src_files += ' ' + path + 'io_operations/compressed_stream.cpp'
+src_files += ' ' + path + 'io_operations/block_writer.cpp'
+src_files += ' ' + path + 'tracer.cpp'
+src_files += ' ' + path + 'perf_counters.cpp'
 tst_files = '../common/test_utils.cpp'
 
 #
@@ -29,7 +35,7 @@ tst_files = '../common/test_utils.cpp'
 exe_name = 'inf_test'
 # Files needed only for this build
 spec_files = 'infection_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files, lib])
 subprocess.call([compile_com], shell=True)
 
 
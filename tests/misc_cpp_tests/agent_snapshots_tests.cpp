@@ -0,0 +1,160 @@
+#include "../common/test_utils.h"
+#include "../../include/io_operations/agent_snapshots.h"
+
+/***************************************************************
+ * Suite for testing agent state snapshot writing and reading
+ **************************************************************/
+
+// Supporting functions
+std::vector<std::vector<std::uint8_t>> generate_states(const int, const int, const int);
+
+// Tests
+bool write_read_test();
+bool changes_test();
+bool wrong_input_test();
+
+int main()
+{
+	test_pass(write_read_test(), "Agent snapshots write and seek");
+	test_pass(changes_test(), "Agent snapshots changed agents");
+	test_pass(wrong_input_test(), "Agent snapshots error handling");
+}
+
+/**
+ * \brief Writes a sequence of states, then reads steps in random order
+ * \details Covers keyframes, sparse deltas, and dense deltas that
+ * 		are stored as keyframes
+ */
+bool write_read_test()
+{
+	const std::string fname("./test_data/agent_snapshots.bin");
+	const int n_agents = 1000, n_steps = 37;
+	std::vector<std::vector<std::uint8_t>> states = generate_states(n_agents, n_steps, 5);
+	// Change everything at one step to get a dense delta
+	for (auto& st : states.at(20))
+		st = 6;
+
+	{
+		AgentSnapshotWriter writer(fname, n_agents, 10);
+		for (int i=0; i<n_steps; ++i){
+			writer.get_state_buffer() = states.at(i);
+			writer.write_step(0.25*i);
+		}
+	}
+
+	AgentSnapshotReader reader(fname);
+	if (reader.get_number_of_steps() != n_steps || reader.get_number_of_agents() != n_agents)
+		return false;
+
+	std::vector<int> order(n_steps);
+	for (int i=0; i<n_steps; ++i)
+		order.at(i) = (i*17)%n_steps;
+	for (const auto& step : order){
+		if (reader.read_step(step) != states.at(step))
+			return false;
+		if (!float_equality<double>(reader.get_time(step), 0.25*step, 1e-10))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * \brief Checks the list of agents that changed at a step
+ */
+bool changes_test()
+{
+	const std::string fname("./test_data/agent_snapshots.bin");
+	const int n_agents = 200, n_steps = 12;
+	std::vector<std::vector<std::uint8_t>> states = generate_states(n_agents, n_steps, 3);
+
+	{
+		AgentSnapshotWriter writer(fname, n_agents, 4);
+		for (int i=0; i<n_steps; ++i){
+			writer.get_state_buffer() = states.at(i);
+			writer.write_step(1.0*i);
+		}
+		writer.close();
+	}
+
+	AgentSnapshotReader reader(fname);
+	for (int i=1; i<n_steps; ++i){
+		std::vector<std::pair<int, std::uint8_t>> changes = reader.read_changes(i);
+		std::vector<std::pair<int, std::uint8_t>> expected;
+		for (int j=0; j<n_agents; ++j){
+			if (states.at(i).at(j) != states.at(i-1).at(j))
+				expected.push_back(std::make_pair(j+1, states.at(i).at(j)));
+		}
+		if (changes != expected)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * \brief Wrong buffer size, closed writer, steps out of range, and corrupted files
+ */
+bool wrong_input_test()
+{
+	const std::string fname("./test_data/agent_snapshots.bin");
+	bool verbose = false;
+	const std::invalid_argument inv_arg("");
+	const std::runtime_error rt_err("");
+	const std::out_of_range oor_err("");
+
+	AgentSnapshotWriter writer(fname, 10, 4);
+	writer.get_state_buffer().resize(5);
+	if (!exception_test(verbose, &inv_arg, &AgentSnapshotWriter::write_step, writer, 0.0))
+		return false;
+	writer.get_state_buffer().resize(10);
+	writer.write_step(0.0);
+	writer.close();
+	if (!exception_test(verbose, &rt_err, &AgentSnapshotWriter::write_step, writer, 1.0))
+		return false;
+
+	AgentSnapshotReader reader(fname);
+	if (!exception_test(verbose, &oor_err, &AgentSnapshotReader::read_step, reader, 1))
+		return false;
+	if (!exception_test(verbose, &oor_err, &AgentSnapshotReader::read_step, reader, -1))
+		return false;
+
+	// Agent index in a delta that never ends
+	const int n_agents = 100;
+	{
+		AgentSnapshotWriter delta_writer(fname, n_agents, 10);
+		delta_writer.get_state_buffer().assign(n_agents, 0);
+		delta_writer.write_step(0.0);
+		// Long enough for the corrupted bytes to stay within the record
+		for (int i=0; i<10; ++i)
+			delta_writer.get_state_buffer().at(10*i) = 1;
+		delta_writer.write_step(1.0);
+	}
+	{
+		// Header, keyframe record, delta record header, number of changes
+		const std::streamoff varint_pos = 16 + (13 + n_agents) + 13 + 4;
+		std::fstream raw(fname, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+		raw.seekp(varint_pos);
+		const char all_bits[6] = {'\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF'};
+		raw.write(all_bits, sizeof(all_bits));
+	}
+	AgentSnapshotReader corrupted(fname);
+	if (!exception_test(verbose, &rt_err, &AgentSnapshotReader::read_step, corrupted, 1))
+		return false;
+	return true;
+}
+
+/// Random walk of agent states where n_change agents change state each step
+std::vector<std::vector<std::uint8_t>> generate_states(const int n_agents, const int n_steps,
+											const int n_change)
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<int> agent_dist(0, n_agents-1);
+	std::uniform_int_distribution<int> state_dist(0, 6);
+
+	std::vector<std::vector<std::uint8_t>> states(n_steps, std::vector<std::uint8_t>(n_agents, 0));
+	for (int i=1; i<n_steps; ++i){
+		states.at(i) = states.at(i-1);
+		for (int j=0; j<n_change; ++j)
+			states.at(i).at(agent_dist(gen)) = static_cast<std::uint8_t>(state_dist(gen));
+	}
+	return states;
+}
@@ -0,0 +1,83 @@
+#include "../common/test_utils.h"
+#include "../../include/io_operations/block_writer.h"
+#include <climits>
+#include <iomanip>
+
+/***************************************************************
+ * Suite for testing BlockWriter class for buffered output 
+ **************************************************************/
+
+// Supporting functions
+std::string read_file(const std::string);
+
+// Tests
+bool numbers_test();
+bool small_buffer_test();
+
+int main()
+{
+	test_pass(numbers_test(), "BlockWriter number formatting");
+	test_pass(small_buffer_test(), "BlockWriter writing in blocks");
+}
+
+/**
+ * \brief Output has to be identical to the default std::ostream output 
+ */
+bool numbers_test()
+{
+	const std::string fname("./test_data/block_writer.txt");
+	std::vector<int> ints = {0, 1, -1, 9, 10, 12345, -98760, INT_MAX, INT_MIN};
+	std::vector<double> doubles = {0.0, -0.0, 1.0, -2.5, 0.1, 40.988181, -73.781424, 
+									1.0e-7, 6.868e5, 1.23456789e12, 1.0/3.0, 2.0e-300};
+	std::ostringstream expected;
+
+	{
+		BlockWriter out(fname);
+		for (const auto& val : ints){
+			out << val << " ";
+			expected << val << " ";
+		}
+		out << '\n';
+		expected << '\n';
+		for (const auto& val : doubles){
+			out << val << ' ';
+			expected << val << ' ';
+		}
+		out << std::string("fixed\n");
+		expected << "fixed\n";
+		for (const auto& val : doubles){
+			out.write_fixed(val) << ' ';
+			expected << std::fixed << std::setprecision(6) << val << ' ';
+		}
+		out.write_fixed(1.0e300, 2);
+		expected << std::setprecision(2) << 1.0e300;
+	}
+	return read_file(fname) == expected.str();
+}
+
+/**
+ * \brief Buffer smaller than the output and than some of the strings 
+ */
+bool small_buffer_test()
+{
+	const std::string fname("./test_data/block_writer.txt");
+	std::ostringstream expected;
+
+	{
+		BlockWriter out(fname, 40);
+		for (int i=0; i<500; ++i){
+			out << i << " " << 0.5*i << " a somewhat longer string than the buffer itself\n";
+			expected << i << " " << 0.5*i << " a somewhat longer string than the buffer itself\n";
+		}
+	}
+	return read_file(fname) == expected.str();
+}
+
+/// Whole content of a file as a string
+std::string read_file(const std::string fname)
+{
+	std::ifstream in(fname);
+	std::ostringstream content;
+	content << in.rdbuf();
+	return content.str();
+}
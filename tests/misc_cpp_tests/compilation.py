@@ -7,10 +7,19 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+thr = '-pthread'
+lib = '-lz'
 # Common source files
 src_files = path + 'io_operations/FileHandler.cpp'
+src_files += ' ' + path + 'io_operations/compressed_stream.cpp'
+src_files += ' ' + path + 'io_operations/input_validation.cpp'
+src_files += ' ' + path + 'io_operations/block_writer.cpp'
+src_files += ' ' + path + 'tracer.cpp'
+src_files += ' ' + path + 'perf_counters.cpp'
 src_files += ' ' + path + 'utils.cpp'
 src_files += ' ' + path + 'io_operations/load_parameters.cpp'
+src_files += ' ' + path + 'io_operations/agent_snapshots.cpp'
+src_files += ' ' + path + 'io_operations/event_log.cpp'
 test_files = '../common/test_utils.cpp'
 
 # FileHandler.h tests
@@ -23,7 +32,7 @@ if os.path.exists(f_app):
 exe_name = 'file_hdl_tests'
 # Files needed only for this build
 spec_files = 'file_handler_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, src_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files, lib])
 subprocess.call([compile_com], shell=True)
 
 # abm_io.h tests
@@ -39,7 +48,7 @@ for frm in files_rm:
 exe_name = 'abm_io_tests'
 # Files needed only for this build
 spec_files = 'abm_io_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, src_files, spec_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, src_files, spec_files, test_files, lib])
 subprocess.call([compile_com], shell=True)
 
 # utils.h tests
@@ -47,7 +56,7 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'utils_tests'
 # Files needed only for this build
 spec_files = 'utils_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, src_files, spec_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, src_files, spec_files, test_files, lib])
 subprocess.call([compile_com], shell=True)
 
 # load_parameters.h tests 
@@ -55,5 +64,45 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'ld_params_tests'
 # Files needed only for this build
 spec_files = 'load_parameters_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, src_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files, lib])
+subprocess.call([compile_com], shell=True)
+
+# agent_snapshots.h tests
+f_snp = './test_data/agent_snapshots.bin'
+if os.path.exists(f_snp):
+	os.remove(f_snp)
+# Name of the executable
+exe_name = 'agent_snapshots_tests'
+# Files needed only for this build
+spec_files = 'agent_snapshots_tests.cpp'
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files, lib])
+subprocess.call([compile_com], shell=True)
+
+# event_log.h tests
+f_evl = './test_data/transition_events.bin'
+if os.path.exists(f_evl):
+	os.remove(f_evl)
+# Name of the executable
+exe_name = 'event_log_tests'
+# Files needed only for this build
+spec_files = 'event_log_tests.cpp'
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files, lib])
+subprocess.call([compile_com], shell=True)
+
+# block_writer.h tests
+# Name of the executable
+exe_name = 'block_writer_tests'
+# Files needed only for this build
+spec_files = 'block_writer_tests.cpp'
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files, lib])
+subprocess.call([compile_com], shell=True)
+
+# compressed_stream.h tests
+for f_gz in glob.glob('./test_data/compressed*.gz'):
+	os.remove(f_gz)
+# Name of the executable
+exe_name = 'compressed_stream_tests'
+# Files needed only for this build
+spec_files = 'compressed_stream_tests.cpp'
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files, lib])
 subprocess.call([compile_com], shell=True)
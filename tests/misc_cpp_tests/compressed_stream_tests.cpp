@@ -0,0 +1,229 @@
+#include "../common/test_utils.h"
+#include "../../include/io_operations/FileHandler.h"
+#include "../../include/io_operations/abm_io.h"
+#include <zlib.h>
+
+/***************************************************************
+ * Suite for testing compressed input and output
+ **************************************************************/
+
+// Supporting functions
+std::string generate_text(const int);
+std::string read_with_zlib(const std::string);
+std::string read_stream(std::istream&);
+
+// Tests
+bool file_handler_test();
+bool blocks_test();
+bool abm_io_test();
+bool append_rewind_test();
+bool corrupted_test();
+
+int main()
+{
+	test_pass(file_handler_test(), "Compressed FileHandler write and read");
+	test_pass(blocks_test(), "Compression in parallel blocks");
+	test_pass(abm_io_test(), "Compressed AbmIO");
+	test_pass(append_rewind_test(), "Compressed append and rewind");
+	test_pass(corrupted_test(), "Compressed file error handling");
+}
+
+/**
+ * \brief Writes through FileHandler, reads back with FileHandler and zlib
+ */
+bool file_handler_test()
+{
+	const std::string fname("./test_data/compressed.txt.gz");
+	const std::string text = generate_text(20000);
+
+	{
+		FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
+		if (!file.is_compressed())
+			return false;
+		std::iostream& out = file.get_stream();
+		out << text;
+		if (out.tellp() != static_cast<std::streamoff>(text.size()))
+			return false;
+	}
+
+	// Standard gzip reader
+	if (read_with_zlib(fname) != text)
+		return false;
+
+	FileHandler file(fname, std::ios_base::in);
+	return read_stream(file.get_stream()) == text;
+}
+
+/**
+ * \brief Small blocks and fewer threads than blocks
+ * \details Each block is a separate gzip member
+ */
+bool blocks_test()
+{
+	const std::string fname("./test_data/compressed_blocks.txt.gz");
+	const std::string text = generate_text(5000);
+
+	for (const auto& n_threads : {1, 3}){
+		{
+			CompressedBuffer zbuf(fname, Codec::gzip, std::ios_base::out, 1000, n_threads);
+			std::ostream out(&zbuf);
+			// Mix of single characters, flushes, and long writes
+			for (std::size_t i=0; i<text.size(); i+=997){
+				out.put(text.at(i));
+				out << std::flush;
+				out.write(text.data() + i + 1, std::min<std::size_t>(996, text.size() - i - 1));
+			}
+			if (!zbuf.close())
+				return false;
+		}
+		if (read_with_zlib(fname) != text)
+			return false;
+
+		CompressedBuffer zbuf(fname, Codec::gzip, std::ios_base::in, 1000, n_threads);
+		std::istream in(&zbuf);
+		if (read_stream(in) != text)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * \brief AbmIO reads and writes compressed files without changes
+ */
+bool abm_io_test()
+{
+	const std::string fname("./test_data/compressed_vector.txt.gz");
+	std::vector<std::vector<int>> data;
+	for (int i=0; i<3000; ++i)
+		data.push_back({i, 2*i, -i, i%7});
+
+	AbmIO io_out(fname, " ", true, {data.size(), 4});
+	io_out.write_vector(data);
+
+	AbmIO io_in(fname, " ", true, {0, 0, 0});
+	return is_equal_exact(data, io_in.read_vector<int>());
+}
+
+/**
+ * \brief Appending adds members, rewinding reads from the beginning
+ */
+bool append_rewind_test()
+{
+	const std::string fname("./test_data/compressed_append.txt.gz");
+	const std::string line_1("This is line 1\n"), line_2("This is line 2\n");
+
+	{
+		FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
+		file.get_stream() << line_1;
+	}
+	{
+		FileHandler file(fname, std::ios_base::out | std::ios_base::app);
+		file.get_stream() << line_2;
+	}
+
+	FileHandler file(fname, std::ios_base::in);
+	if (read_stream(file.get_stream()) != line_1 + line_2)
+		return false;
+	file.clear_stream();
+	std::iostream& in = file.reset_input_stream();
+	std::string line;
+	if (!std::getline(in, line) || line + "\n" != line_1)
+		return false;
+	// Seeking anywhere else is not supported
+	in.seekg(5);
+	return in.fail();
+}
+
+/**
+ * \brief Truncated and corrupted files, unsupported formats
+ */
+bool corrupted_test()
+{
+	const std::string fname("./test_data/compressed_bad.txt.gz");
+	const std::string text = generate_text(2000);
+	{
+		FileHandler file(fname, std::ios_base::out | std::ios_base::trunc);
+		file.get_stream() << text;
+	}
+
+	// Cut the file in half
+	std::string content;
+	{
+		std::ifstream raw(fname, std::ios_base::binary);
+		content = read_stream(raw);
+	}
+	{
+		std::ofstream raw(fname, std::ios_base::binary | std::ios_base::trunc);
+		raw.write(content.data(), content.size()/2);
+	}
+	{
+		FileHandler file(fname, std::ios_base::in);
+		std::iostream& in = file.get_stream();
+		read_stream(in);
+		if (!in.bad())
+			return false;
+		in.clear();
+	}
+	// Loading the truncated file doesn't stop silently
+	bool verbose = false;
+	const std::runtime_error rt_err("");
+	AbmIO io_in(fname, " ", true, {0, 0, 0});
+	if (!exception_test(verbose, &rt_err, &AbmIO::read_vector<std::string>, io_in))
+		return false;
+
+	// Not compressed at all
+	{
+		std::ofstream raw(fname, std::ios_base::binary | std::ios_base::trunc);
+		raw << text;
+	}
+	{
+		FileHandler file(fname, std::ios_base::in);
+		std::iostream& in = file.get_stream();
+		read_stream(in);
+		if (!in.bad())
+			return false;
+		in.clear();
+	}
+
+#ifndef ABM_WITH_ZSTD
+	const std::invalid_argument inv_arg("");
+	auto open_zst = [](){ FileHandler file("./test_data/compressed.txt.zst", std::ios_base::out); };
+	if (!exception_test(verbose, &inv_arg, open_zst))
+		return false;
+#endif
+	return true;
+}
+
+/// Lines of text with numbers, compressible but not trivially
+std::string generate_text(const int n_lines)
+{
+	std::ostringstream text;
+	for (int i=0; i<n_lines; ++i)
+		text << i << " " << (i*7919)%1009 << " " << 0.25*i << " household " << i/4 << "\n";
+	return text.str();
+}
+
+/// Decompress a whole file with the zlib gzip reader
+std::string read_with_zlib(const std::string fname)
+{
+	gzFile gz = gzopen(fname.c_str(), "rb");
+	if (gz == nullptr)
+		return std::string();
+	std::string content;
+	char buffer[4096];
+	int n = 0;
+	while ((n = gzread(gz, buffer, sizeof(buffer))) > 0)
+		content.append(buffer, n);
+	gzclose(gz);
+	return content;
+}
+
+/// Whole content of a stream as a string
+std::string read_stream(std::istream& in)
+{
+	std::string content;
+	char buffer[4096];
+	while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+		content.append(buffer, in.gcount());
+	return content;
+}
@@ -0,0 +1,108 @@
+#include "../common/test_utils.h"
+#include "../../include/io_operations/event_log.h"
+
+/***************************************************************
+ * Suite for testing the transition event log
+ **************************************************************/
+
+// Supporting functions
+bool same_events(std::vector<TransitionEvent>, std::vector<TransitionEvent>);
+
+// Tests
+bool single_slot_test();
+bool multi_slot_test();
+
+int main()
+{
+	test_pass(single_slot_test(), "Event log single buffer");
+	test_pass(multi_slot_test(), "Event log per-thread buffers");
+}
+
+/**
+ * \brief Records events from one thread, across several buffer hand-overs
+ */
+bool single_slot_test()
+{
+	const std::string fname("./test_data/transition_events.bin");
+	const double dt = 0.25;
+	std::vector<TransitionEvent> expected;
+
+	{
+		EventLog log(fname, dt, 1, 16);
+		for (int i=0; i<100; ++i){
+			TransitionType type = static_cast<TransitionType>(i%5);
+			PlaceType place = (type == TransitionType::infected) ? PlaceType::school : PlaceType::none;
+			int place_ID = (type == TransitionType::infected) ? i+3 : 0;
+			log.record(dt*(i/10), i+1, type, place, place_ID);
+
+			TransitionEvent event;
+			event.step = i/10;
+			event.agent_ID = i+1;
+			event.type = static_cast<std::uint8_t>(type);
+			event.place_type = static_cast<std::uint8_t>(place);
+			event.place_ID = place_ID;
+			expected.push_back(event);
+		}
+		// Events written so far are readable after a flush
+		log.flush();
+		if (!same_events(EventLog::read_events(fname), expected))
+			return false;
+	}
+
+	return same_events(EventLog::read_events(fname), expected);
+}
+
+/**
+ * \brief Records events concurrently, one thread per slot
+ */
+bool multi_slot_test()
+{
+	const std::string fname("./test_data/transition_events.bin");
+	const int n_threads = 4, n_events = 5000;
+	std::vector<TransitionEvent> expected;
+
+	{
+		EventLog log(fname, 1.0, n_threads, 64);
+		std::vector<std::thread> threads;
+		for (int t=0; t<n_threads; ++t){
+			threads.push_back(std::thread([&log, t, n_events](){
+				for (int i=0; i<n_events; ++i)
+					log.record(static_cast<double>(i), t*n_events + i + 1,
+									TransitionType::recovered, PlaceType::none, 0, t);
+			}));
+		}
+		for (auto& thr : threads)
+			thr.join();
+	}
+
+	for (int t=0; t<n_threads; ++t){
+		for (int i=0; i<n_events; ++i){
+			TransitionEvent event;
+			event.step = i;
+			event.agent_ID = t*n_events + i + 1;
+			event.type = static_cast<std::uint8_t>(TransitionType::recovered);
+			expected.push_back(event);
+		}
+	}
+
+	return same_events(EventLog::read_events(fname), expected);
+}
+
+/// True if both vectors have the same events, regardless of order
+bool same_events(std::vector<TransitionEvent> ev1, std::vector<TransitionEvent> ev2)
+{
+	auto as_tuple = [](const TransitionEvent& ev)
+		{ return std::make_tuple(ev.agent_ID, ev.step, ev.type, ev.place_type, ev.place_ID); };
+	auto less = [&as_tuple](const TransitionEvent& e1, const TransitionEvent& e2)
+		{ return as_tuple(e1) < as_tuple(e2); };
+
+	if (ev1.size() != ev2.size())
+		return false;
+	std::sort(ev1.begin(), ev1.end(), less);
+	std::sort(ev2.begin(), ev2.end(), less);
+	for (size_t i=0; i<ev1.size(); ++i){
+		if (as_tuple(ev1.at(i)) != as_tuple(ev2.at(i)))
+			return false;
+	}
+	return true;
+}
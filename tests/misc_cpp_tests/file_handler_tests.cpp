@@ -7,7 +7,7 @@
  **************************************************************/
 
 // Supporting functions
-bool check_file_content(std::fstream&, std::vector<std::string>);
+bool check_file_content(std::iostream&, std::vector<std::string>);
 void open_file(const std::string, const std::ios_base::openmode);
 
 // Tests
@@ -33,7 +33,7 @@ bool default_io_test()
 	// truncates
 	std::string fname("./test_data/default_mode.txt");
 	FileHandler file(fname);
-	std::fstream &out = file.get_stream();
+	std::iostream &out = file.get_stream();
 	
 	// Expected input/output
 	std::string orig_line("This is a test."), new_line;
@@ -44,7 +44,7 @@ bool default_io_test()
 
 	// Now read and check content
 	// Move the input stream to the begining of the file
-	std::fstream &in = file.reset_input_stream();
+	std::iostream &in = file.reset_input_stream();
 	return check_file_content(in, exp_lines);
 }
 
@@ -68,8 +68,8 @@ bool custom_io_test()
 	std::vector<std::string> exp_lines = {line_1};
 
 	// Write first line and check
-	std::fstream &out = out_file.get_stream();
-	std::fstream &in = in_file.get_stream();
+	std::iostream &out = out_file.get_stream();
+	std::iostream &in = in_file.get_stream();
 	out << line_1 << std::endl;
 	if (!check_file_content(in, exp_lines))
 		return false;
@@ -116,7 +116,7 @@ bool fail_to_open_test()
  * 	@return true if all lines match and vector size equal number of lines in 
  * 		the file. false otherwise.
  */
-bool check_file_content(std::fstream& in, std::vector<std::string> exp_lines)
+bool check_file_content(std::iostream& in, std::vector<std::string> exp_lines)
 {
 	size_t count = 0;
 	size_t num_exp = exp_lines.size();
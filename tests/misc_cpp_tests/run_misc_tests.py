@@ -29,3 +29,19 @@ subprocess.call(['./utils_tests'], shell=True)
 # LoadParameters class
 ut.msg('LoadParameters class', CYAN)
 subprocess.call(['./ld_params_tests'], shell=True)
+
+# Agent snapshots
+ut.msg('Agent snapshots', CYAN)
+subprocess.call(['./agent_snapshots_tests'], shell=True)
+
+# Transition event log
+ut.msg('Transition event log', CYAN)
+subprocess.call(['./event_log_tests'], shell=True)
+
+# Buffered block output
+ut.msg('BlockWriter class', CYAN)
+subprocess.call(['./block_writer_tests'], shell=True)
+
+# Compressed input and output
+ut.msg('Compressed streams', CYAN)
+subprocess.call(['./compressed_stream_tests'], shell=True)
@@ -0,0 +1,138 @@
+# ------------------------------------------------------------------
+#
+#	Comparison of benchmark results with a stored baseline
+#
+# ------------------------------------------------------------------
+
+import csv, statistics, math
+
+#
+# Results
+#
+
+def load_results(fname):
+	''' Summaries from a benchmark CSV file, keyed by configuration and phase
+
+		The key is a tuple of the benchmark name, values of all
+		configuration parameters, and the phase. Values are
+		dictionaries with the median and its spread, both in
+		microseconds. The spread is the difference between the
+		90th percentile and the median scaled by the square root
+		of the number of samples, an estimate of the uncertainty
+		of the median rather than of single samples. '''
+
+	results = {}
+	with open(fname) as fin:
+		reader = csv.reader(fin)
+		header = next(reader)
+		iphase = header.index('phase')
+		imed = header.index('median_us')
+		ip90 = header.index('p90_us')
+		isamples = header.index('samples')
+		for row in reader:
+			if not row:
+				continue
+			key = tuple(row[:iphase + 1])
+			median = float(row[imed])
+			spread = (float(row[ip90]) - median)/math.sqrt(max(1, int(row[isamples])))
+			results[key] = {'median' : median, 'spread' : spread}
+	return results, header[:iphase + 1]
+
+def combine_runs(runs):
+	''' Combine results of repeated benchmark runs
+
+		Median of the medians; the spread is the larger of the
+		largest spread of a single run and the range of the medians. '''
+
+	combined = {}
+	for key in runs[0]:
+		medians = [run[key]['median'] for run in runs if key in run]
+		spreads = [run[key]['spread'] for run in runs if key in run]
+		combined[key] = {'median' : statistics.median(medians),
+							'spread' : max(max(spreads), max(medians) - min(medians))}
+	return combined
+
+def save_baseline(fname, results, columns):
+	''' Save combined results as a baseline CSV file '''
+
+	with open(fname, 'w', newline='') as fout:
+		writer = csv.writer(fout)
+		writer.writerow(columns + ['median_us', 'spread_us'])
+		for key, res in results.items():
+			writer.writerow(list(key) + [res['median'], res['spread']])
+
+def load_baseline(fname):
+	''' Read a baseline saved with save_baseline '''
+
+	baseline = {}
+	with open(fname) as fin:
+		reader = csv.reader(fin)
+		header = next(reader)
+		for row in reader:
+			if row:
+				baseline[tuple(row[:-2])] = {'median' : float(row[-2]), 'spread' : float(row[-1])}
+	return baseline, header[:-2]
+
+#
+# Comparison
+#
+
+def allowed_time(base, new, tol, noise, floor_us):
+	''' Largest median of new results that is not a regression
+
+		The baseline median may grow by the relative tolerance tol,
+		by noise times the larger spread of the two results, and
+		by floor_us microseconds to allow for timer resolution. '''
+
+	return base['median']*(1.0 + tol) + noise*max(base['spread'], new['spread']) + floor_us
+
+def compare(baseline, results, tol, noise, floor_us):
+	''' Compare results with the baseline
+
+		Returns a list of (key, baseline median, new median,
+		allowed median, status) with status one of 'ok', 'faster',
+		'REGRESSION', 'new', or 'missing'; 'faster' when the
+		new median is below what the baseline allows in
+		the other direction. '''
+
+	report = []
+	for key in baseline:
+		if key not in results:
+			report.append((key, baseline[key]['median'], None, None, 'missing'))
+			continue
+		base, new = baseline[key], results[key]
+		limit = allowed_time(base, new, tol, noise, floor_us)
+		if new['median'] > limit:
+			status = 'REGRESSION'
+		elif new['median'] < 2.0*base['median'] - limit:
+			status = 'faster'
+		else:
+			status = 'ok'
+		report.append((key, base['median'], new['median'], limit, status))
+	for key in results:
+		if key not in baseline:
+			report.append((key, None, results[key]['median'], None, 'new'))
+	return report
+
+def format_report(report, columns, verbose=False):
+	''' Table of the comparison, only regressions unless verbose '''
+
+	def num(x):
+		return '-' if x is None else '{0:.1f}'.format(x)
+
+	def change(base, new):
+		if base is None or new is None or base == 0.0:
+			return '-'
+		return '{0:+.1f}%'.format(100.0*(new - base)/base)
+
+	header = columns + ['base [us]', 'new [us]', 'change', 'allowed [us]', 'status']
+	rows = [list(key) + [num(base), num(new), change(base, new), num(limit), status]
+				for key, base, new, limit, status in report
+				if verbose or status in ('REGRESSION', 'missing')]
+	widths = [max(len(str(row[i])) for row in [header] + rows) for i in range(len(header))]
+	lines = ['  '.join(str(x).ljust(w) for x, w in zip(row, widths)) for row in [header] + rows]
+	return '\n'.join(lines)
+
+def count_status(report, status):
+	''' Number of entries with the given status '''
+	return sum(1 for entry in report if entry[-1] == status)
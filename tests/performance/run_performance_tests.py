@@ -0,0 +1,116 @@
+import subprocess, argparse, os
+
+import sys
+py_path = '../../scripts/'
+sys.path.insert(0, py_path)
+
+import utils as ut
+from colors import *
+import perf_regression as pr
+
+#
+# Performance regression tests
+#
+# Runs the transmission benchmark and compares median times of
+# each phase, population, and prevalence with a baseline stored
+# in baseline/. The first run, or a run with --update, saves the
+# baseline instead. Baselines are specific to the machine and the
+# build, so they are kept locally; --mode names separate
+# baselines, e.g. for a CMake or PGO build of the benchmark
+# given with --exe. Exits with 1 if any phase is slower than
+# the baseline allows.
+#
+
+parser = argparse.ArgumentParser(description='Performance regression tests')
+parser.add_argument('--update', action='store_true', help='save this run as the baseline')
+parser.add_argument('--mode', default='default', help='name of the baseline')
+parser.add_argument('--exe', default='', help='benchmark executable, compiled here if not given')
+parser.add_argument('--populations', default='10000,50000', help='populations, as for the benchmark')
+parser.add_argument('--prevalences', default='0.01,0.1', help='prevalences, as for the benchmark')
+parser.add_argument('--steps', type=int, default=20, help='timed steps in each run')
+parser.add_argument('--repeats', type=int, default=3, help='runs of the benchmark')
+parser.add_argument('--tolerance', type=float, default=0.15, help='allowed relative slowdown')
+parser.add_argument('--noise', type=float, default=1.0, help='allowed multiple of the spread')
+parser.add_argument('--floor', type=float, default=2.0, help='allowed slowdown in microseconds')
+parser.add_argument('--verbose', action='store_true', help='report all phases')
+args = parser.parse_args()
+
+baseline_file = 'baseline/transmission_' + args.mode + '.csv'
+
+#
+# Checks of the comparison
+#
+
+def comparison_test():
+	''' Regressions are slowdowns beyond tolerance and noise '''
+	key = ('bench', '100', 'step')
+	base = {key : {'median' : 100.0, 'spread' : 5.0}}
+	# Within tolerance, beyond it, within noise of the new run
+	within = {key : {'median' : 112.0, 'spread' : 2.0}}
+	slower = {key : {'median' : 130.0, 'spread' : 2.0}}
+	noisy = {key : {'median' : 130.0, 'spread' : 30.0}}
+	faster = {key : {'median' : 70.0, 'spread' : 2.0}}
+	status = lambda res : pr.compare(base, res, 0.1, 1.0, 1.0)[0][-1]
+	if status(within) != 'ok' or status(slower) != 'REGRESSION' or status(noisy) != 'ok':
+		return False
+	if status(faster) != 'faster':
+		return False
+	# Configurations missing from either
+	other = {('bench', '200', 'step') : {'median' : 1.0, 'spread' : 0.0}}
+	report = pr.compare(base, other, 0.1, 1.0, 1.0)
+	if pr.count_status(report, 'missing') != 1 or pr.count_status(report, 'new') != 1:
+		return False
+	# Median of medians, spread includes the range of medians
+	runs = [{key : {'median' : m, 'spread' : 1.0}} for m in [10.0, 14.0, 11.0]]
+	combined = pr.combine_runs(runs)[key]
+	return combined['median'] == 11.0 and combined['spread'] == 4.0
+
+ut.msg('Performance regression - comparison with baseline', CYAN)
+ut.test_pass(comparison_test(), 'Comparison of benchmark results')
+
+#
+# Benchmark runs
+#
+
+exe = args.exe
+if not exe:
+	subprocess.call(['python3.6 compilation.py'], shell=True)
+	exe = './transmission_bench'
+
+ut.msg('Performance regression - ' + str(args.repeats) + ' runs of the transmission benchmark', CYAN)
+runs = []
+for i in range(args.repeats):
+	prefix = 'perf_run_' + str(i)
+	ret = subprocess.call([exe, args.populations, args.prevalences, str(args.steps), prefix],
+							stdout=subprocess.DEVNULL)
+	if ret != 0:
+		ut.msg('Benchmark failed with exit code ' + str(ret), RED)
+		sys.exit(1)
+	results, columns = pr.load_results(prefix + '.csv')
+	runs.append(results)
+	for ext in ['.csv', '.json']:
+		os.remove(prefix + ext)
+results = pr.combine_runs(runs)
+
+if args.update or not os.path.exists(baseline_file):
+	os.makedirs(os.path.dirname(baseline_file), exist_ok=True)
+	pr.save_baseline(baseline_file, results, columns)
+	ut.msg('  - Baseline saved in ' + baseline_file + ', later runs are compared with it', GREEN)
+	sys.exit(0)
+
+#
+# Comparison
+#
+
+baseline, columns = pr.load_baseline(baseline_file)
+report = pr.compare(baseline, results, args.tolerance, args.noise, args.floor)
+n_bad = pr.count_status(report, 'REGRESSION') + pr.count_status(report, 'missing')
+
+if args.verbose or n_bad > 0:
+	print(pr.format_report(report, columns, args.verbose))
+print('{0} phases compared: {1} ok, {2} faster, {3} regressions, {4} missing, {5} new'.format(len(report),
+		pr.count_status(report, 'ok'), pr.count_status(report, 'faster'),
+		pr.count_status(report, 'REGRESSION'), pr.count_status(report, 'missing'),
+		pr.count_status(report, 'new')))
+ut.test_pass(n_bad == 0, 'Performance compared with ' + baseline_file)
+sys.exit(1 if n_bad > 0 else 0)
@@ -12,12 +12,17 @@ bool place_test();
 bool school_test();
 bool workplace_test();
 bool household_test();
+bool hospital_test();
 
 // Tests for contributions
 bool contribution_test_general_place();
 bool contribution_test_workplace();
 bool contribution_test_school();
 bool contribution_test_household();
+bool contribution_test_hospital();
+
+// Tests for opening and closing places
+bool place_activation_test();
 
 // Supporting functions
 bool general_place_test(Place&, const int, const double, const double,
@@ -40,6 +45,11 @@ int main()
 	
 	test_pass(household_test(), "Household class functionality");
 	test_pass(contribution_test_household(), "Contribution test for household");
+
+	test_pass(hospital_test(), "Hospital class functionality");
+	test_pass(contribution_test_hospital(), "Contribution test for hospital");
+
+	test_pass(place_activation_test(), "Opening and closing of places");
 }
 
 /// Tests all public functions from the Place class  
@@ -277,6 +287,67 @@ bool contribution_test_household()
 	return true;
 }
 
+/// Open and closed places, nested random subsets
+bool place_activation_test()
+{
+	// Sizes around word boundaries
+	for (const int n : {0, 1, 63, 64, 65, 943}){
+		PlaceActivation open(n), closed(n, false);
+		if (open.size() != n || open.count_open() != n || closed.count_open() != 0)
+			return false;
+		if (!closed.is_subset_of(open) || (n > 0 && open.is_subset_of(closed)))
+			return false;
+		for (int i = 0; i < n; ++i)
+			if (!open.is_open(i) || closed.is_open(i))
+				return false;
+	}
+
+	// Single places
+	PlaceActivation places(130, false);
+	places.set(0, true);
+	places.set(64, true);
+	places.set(129, true);
+	places.set(64, false);
+	if (places.count_open() != 2 || !places.is_open(0) || places.is_open(64) || !places.is_open(129))
+		return false;
+
+	// Same ranking for the same seed, a permutation of all places
+	const int n = 943;
+	const std::vector<int> ranking = PlaceActivation::random_ranking(n, 2020);
+	if (ranking != PlaceActivation::random_ranking(n, 2020) || ranking == PlaceActivation::random_ranking(n, 2021))
+		return false;
+	std::vector<int> sorted(ranking);
+	std::sort(sorted.begin(), sorted.end());
+	for (int i = 0; i < n; ++i)
+		if (sorted.at(i) != i)
+			return false;
+
+	// Larger fractions open supersets
+	PlaceActivation previous(n, false);
+	for (const double fraction : {0.0, 0.3, 0.45, 0.511, 0.567, 1.0}){
+		PlaceActivation current(n);
+		current.open_first(ranking, fraction);
+		if (current.count_open() != static_cast<int>(std::lround(fraction*n)))
+			return false;
+		if (!previous.is_subset_of(current))
+			return false;
+		previous = current;
+	}
+
+	// Wrong input
+	bool verbose = false;
+	const std::invalid_argument invarg("Wrong activation input");
+	const std::out_of_range out_of_range("Wrong place index");
+	if (!exception_test(verbose, &out_of_range, &PlaceActivation::set, places, 130, true))
+		return false;
+	if (!exception_test(verbose, &invarg, &PlaceActivation::open_first, places, ranking, 0.5))
+		return false;
+	PlaceActivation all(n);
+	if (!exception_test(verbose, &invarg, &PlaceActivation::open_first, all, ranking, 1.5))
+		return false;
+	return true;
+}
+
 /** 
  * \brief Test for general contribution to infection probability
  * 
@@ -422,6 +493,69 @@ bool general_place_test(Place& place, const int pID,
 	return true;
 }
 
+/// Tests all public functions from the Hospital class  
+bool hospital_test()
+{
+	int pID = 3; 
+	double xi = 7089.0, yi = 345.678;
+	double severity_cor = 2.0, beta_emp = 0.47, beta_pt = 0.2, beta_tst = 0.1;
+	double beta_hsp = 0.6, beta_icu = 0.8;
+
+	Hospital hospital(pID, xi, yi, severity_cor, beta_emp, beta_pt, beta_tst, beta_hsp, beta_icu);
+
+	std::map<const std::string, const double> hospital_betas = {{"hospital employee", beta_emp},
+			{"hospital non-COVID patient", beta_pt}, {"hospital testee", beta_tst}};
+	if (!general_place_test(hospital, pID, xi, yi, severity_cor, beta_emp, -1.0, -1.0, -1.0, hospital_betas))
+		return false;
+
+	// Staff workplace
+	if (hospital.get_staff_workplace_ID() != 0)
+		return false;
+	hospital.set_staff_workplace_ID(12);
+	if (hospital.get_staff_workplace_ID() != 12)
+		return false;
+
+	return true;
+}
+
+/// Contributions of patients normalized by patients and employees
+bool contribution_test_hospital()
+{
+	double severity_cor = 2.0, beta_emp = 0.47, beta_pt = 0.2, beta_tst = 0.1;
+	double beta_hsp = 0.6, beta_icu = 0.8, inf_var = 0.9;
+	int n_hsp = 3, n_icu = 2, n_staff = 15;
+	double exp_lambda = 0.306;
+
+	Hospital hospital(1, 0.0, 0.0, severity_cor, beta_emp, beta_pt, beta_tst, beta_hsp, beta_icu);
+	for (int i=0; i<(n_hsp + n_icu); ++i){
+		hospital.add_agent(i+1);
+		if (i < n_hsp)
+			hospital.add_hospitalized(inf_var);
+		else
+			hospital.add_hospitalized_ICU(inf_var);
+	}
+	hospital.set_number_of_staff(n_staff);
+	hospital.compute_infected_contribution();
+	if (!float_equality<double>(exp_lambda, hospital.get_infected_contribution(), 1e-3))
+		return false;
+	if (hospital.get_total_infected() != n_hsp + n_icu)
+		return false;
+
+	// Added to the workplace of employees
+	Workplace work(1, 0.0, 0.0, severity_cor, 0.5, 0.49);
+	work.compute_infected_contribution();
+	work.add_infected_contribution(hospital.get_infected_contribution());
+	if (!float_equality<double>(exp_lambda, work.get_infected_contribution(), 1e-3))
+		return false;
+
+	// No patients or employees
+	Hospital empty(2, 0.0, 0.0, severity_cor, beta_emp, beta_pt, beta_tst, beta_hsp, beta_icu);
+	empty.compute_infected_contribution();
+	if (empty.get_infected_contribution() != 0.0)
+		return false;
+	return true;
+}
+
 /** 
  * \brief Test for household contribution to infection probability
  * 
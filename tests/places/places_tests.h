@@ -5,6 +5,8 @@
 #include "../../include/places/school.h"
 #include "../../include/places/workplace.h"
 #include "../../include/places/household.h"
+#include "../../include/places/hospital.h"
+#include "../../include/places/place_activation.h"
 #include "../../include/infection.h"
 #include "../../include/utils.h"
 #include "../common/test_utils.h"